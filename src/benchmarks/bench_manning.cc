@@ -0,0 +1,94 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Micro-benchmark of the per-cell work of OverlandConductivityEvaluator with
+  Manning's model: conductivity and its derivative with respect to ponded
+  depth, cell by cell and in one batched sweep with a cached scaling.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <vector>
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "manning_conductivity_model.hh"
+#include "benchmark.hh"
+
+namespace Amanzi {
+namespace Benchmarks {
+
+namespace {
+
+struct ScalarKernel {
+  Flow::ManningConductivityModel* model;
+  const std::vector<double>* depth;
+  const std::vector<double>* slope;
+  const std::vector<double>* coef;
+  std::vector<double>* cond;
+  std::vector<double>* dcond;
+
+  double operator()() {
+    int n = depth->size();
+    for (int i=0; i!=n; ++i) {
+      (*cond)[i] = model->Conductivity((*depth)[i], (*slope)[i], (*coef)[i]);
+      (*dcond)[i] = model->DConductivityDDepth((*depth)[i], (*slope)[i], (*coef)[i]);
+    }
+    return (*cond)[n-1] + (*dcond)[n-1];
+  }
+};
+
+struct BatchedKernel {
+  Flow::ManningConductivityModel* model;
+  const std::vector<double>* depth;
+  const std::vector<double>* inv_scaling;
+  std::vector<double>* cond;
+  std::vector<double>* dcond;
+
+  double operator()() {
+    int n = depth->size();
+    model->ConductivityAndDerivative(n, &(*depth)[0], &(*inv_scaling)[0],
+            &(*cond)[0], &(*dcond)[0]);
+    return (*cond)[n-1] + (*dcond)[n-1];
+  }
+};
+
+} // namespace
+
+
+void
+BenchmarkManningConductivity(std::vector<Result>& results, int size)
+{
+  Teuchos::ParameterList plist;
+  plist.set("Manning exponent", 2./3.);
+  Flow::ManningConductivityModel model(plist);
+
+  // a mix of dry and ponded cells on a range of slopes
+  std::vector<double> depth(size), slope(size), coef(size, 0.03);
+  std::vector<double> inv_scaling(size), cond(size), dcond(size);
+  for (int i=0; i!=size; ++i) {
+    depth[i] = (i % 5 == 0) ? 0. : 1.e-3 * (i % 200);
+    slope[i] = 1.e-4 * (i % 100);
+    inv_scaling[i] = 1. / model.Scaling(slope[i], coef[i]);
+  }
+
+  ScalarKernel scalar;
+  scalar.model = &model;
+  scalar.depth = &depth;
+  scalar.slope = &slope;
+  scalar.coef = &coef;
+  scalar.cond = &cond;
+  scalar.dcond = &dcond;
+  results.push_back(Time("manning conductivity", size, 10, 5, scalar));
+
+  BatchedKernel batched;
+  batched.model = &model;
+  batched.depth = &depth;
+  batched.inv_scaling = &inv_scaling;
+  batched.cond = &cond;
+  batched.dcond = &dcond;
+  results.push_back(Time("manning conductivity, batched", size, 10, 5, batched));
+}
+
+} // namespace
+} // namespace
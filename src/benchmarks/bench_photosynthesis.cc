@@ -0,0 +1,103 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Micro-benchmark of canopy photosynthesis in BGC simple: every leaf layer of
+  a PFT, layer by layer and batched, over a range of light and air
+  temperatures.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "vegetation.hh"
+#include "benchmark.hh"
+
+namespace Amanzi {
+namespace Benchmarks {
+
+using namespace BGC;
+
+namespace {
+
+const int LEAF_LAYERS = 10;
+
+// Leaf layers of a column: light at the top of the canopy and air
+// temperature vary by column, light is attenuated through the layers.
+struct Canopy {
+  std::vector<double> tair;
+  std::vector<double> PARi, LUE, LER, mp, Vcmax25;
+  std::vector<double> A, tleaf, Resp, ET;
+
+  explicit Canopy(int ncols) :
+      tair(ncols),
+      PARi(ncols*LEAF_LAYERS), LUE(ncols*LEAF_LAYERS, 0.04), LER(ncols*LEAF_LAYERS, 0.2),
+      mp(ncols*LEAF_LAYERS, 9.), Vcmax25(ncols*LEAF_LAYERS),
+      A(ncols*LEAF_LAYERS), tleaf(ncols*LEAF_LAYERS), Resp(ncols*LEAF_LAYERS),
+      ET(ncols*LEAF_LAYERS, 0.) {
+    for (int c=0; c!=ncols; ++c) {
+      tair[c] = 1. + (c % 30);
+      double PAR = 100. + 50. * (c % 37);
+      double PARi_l = PAR;
+      for (int l=0; l!=LEAF_LAYERS; ++l) {
+        int i = c*LEAF_LAYERS + l;
+        PARi[i] = PARi_l;
+        double relCLNCa = std::min(1.0, std::max(0.2, 0.1802 * std::log(PARi_l/PAR) + 1.0));
+        Vcmax25[i] = 60. * relCLNCa;
+        PARi_l *= std::exp(-LER[i]);
+      }
+    }
+  }
+};
+
+struct ScalarKernel {
+  Canopy* canopy;
+
+  double operator()() {
+    Canopy& cn = *canopy;
+    for (int c=0; c!=cn.tair.size(); ++c) {
+      for (int l=0; l!=LEAF_LAYERS; ++l) {
+        int i = c*LEAF_LAYERS + l;
+        Photosynthesis(cn.PARi[i], cn.LUE[i], cn.LER[i], 101325., 2., cn.tair[c], 0.6, 390.,
+                       cn.mp[i], cn.Vcmax25[i], &cn.A[i], &cn.tleaf[i], &cn.Resp[i], &cn.ET[i]);
+      }
+    }
+    return cn.A[0] + cn.tleaf[cn.tleaf.size()-1];
+  }
+};
+
+struct BatchedKernel {
+  Canopy* canopy;
+
+  double operator()() {
+    Canopy& cn = *canopy;
+    for (int c=0; c!=cn.tair.size(); ++c) {
+      int i = c*LEAF_LAYERS;
+      PhotosynthesisBatch(LEAF_LAYERS, &cn.PARi[i], &cn.LUE[i], &cn.LER[i], 101325., 2., cn.tair[c], 0.6, 390.,
+                          &cn.mp[i], &cn.Vcmax25[i], &cn.A[i], &cn.tleaf[i], &cn.Resp[i], &cn.ET[i]);
+    }
+    return cn.A[0] + cn.tleaf[cn.tleaf.size()-1];
+  }
+};
+
+} // namespace
+
+
+void
+BenchmarkPhotosynthesis(std::vector<Result>& results, int size)
+{
+  // size counts leaves
+  Canopy canopy(std::max(size / LEAF_LAYERS, 1));
+
+  ScalarKernel scalar;
+  scalar.canopy = &canopy;
+  results.push_back(Time("bgc photosynthesis", size, 5, 5, scalar));
+
+  BatchedKernel batched;
+  batched.canopy = &canopy;
+  results.push_back(Time("bgc photosynthesis, batched", size, 5, 5, batched));
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,104 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Micro-benchmark of the snow surface temperature solve of the
+  SurfaceEnergyBalance, cell by cell and batched, over a range of snow packs
+  and forcing.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <vector>
+
+#include "SnowEnergyBalance.hh"
+#include "benchmark.hh"
+
+namespace Amanzi {
+namespace Benchmarks {
+
+using namespace SurfaceEnergyBalance;
+
+namespace {
+
+// A cell with incoming radiation and vapor pressures already updated, as they
+// are when CalcSnowTemperature is called.
+LocalData
+SnowCell(int i)
+{
+  LocalData data;
+  data.st_energy.dt = 3600.;
+  data.st_energy.AlbedoTrans = 0.02;
+  data.st_energy.Zo = 0.005;
+
+  data.st_energy.water_depth = 0.;
+  data.st_energy.water_fraction = 0.;
+  data.st_energy.temp_ground = 270.15;
+  data.vp_ground.temp = 270.15;
+  data.vp_ground.actual_vaporpressure = 0.3;
+  data.st_energy.porrowaLe = 0.5 * 1.275 * data.st_energy.Le;
+
+  double air_temp = 250.15 + (i % 25);
+  data.st_energy.temp_air = air_temp;
+  data.st_energy.QswIn = 10. * (i % 30);
+  data.st_energy.Us = 1. + (i % 4);
+  data.st_energy.Pr = 0.;
+  data.st_energy.Ps = 0.;
+  data.vp_air.temp = air_temp;
+  data.vp_air.relative_humidity = 0.8;
+
+  data.st_energy.ht_snow = 0.05 + 0.02 * (i % 40);
+  data.st_energy.density_snow = 200.;
+  data.st_energy.age_snow = 2.;
+
+  UpdateVaporPressure(data.vp_air);
+  data.st_energy.albedo_value = CalcAlbedo(data.st_energy);
+  UpdateIncomingRadiation(data);
+  return data;
+}
+
+struct ScalarKernel {
+  const std::vector<LocalData>* cells;
+  std::vector<LocalData>* work;
+
+  double operator()() {
+    double sum = 0.;
+    *work = *cells;
+    for (int i=0; i!=work->size(); ++i) sum += CalcSnowTemperature((*work)[i]);
+    return sum;
+  }
+};
+
+struct BatchedKernel {
+  const std::vector<LocalData>* cells;
+  std::vector<LocalData>* work;
+
+  double operator()() {
+    *work = *cells;
+    CalcSnowTemperatures(*work);
+    return (*work)[0].st_energy.temp_snow + (*work)[work->size()-1].st_energy.temp_snow;
+  }
+};
+
+} // namespace
+
+
+void
+BenchmarkSnowTemperature(std::vector<Result>& results, int size)
+{
+  std::vector<LocalData> cells, work;
+  cells.reserve(size);
+  for (int i=0; i!=size; ++i) cells.push_back(SnowCell(i));
+
+  ScalarKernel scalar;
+  scalar.cells = &cells;
+  scalar.work = &work;
+  results.push_back(Time("seb snow temperature", size, 5, 5, scalar));
+
+  BatchedKernel batched;
+  batched.cells = &cells;
+  batched.work = &work;
+  results.push_back(Time("seb snow temperature, batched", size, 5, 5, batched));
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,105 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Micro-benchmark of the per-cell work of ThermalConductivityThreePhaseEvaluator
+  with the Peters-Lidard model: conductivity cell by cell, and in one batched
+  sweep with the porosity terms precomputed.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <vector>
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "thermal_conductivity_threephase_peterslidard.hh"
+#include "benchmark.hh"
+
+namespace Amanzi {
+namespace Benchmarks {
+
+namespace {
+
+struct ScalarKernel {
+  Energy::ThermalConductivityThreePhasePetersLidard* model;
+  const std::vector<double>* poro;
+  const std::vector<double>* sat_liq;
+  const std::vector<double>* sat_ice;
+  const std::vector<double>* temp;
+  std::vector<double>* k;
+
+  double operator()() {
+    int n = poro->size();
+    for (int i=0; i!=n; ++i) {
+      (*k)[i] = model->ThermalConductivity((*poro)[i], (*sat_liq)[i],
+              (*sat_ice)[i], (*temp)[i]);
+    }
+    return (*k)[n-1];
+  }
+};
+
+struct BatchedKernel {
+  Energy::ThermalConductivityThreePhasePetersLidard* model;
+  const std::vector<double>* poro;
+  const std::vector<double>* sat_liq;
+  const std::vector<double>* sat_ice;
+  const std::vector<double>* temp;
+  const std::vector<double>* poro_terms;
+  std::vector<double>* k;
+
+  double operator()() {
+    int n = poro->size();
+    model->ThermalConductivities(n, &(*poro)[0], &(*sat_liq)[0], &(*sat_ice)[0],
+            &(*temp)[0], &(*poro_terms)[0], &(*k)[0], NULL, NULL, NULL, NULL);
+    return (*k)[n-1];
+  }
+};
+
+} // namespace
+
+
+void
+BenchmarkThermalConductivity(std::vector<Result>& results, int size)
+{
+  Teuchos::ParameterList plist;
+  plist.set("unsaturated alpha unfrozen [-]", 0.5);
+  plist.set("unsaturated alpha frozen [-]", 1.0);
+  plist.set("thermal conductivity of soil [W/(m-K)]", 2.0);
+  plist.set("thermal conductivity of ice [W/(m-K)]", 2.1);
+  plist.set("thermal conductivity of liquid [W/(m-K)]", 0.6);
+  plist.set("thermal conductivity of gas [W/(m-K)]", 0.02);
+  Energy::ThermalConductivityThreePhasePetersLidard model(plist);
+
+  // partially frozen, partially saturated cells over a range of porosities
+  std::vector<double> poro(size), sat_liq(size), sat_ice(size), temp(size, 271.);
+  std::vector<double> k(size);
+  for (int i=0; i!=size; ++i) {
+    poro[i] = 0.1 + 0.8 * (i % 97) / 97.;
+    sat_liq[i] = (i % 13) / 13.;
+    sat_ice[i] = 0.9 * (1. - sat_liq[i]) * (i % 7) / 7.;
+  }
+  std::vector<double> poro_terms(model.NumPorosityTerms() * size);
+  model.PorosityTerms(size, &poro[0], &poro_terms[0]);
+
+  ScalarKernel scalar;
+  scalar.model = &model;
+  scalar.poro = &poro;
+  scalar.sat_liq = &sat_liq;
+  scalar.sat_ice = &sat_ice;
+  scalar.temp = &temp;
+  scalar.k = &k;
+  results.push_back(Time("thermal conductivity Peters-Lidard", size, 10, 5, scalar));
+
+  BatchedKernel batched;
+  batched.model = &model;
+  batched.poro = &poro;
+  batched.sat_liq = &sat_liq;
+  batched.sat_ice = &sat_ice;
+  batched.temp = &temp;
+  batched.poro_terms = &poro_terms;
+  batched.k = &k;
+  results.push_back(Time("thermal conductivity Peters-Lidard, batched", size, 10, 5, batched));
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,68 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Micro-benchmark of the per-cell work of WRMEvaluator: saturation and its
+  derivative with respect to capillary pressure, for a column's worth of cells
+  repeated to the requested size.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <cmath>
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "wrm_van_genuchten.hh"
+#include "benchmark.hh"
+
+namespace Amanzi {
+namespace Benchmarks {
+
+namespace {
+
+struct WRMKernel {
+  Teuchos::RCP<Flow::WRM> wrm;
+  const std::vector<double>* pc;
+  std::vector<double>* sat;
+  std::vector<double>* dsat;
+
+  double operator()() {
+    int n = pc->size();
+    for (int c=0; c!=n; ++c) {
+      (*sat)[c] = wrm->saturation((*pc)[c]);
+      (*dsat)[c] = wrm->d_saturation((*pc)[c]);
+    }
+    return (*sat)[n/2] + (*dsat)[n/2];
+  }
+};
+
+} // namespace
+
+
+void
+BenchmarkWRM(std::vector<Result>& results, int size)
+{
+  Teuchos::ParameterList plist;
+  plist.set("van Genuchten alpha", 2.e-4);
+  plist.set("van Genuchten m", 0.3);
+  plist.set("residual saturation", 0.1);
+  plist.set("smoothing interval width [saturation]", 0.05);
+
+  // capillary pressures of a 100-cell column from saturated at the bottom to
+  // dry at the surface, repeated
+  std::vector<double> pc(size), sat(size), dsat(size);
+  for (int c=0; c!=size; ++c) {
+    double depth = (c % 100) / 100.;
+    pc[c] = -1.e4 + 1.e5 * std::pow(depth, 2);
+  }
+
+  WRMKernel kernel;
+  kernel.wrm = Teuchos::rcp(new Flow::WRMVanGenuchten(plist));
+  kernel.pc = &pc;
+  kernel.sat = &sat;
+  kernel.dsat = &dsat;
+  results.push_back(Time("wrm van Genuchten", size, 10, 5, kernel));
+}
+
+} // namespace
+} // namespace
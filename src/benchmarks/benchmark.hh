@@ -0,0 +1,106 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Timing and reporting helpers for ATS micro-benchmarks.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Micro-benchmarks time a single kernel on a fixed, synthetic problem.  Each is
+run for several repeats of a number of calls; the best and mean time per call
+over repeats are reported, in the same JSON record format as the problem
+benchmarks written by the coordinator's `"benchmark summary file`", so that
+``tools/benchmarks/run_benchmarks.py`` can collect and compare both:
+
+.. code-block:: json
+
+    { "name": "wrm van Genuchten", "kind": "micro",
+      "metrics": { "size": 1000000, "time per call [s]": 0.012, ... } }
+
+*/
+
+#ifndef ATS_BENCHMARKS_BENCHMARK_HH_
+#define ATS_BENCHMARKS_BENCHMARK_HH_
+
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Teuchos_Time.hpp"
+
+namespace Amanzi {
+namespace Benchmarks {
+
+struct Result {
+  std::string name;
+  int size;           // problem size, e.g. number of cells
+  int calls;          // calls of the kernel per repeat
+  double best;        // [s] per call, fastest repeat
+  double mean;        // [s] per call, mean over repeats
+  double checksum;    // sum of outputs, keeps the kernel from being optimized away
+};
+
+
+// Times kernel(), which returns a checksum, over repeats of calls each.
+template<class Kernel>
+Result Time(const std::string& name, int size, int calls, int repeats, Kernel kernel)
+{
+  Result result;
+  result.name = name;
+  result.size = size;
+  result.calls = calls;
+  result.best = -1.;
+  result.mean = 0.;
+  result.checksum = 0.;
+
+  kernel(); // warm up caches and any lazily built data
+
+  Teuchos::Time timer(name);
+  for (int r=0; r!=repeats; ++r) {
+    timer.start(true);
+    for (int i=0; i!=calls; ++i) result.checksum += kernel();
+    timer.stop();
+
+    double per_call = timer.totalElapsedTime() / calls;
+    if (result.best < 0. || per_call < result.best) result.best = per_call;
+    result.mean += per_call / repeats;
+  }
+  return result;
+}
+
+
+inline void
+WriteJSON(std::ostream& os, const std::vector<Result>& results)
+{
+  os << std::setprecision(8) << "[" << std::endl;
+  for (int i=0; i!=results.size(); ++i) {
+    const Result& r = results[i];
+    os << "  { \"name\": \"" << r.name << "\", \"kind\": \"micro\"," << std::endl
+       << "    \"metrics\": { \"size\": " << r.size
+       << ", \"calls\": " << r.calls
+       << ", \"time per call [s]\": " << r.best
+       << ", \"mean time per call [s]\": " << r.mean
+       << ", \"checksum\": " << r.checksum << " } }"
+       << (i+1 == results.size() ? "" : ",") << std::endl;
+  }
+  os << "]" << std::endl;
+}
+
+
+// The suite.  Each appends its results; size scales the synthetic problem.
+void BenchmarkWRM(std::vector<Result>& results, int size);
+void BenchmarkSnowTemperature(std::vector<Result>& results, int size);
+void BenchmarkManningConductivity(std::vector<Result>& results, int size);
+void BenchmarkPhotosynthesis(std::vector<Result>& results, int size);
+void BenchmarkThermalConductivity(std::vector<Result>& results, int size);
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,56 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  Driver for the ATS micro-benchmarks.
+
+  Usage: ats_benchmarks [--size=N] [--output=FILE]
+
+  Runs every micro-benchmark on a synthetic problem of N cells (default
+  100000), writing JSON results to FILE (default stdout).
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Teuchos_GlobalMPISession.hpp"
+
+#include "benchmark.hh"
+
+int main(int argc, char *argv[])
+{
+  Teuchos::GlobalMPISession mpiSession(&argc,&argv);
+
+  int size = 100000;
+  std::string output;
+  for (int i=1; i!=argc; ++i) {
+    std::string arg(argv[i]);
+    if (arg.find("--size=") == 0) {
+      size = std::atoi(arg.substr(7).c_str());
+    } else if (arg.find("--output=") == 0) {
+      output = arg.substr(9);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--size=N] [--output=FILE]" << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<Amanzi::Benchmarks::Result> results;
+  Amanzi::Benchmarks::BenchmarkWRM(results, size);
+  Amanzi::Benchmarks::BenchmarkSnowTemperature(results, size);
+  Amanzi::Benchmarks::BenchmarkManningConductivity(results, size);
+  Amanzi::Benchmarks::BenchmarkPhotosynthesis(results, size);
+  Amanzi::Benchmarks::BenchmarkThermalConductivity(results, size);
+
+  if (output.empty()) {
+    Amanzi::Benchmarks::WriteJSON(std::cout, results);
+  } else {
+    std::ofstream os(output.c_str());
+    Amanzi::Benchmarks::WriteJSON(os, results);
+  }
+  return 0;
+}
@@ -32,6 +32,28 @@ class EOS {
   // !IsConstantMolarMass()
   virtual bool IsConstantMolarMass() = 0;
   virtual double MolarMass() = 0;
+
+  // Fused evaluation over n points: computes the density and both of its
+  // partial derivatives in one sweep.  Any of the outputs may be NULL if not
+  // needed.  The default simply calls the pointwise methods; models override
+  // these with a non-virtual kernel so that the loop can be vectorized.
+  virtual void MassDensityAndDerivatives(int n, const double* T, const double* p,
+          double* rho, double* drho_dT, double* drho_dp) {
+    for (int i=0; i!=n; ++i) {
+      if (rho) rho[i] = MassDensity(T[i], p[i]);
+      if (drho_dT) drho_dT[i] = DMassDensityDT(T[i], p[i]);
+      if (drho_dp) drho_dp[i] = DMassDensityDp(T[i], p[i]);
+    }
+  }
+
+  virtual void MolarDensityAndDerivatives(int n, const double* T, const double* p,
+          double* n_rho, double* dn_rho_dT, double* dn_rho_dp) {
+    for (int i=0; i!=n; ++i) {
+      if (n_rho) n_rho[i] = MolarDensity(T[i], p[i]);
+      if (dn_rho_dT) dn_rho_dT[i] = DMolarDensityDT(T[i], p[i]);
+      if (dn_rho_dp) dn_rho_dp[i] = DMolarDensityDp(T[i], p[i]);
+    }
+  }
 };
 
 } // namespace
@@ -55,6 +55,15 @@ class EOSConstantMolarMass : public EOS {
   virtual double MolarMass() { return M_; }
 
  protected:
+  // Scales the (possibly NULL) outputs of a fused evaluation, used to get
+  // molar from mass densities or vice versa.
+  void ScaleDensities_(int n, double scale,
+                       double* rho, double* drho_dT, double* drho_dp) {
+    if (rho) for (int i=0; i!=n; ++i) rho[i] *= scale;
+    if (drho_dT) for (int i=0; i!=n; ++i) drho_dT[i] *= scale;
+    if (drho_dp) for (int i=0; i!=n; ++i) drho_dp[i] *= scale;
+  }
+
   double M_;
 
 };
@@ -92,6 +92,8 @@ EOSEvaluator::EOSEvaluator(Teuchos::ParameterList& plist) :
   ASSERT(plist_.isSublist("EOS parameters"));
   EOSFactory eos_fac;
   eos_ = eos_fac.createEOS(plist_.sublist("EOS parameters"));
+
+  fused_ = plist_.get<bool>("fused derivative evaluation", true);
 };
 
 
@@ -99,6 +101,7 @@ EOSEvaluator::EOSEvaluator(const EOSEvaluator& other) :
     SecondaryVariablesFieldEvaluator(other),
     eos_(other.eos_),
     mode_(other.mode_),
+    fused_(other.fused_),
     temp_key_(other.temp_key_),
     pres_key_(other.pres_key_) {}
 
@@ -110,164 +113,125 @@ Teuchos::RCP<FieldEvaluator> EOSEvaluator::Clone() const {
 
 void EOSEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
                          const std::vector<Teuchos::Ptr<CompositeVector> >& results) {
-  // Pull dependencies out of state.
-  Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
-  Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);
-
-  Teuchos::Ptr<CompositeVector> molar_dens, mass_dens;
-  if (mode_ == EOS_MODE_MOLAR) {
-    molar_dens = results[0];
-  } else if (mode_ == EOS_MODE_MASS) {
-    mass_dens = results[0];
-  } else {
-    molar_dens = results[0];
-    mass_dens = results[1];
+  std::vector<Teuchos::Ptr<CompositeVector> > ddens_dT(results.size());
+  std::vector<Teuchos::Ptr<CompositeVector> > ddens_dp(results.size());
+
+  if (fused_) {
+    if (ddens_dT_.size() == 0) {
+      for (int i=0; i!=results.size(); ++i) {
+        ddens_dT_.push_back(Teuchos::rcp(new CompositeVector(*results[i])));
+        ddens_dp_.push_back(Teuchos::rcp(new CompositeVector(*results[i])));
+      }
+    }
+    for (int i=0; i!=results.size(); ++i) {
+      ddens_dT[i] = ddens_dT_[i].ptr();
+      ddens_dp[i] = ddens_dp_[i].ptr();
+    }
   }
 
+  EvaluateDensities_(S, results, ddens_dT, ddens_dp);
+}
 
-  if (molar_dens != Teuchos::null) {
-    // evaluate MolarDensity()
-    for (CompositeVector::name_iterator comp=molar_dens->begin();
-         comp!=molar_dens->end(); ++comp) {
-      const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
-      const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-      Epetra_MultiVector& dens_v = *(molar_dens->ViewComponent(*comp,false));
 
-      int count = dens_v.MyLength();
-      for (int id=0; id!=count; ++id) {
-        dens_v[0][id] = eos_->MolarDensity(temp_v[0][id], pres_v[0][id]);
-        ASSERT(dens_v[0][id] > 0.);
-      }
-    }
-  }
+void EOSEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+        Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> >& results) {
+  ASSERT(wrt_key == pres_key_ || wrt_key == temp_key_);
 
-  if (mass_dens != Teuchos::null) {
-    for (CompositeVector::name_iterator comp=mass_dens->begin();
-         comp!=mass_dens->end(); ++comp) {
-      if (mode_ == EOS_MODE_BOTH && eos_->IsConstantMolarMass() &&
-          molar_dens->HasComponent(*comp)) {
-        // calculate MassDensity from MolarDensity and molar mass.
-        double M = eos_->MolarMass();
+  if (fused_) {
+    // Make sure the values, and therefore the cached derivatives, are
+    // current.  This only evaluates if a dependency has changed.
+    HasFieldChanged(S, my_keys_[0]+" fused derivatives");
+    ASSERT(ddens_dT_.size() == results.size());
 
-        mass_dens->ViewComponent(*comp,false)->Update(M,
-                *molar_dens->ViewComponent(*comp,false), 0.);
+    for (int i=0; i!=results.size(); ++i) {
+      if (wrt_key == pres_key_) {
+        results[i]->Update(1.0, *ddens_dp_[i], 0.0);
       } else {
-        // evaluate MassDensity() directly
-        const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
-        const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-        Epetra_MultiVector& dens_v = *(mass_dens->ViewComponent(*comp,false));
-
-        int count = dens_v.MyLength();
-        for (int id=0; id!=count; ++id) {
-          dens_v[0][id] = eos_->MassDensity(temp_v[0][id], pres_v[0][id]);
-          ASSERT(dens_v[0][id] > 0.);
-        }
+        results[i]->Update(1.0, *ddens_dT_[i], 0.0);
       }
     }
+    return;
   }
-}
 
+  std::vector<Teuchos::Ptr<CompositeVector> > dens(results.size());
+  std::vector<Teuchos::Ptr<CompositeVector> > other(results.size());
+  if (wrt_key == pres_key_) {
+    EvaluateDensities_(S, dens, other, results);
+  } else {
+    EvaluateDensities_(S, dens, results, other);
+  }
+}
 
-void EOSEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
-        Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> >& results) {
 
+void EOSEvaluator::EvaluateDensities_(const Teuchos::Ptr<State>& S,
+        const std::vector<Teuchos::Ptr<CompositeVector> >& dens,
+        const std::vector<Teuchos::Ptr<CompositeVector> >& ddens_dT,
+        const std::vector<Teuchos::Ptr<CompositeVector> >& ddens_dp) {
   // Pull dependencies out of state.
   Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
   Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);
 
-  Teuchos::Ptr<CompositeVector> molar_dens, mass_dens;
+  int molar_i = -1;
+  int mass_i = -1;
   if (mode_ == EOS_MODE_MOLAR) {
-    molar_dens = results[0];
+    molar_i = 0;
   } else if (mode_ == EOS_MODE_MASS) {
-    mass_dens = results[0];
+    mass_i = 0;
   } else {
-    molar_dens = results[0];
-    mass_dens = results[1];
+    molar_i = 0;
+    mass_i = 1;
   }
 
-  if (wrt_key == pres_key_) {
-    if (molar_dens != Teuchos::null) {
-      // evaluate MolarDensity()
-      for (CompositeVector::name_iterator comp=molar_dens->begin();
-           comp!=molar_dens->end(); ++comp) {
-        const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
-        const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-        Epetra_MultiVector& dens_v = *(molar_dens->ViewComponent(*comp,false));
-
-        int count = dens_v.MyLength();
-        for (int id=0; id!=count; ++id) {
-          dens_v[0][id] = eos_->DMolarDensityDp(temp_v[0][id], pres_v[0][id]);
-        }
-      }
+  // Molar first, as mass density may be calculated from it.
+  for (int i=0; i!=dens.size(); ++i) {
+    Teuchos::Ptr<CompositeVector> outs[3] = { dens[i], ddens_dT[i], ddens_dp[i] };
+    Teuchos::Ptr<CompositeVector> molar_outs[3];
+    if (molar_i >= 0) {
+      molar_outs[0] = dens[molar_i];
+      molar_outs[1] = ddens_dT[molar_i];
+      molar_outs[2] = ddens_dp[molar_i];
     }
 
-    if (mass_dens != Teuchos::null) {
-      for (CompositeVector::name_iterator comp=mass_dens->begin();
-           comp!=mass_dens->end(); ++comp) {
-        if (mode_ == EOS_MODE_BOTH && eos_->IsConstantMolarMass() &&
-            molar_dens->HasComponent(*comp)) {
-          // calculate MassDensity from MolarDensity and molar mass.
-          double M = eos_->MolarMass();
-
-          mass_dens->ViewComponent(*comp,false)->Update(M,
-                  *molar_dens->ViewComponent(*comp,false), 0.);
-        } else {
-          // evaluate MassDensity() directly
-          const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
-          const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-          Epetra_MultiVector& dens_v = *(mass_dens->ViewComponent(*comp,false));
-
-          int count = dens_v.MyLength();
-          for (int id=0; id!=count; ++id) {
-            dens_v[0][id] = eos_->DMassDensityDp(temp_v[0][id], pres_v[0][id]);
-          }
-        }
-      }
+    // all non-null outputs share a structure
+    Teuchos::Ptr<CompositeVector> shape, molar_shape;
+    for (int k=0; k!=3; ++k) {
+      if (shape == Teuchos::null) shape = outs[k];
+      if (molar_shape == Teuchos::null) molar_shape = molar_outs[k];
     }
+    if (shape == Teuchos::null) continue;
 
-  } else if (wrt_key == temp_key_) {
-
-    if (molar_dens != Teuchos::null) {
-      // evaluate MolarDensity()
-      for (CompositeVector::name_iterator comp=molar_dens->begin();
-           comp!=molar_dens->end(); ++comp) {
-        const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
-        const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-        Epetra_MultiVector& dens_v = *(molar_dens->ViewComponent(*comp,false));
+    for (CompositeVector::name_iterator comp=shape->begin();
+         comp!=shape->end(); ++comp) {
+      double* out_v[3] = { NULL, NULL, NULL };
+      for (int k=0; k!=3; ++k)
+        if (outs[k] != Teuchos::null) out_v[k] = (*outs[k]->ViewComponent(*comp,false))[0];
+      int count = shape->ViewComponent(*comp,false)->MyLength();
 
-        int count = dens_v.MyLength();
-        for (int id=0; id!=count; ++id) {
-          dens_v[0][id] = eos_->DMolarDensityDT(temp_v[0][id], pres_v[0][id]);
+      if (i == mass_i && molar_shape != Teuchos::null &&
+          eos_->IsConstantMolarMass() && molar_shape->HasComponent(*comp)) {
+        // calculate MassDensity from MolarDensity and molar mass.
+        double M = eos_->MolarMass();
+        for (int k=0; k!=3; ++k) {
+          if (out_v[k] == NULL) continue;
+          const double* molar_v = (*molar_outs[k]->ViewComponent(*comp,false))[0];
+          for (int id=0; id!=count; ++id) out_v[k][id] = M * molar_v[id];
         }
-      }
-    }
-
-    if (mass_dens != Teuchos::null) {
-      for (CompositeVector::name_iterator comp=mass_dens->begin();
-           comp!=mass_dens->end(); ++comp) {
-        if (mode_ == EOS_MODE_BOTH && eos_->IsConstantMolarMass() &&
-            molar_dens->HasComponent(*comp)) {
-          // calculate MassDensity from MolarDensity and molar mass.
-          double M = eos_->MolarMass();
-
-          mass_dens->ViewComponent(*comp,false)->Update(M,
-                  *molar_dens->ViewComponent(*comp,false), 0.);
+      } else {
+        const double* temp_v = (*temp->ViewComponent(*comp,false))[0];
+        const double* pres_v = (*pres->ViewComponent(*comp,false))[0];
+        if (i == mass_i) {
+          eos_->MassDensityAndDerivatives(count, temp_v, pres_v,
+                  out_v[0], out_v[1], out_v[2]);
         } else {
-          // evaluate MassDensity() directly
-          const Epetra_MultiVector& temp_v = *(temp->ViewComponent(*comp,false));
-          const Epetra_MultiVector& pres_v = *(pres->ViewComponent(*comp,false));
-          Epetra_MultiVector& dens_v = *(mass_dens->ViewComponent(*comp,false));
-
-          int count = dens_v.MyLength();
-          for (int id=0; id!=count; ++id) {
-            dens_v[0][id] = eos_->DMassDensityDT(temp_v[0][id], pres_v[0][id]);
-          }
+          eos_->MolarDensityAndDerivatives(count, temp_v, pres_v,
+                  out_v[0], out_v[1], out_v[2]);
         }
       }
-    }
 
-  } else {
-    ASSERT(0);
+      if (out_v[0] != NULL) {
+        for (int id=0; id!=count; ++id) ASSERT(out_v[0][id] > 0.);
+      }
+    }
   }
 }
 
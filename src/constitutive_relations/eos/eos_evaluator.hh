@@ -3,6 +3,11 @@
 /*
   EOSFieldEvaluator is the interface between state/data and the model, an EOS.
 
+  With "fused derivative evaluation" (the default), each evaluation sweeps the
+  cells once, computing the densities and their temperature and pressure
+  derivatives together; the derivatives are cached and copied out when they
+  are requested.  This costs two extra vectors per density.
+
   License: BSD
   Authors: Ethan Coon (ecoon@lanl.gov)
 */
@@ -36,11 +41,24 @@ class EOSEvaluator : public SecondaryVariablesFieldEvaluator {
           Key wrt_key, const std::vector<Teuchos::Ptr<CompositeVector> >& results);
 
   Teuchos::RCP<EOS> get_EOS() { return eos_; }
+ protected:
+  // One sweep per component computing every non-null output.  All three
+  // vectors are indexed as results.
+  void EvaluateDensities_(const Teuchos::Ptr<State>& S,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& dens,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& ddens_dT,
+          const std::vector<Teuchos::Ptr<CompositeVector> >& ddens_dp);
+
  protected:
   // the actual model
   Teuchos::RCP<EOS> eos_;
   EOSMode mode_;
 
+  // derivatives computed alongside the values
+  bool fused_;
+  std::vector<Teuchos::RCP<CompositeVector> > ddens_dT_;
+  std::vector<Teuchos::RCP<CompositeVector> > ddens_dp_;
+
   // Keys for fields
   // dependencies
   Key temp_key_;
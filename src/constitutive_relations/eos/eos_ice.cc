@@ -48,6 +48,33 @@ double EOSIce::DMassDensityDp(double T, double p) {
   return rho1bar * kalpha_;
 };
 
+void EOSIce::MassDensityAndDerivatives(int n, const double* T, const double* p,
+        double* rho, double* drho_dT, double* drho_dp) {
+  if (rho && drho_dT && drho_dp) {
+    // the common case, all three share dT and the pressure factor
+    for (int i=0; i!=n; ++i) {
+      double dT = T[i] - kT0_;
+      double rho1bar = ka_ + (kb_ + kc_*dT)*dT;
+      double pfac = 1.0 + kalpha_*(p[i] - kp0_);
+      rho[i] = rho1bar * pfac;
+      drho_dT[i] = (kb_ + 2.0*kc_*dT) * pfac;
+      drho_dp[i] = rho1bar * kalpha_;
+    }
+  } else {
+    for (int i=0; i!=n; ++i) {
+      if (rho) rho[i] = EOSIce::MassDensity(T[i], p[i]);
+      if (drho_dT) drho_dT[i] = EOSIce::DMassDensityDT(T[i], p[i]);
+      if (drho_dp) drho_dp[i] = EOSIce::DMassDensityDp(T[i], p[i]);
+    }
+  }
+};
+
+void EOSIce::MolarDensityAndDerivatives(int n, const double* T, const double* p,
+        double* n_rho, double* dn_rho_dT, double* dn_rho_dp) {
+  EOSIce::MassDensityAndDerivatives(n, T, p, n_rho, dn_rho_dT, dn_rho_dp);
+  ScaleDensities_(n, 1.0/M_, n_rho, dn_rho_dT, dn_rho_dp);
+};
+
 
 void EOSIce::InitializeFromPlist_() {
   if (eos_plist_.isParameter("Molar mass of ice [kg/mol]")) {
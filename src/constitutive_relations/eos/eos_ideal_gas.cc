@@ -29,6 +29,31 @@ double EOSIdealGas::DMolarDensityDp(double T, double p) {
   return 1.0 / (R_*T);
 };
 
+void EOSIdealGas::MolarDensityAndDerivatives(int n, const double* T, const double* p,
+        double* n_rho, double* dn_rho_dT, double* dn_rho_dp) {
+  if (n_rho && dn_rho_dT && dn_rho_dp) {
+    // one division per point, shared by all three
+    for (int i=0; i!=n; ++i) {
+      double inv_RT = 1.0 / (R_*T[i]);
+      n_rho[i] = p[i] * inv_RT;
+      dn_rho_dT[i] = -n_rho[i] / T[i];
+      dn_rho_dp[i] = inv_RT;
+    }
+  } else {
+    for (int i=0; i!=n; ++i) {
+      if (n_rho) n_rho[i] = EOSIdealGas::MolarDensity(T[i], p[i]);
+      if (dn_rho_dT) dn_rho_dT[i] = EOSIdealGas::DMolarDensityDT(T[i], p[i]);
+      if (dn_rho_dp) dn_rho_dp[i] = EOSIdealGas::DMolarDensityDp(T[i], p[i]);
+    }
+  }
+};
+
+void EOSIdealGas::MassDensityAndDerivatives(int n, const double* T, const double* p,
+        double* rho, double* drho_dT, double* drho_dp) {
+  EOSIdealGas::MolarDensityAndDerivatives(n, T, p, rho, drho_dT, drho_dp);
+  ScaleDensities_(n, M_, rho, drho_dT, drho_dp);
+};
+
 
 void EOSIdealGas::InitializeFromPlist_() {
   R_ = eos_plist_.get<double>("Ideal gas constant [J/mol-K]", 8.3144621);
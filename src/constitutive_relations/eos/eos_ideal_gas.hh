@@ -29,6 +29,11 @@ public:
   virtual double DMolarDensityDT(double T, double p);
   virtual double DMolarDensityDp(double T, double p);
 
+  virtual void MolarDensityAndDerivatives(int n, const double* T, const double* p,
+          double* n_rho, double* dn_rho_dT, double* dn_rho_dp);
+  virtual void MassDensityAndDerivatives(int n, const double* T, const double* p,
+          double* rho, double* drho_dT, double* drho_dp);
+
 protected:
   virtual void InitializeFromPlist_();
 
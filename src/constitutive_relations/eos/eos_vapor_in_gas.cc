@@ -30,6 +30,12 @@ double EOSVaporInGas::DMolarDensityDp(double T, double p) {
   return gas_eos_->DMolarDensityDp(T,p);
 };
 
+void EOSVaporInGas::MolarDensityAndDerivatives(int n, const double* T, const double* p,
+        double* n_rho, double* dn_rho_dT, double* dn_rho_dp) {
+  // one virtual call per sweep, not per point
+  gas_eos_->MolarDensityAndDerivatives(n, T, p, n_rho, dn_rho_dT, dn_rho_dp);
+};
+
 
 
 void EOSVaporInGas::InitializeFromPlist_() {
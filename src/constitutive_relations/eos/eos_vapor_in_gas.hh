@@ -35,6 +35,9 @@ public:
   double DMolarDensityDT(double T, double p);
   double DMolarDensityDp(double T, double p);
 
+  void MolarDensityAndDerivatives(int n, const double* T, const double* p,
+          double* n_rho, double* dn_rho_dT, double* dn_rho_dp);
+
   bool IsConstantMolarMass() { return false; }
   double MolarMass() { ASSERT(0); return 0.0; }
 
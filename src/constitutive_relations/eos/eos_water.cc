@@ -52,5 +52,34 @@ double EOSWater::DMassDensityDp(double T, double p) {
   return rho1bar * kalpha_;
 };
 
+
+void EOSWater::MassDensityAndDerivatives(int n, const double* T, const double* p,
+        double* rho, double* drho_dT, double* drho_dp) {
+  if (rho && drho_dT && drho_dp) {
+    // the common case, all three share dT and the pressure factor
+    for (int i=0; i!=n; ++i) {
+      double dT = T[i] - kT0_;
+      double rho1bar = ka_ + (kb_ + (kc_ + kd_*dT)*dT)*dT;
+      double pfac = 1.0 + kalpha_*(p[i] - kp0_);
+      rho[i] = rho1bar * pfac;
+      drho_dT[i] = (kb_ + (2.0*kc_ + 3.0*kd_*dT)*dT) * pfac;
+      drho_dp[i] = rho1bar * kalpha_;
+    }
+  } else {
+    for (int i=0; i!=n; ++i) {
+      if (rho) rho[i] = EOSWater::MassDensity(T[i], p[i]);
+      if (drho_dT) drho_dT[i] = EOSWater::DMassDensityDT(T[i], p[i]);
+      if (drho_dp) drho_dp[i] = EOSWater::DMassDensityDp(T[i], p[i]);
+    }
+  }
+};
+
+
+void EOSWater::MolarDensityAndDerivatives(int n, const double* T, const double* p,
+        double* n_rho, double* dn_rho_dT, double* dn_rho_dp) {
+  EOSWater::MassDensityAndDerivatives(n, T, p, n_rho, dn_rho_dT, dn_rho_dp);
+  ScaleDensities_(n, 1.0/M_, n_rho, dn_rho_dT, dn_rho_dp);
+};
+
 } // namespace
 } // namespace
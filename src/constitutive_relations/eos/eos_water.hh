@@ -32,6 +32,11 @@ public:
   virtual double DMassDensityDT(double T, double p);
   virtual double DMassDensityDp(double T, double p);
 
+  virtual void MassDensityAndDerivatives(int n, const double* T, const double* p,
+          double* rho, double* drho_dT, double* drho_dp);
+  virtual void MolarDensityAndDerivatives(int n, const double* T, const double* p,
+          double* n_rho, double* dn_rho_dT, double* dn_rho_dp);
+
 private:
   Teuchos::ParameterList eos_plist_;
 
@@ -0,0 +1,128 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  MetForcingCache is a process-wide store of meteorological time series, as
+  written by convert_met_to_h5.py.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include <algorithm>
+
+#include "errors.hh"
+#include "HDF5Reader.hh"
+
+#include "MetForcingCache.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+std::map<std::string, Teuchos::RCP<MetForcingCache> > MetForcingCache::caches_;
+
+
+Teuchos::RCP<MetForcingCache>
+MetForcingCache::Get(const std::string& filename, const std::string& time_header)
+{
+  std::string key = filename + ":" + time_header;
+  std::map<std::string, Teuchos::RCP<MetForcingCache> >::iterator cache =
+      caches_.find(key);
+  if (cache == caches_.end()) {
+    Teuchos::RCP<MetForcingCache> new_cache =
+        Teuchos::rcp(new MetForcingCache(filename, time_header));
+    caches_[key] = new_cache;
+    return new_cache;
+  }
+  return cache->second;
+}
+
+
+MetForcingCache::MetForcingCache(const std::string& filename,
+        const std::string& time_header) :
+    filename_(filename),
+    interval_(0)
+{
+  HDF5Reader reader(filename_);
+  reader.ReadData(time_header, times_);
+
+  if (times_.size() == 0) {
+    Errors::Message msg;
+    msg << "MetForcingCache: file \"" << filename_ << "\" has no data for time header \""
+        << time_header << "\"";
+    Exceptions::amanzi_throw(msg);
+  }
+  for (int i=1; i!=times_.size(); ++i) {
+    if (times_[i] <= times_[i-1]) {
+      Errors::Message msg;
+      msg << "MetForcingCache: times in file \"" << filename_ << "\" are not strictly increasing.";
+      Exceptions::amanzi_throw(msg);
+    }
+  }
+}
+
+
+double
+MetForcingCache::Value(const std::string& header, double t)
+{
+  Series& series = GetSeries_(header);
+  if (series.evaluated && series.time == t) return series.value;
+
+  int i = FindInterval_(t);
+  if (t <= times_[0]) {
+    series.value = series.values[0];
+  } else if (i == times_.size() - 1) {
+    series.value = series.values[i];
+  } else {
+    double coef = (t - times_[i]) / (times_[i+1] - times_[i]);
+    series.value = series.values[i] + coef * (series.values[i+1] - series.values[i]);
+  }
+  series.time = t;
+  series.evaluated = true;
+  return series.value;
+}
+
+
+MetForcingCache::Series&
+MetForcingCache::GetSeries_(const std::string& header)
+{
+  std::map<std::string, Series>::iterator series = series_.find(header);
+  if (series != series_.end()) return series->second;
+
+  Series& new_series = series_[header];
+  new_series.evaluated = false;
+  new_series.time = 0.;
+  new_series.value = 0.;
+
+  HDF5Reader reader(filename_);
+  reader.ReadData(header, new_series.values);
+  if (new_series.values.size() != times_.size()) {
+    Errors::Message msg;
+    msg << "MetForcingCache: series \"" << header << "\" in file \"" << filename_
+        << "\" is not the same length as the times.";
+    series_.erase(header);
+    Exceptions::amanzi_throw(msg);
+  }
+  return new_series;
+}
+
+
+int
+MetForcingCache::FindInterval_(double t)
+{
+  int n = times_.size();
+  if (t <= times_[0]) {
+    interval_ = 0;
+  } else if (t >= times_[n-1]) {
+    interval_ = n-1;
+  } else if (interval_ < n-1 && times_[interval_] <= t && t < times_[interval_+1]) {
+    // same interval
+  } else if (interval_+2 < n && times_[interval_+1] <= t && t < times_[interval_+2]) {
+    // next interval
+    interval_++;
+  } else {
+    interval_ = std::upper_bound(times_.begin(), times_.end(), t) - times_.begin() - 1;
+  }
+  return interval_;
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,67 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  MetForcingCache is a process-wide store of meteorological time series, as
+  written by convert_met_to_h5.py.
+
+  Each file is read at most once per process, each series is read on first
+  use, and each series is interpolated at most once per time, no matter how
+  many evaluators (e.g. one per column of a column ensemble) ask for it.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#ifndef AMANZI_RELATIONS_MET_FORCING_CACHE_
+#define AMANZI_RELATIONS_MET_FORCING_CACHE_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+
+namespace Amanzi {
+namespace Relations {
+
+class MetForcingCache {
+
+ public:
+  // Returns the cache for this file and time header, creating it on first
+  // use.
+  static Teuchos::RCP<MetForcingCache>
+  Get(const std::string& filename, const std::string& time_header);
+
+  MetForcingCache(const std::string& filename, const std::string& time_header);
+
+  // Value of the series named header at time t, linearly interpolated in
+  // time and held constant outside of the record.
+  double Value(const std::string& header, double t);
+
+ protected:
+  struct Series {
+    std::vector<double> values;
+    bool evaluated;
+    double time;    // time of the last interpolation
+    double value;   // value at that time
+  };
+
+  Series& GetSeries_(const std::string& header);
+
+  // Index i such that times_[i] <= t < times_[i+1], searching from the
+  // previous result first as time is nearly always monotonic.
+  int FindInterval_(double t);
+
+ protected:
+  std::string filename_;
+  std::vector<double> times_;
+  std::map<std::string, Series> series_;
+  int interval_;
+
+ private:
+  static std::map<std::string, Teuchos::RCP<MetForcingCache> > caches_;
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,61 @@
+/*
+  MetForcingEvaluator is an independent variable evaluator that is spatially
+  uniform in its domain and whose value comes from a met forcing time series.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "errors.hh"
+#include "MetForcingEvaluator.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+MetForcingEvaluator::MetForcingEvaluator(Teuchos::ParameterList& plist) :
+    IndependentVariableFieldEvaluator(plist)
+{
+  header_ = plist_.get<std::string>("variable header");
+
+  // per-column data: replace the wildcard with the column ID of the domain
+  std::size_t wildcard = header_.find('*');
+  if (wildcard != std::string::npos) {
+    Key domain = Keys::getDomain(my_key_);
+    std::size_t id_start = domain.find_last_of('_');
+    std::string id = id_start == std::string::npos ? "" : domain.substr(id_start+1);
+    if (id.empty() || id.find_first_not_of("0123456789") != std::string::npos) {
+      Errors::Message msg;
+      msg << "MetForcingEvaluator for \"" << my_key_ << "\": \"variable header\" \""
+          << header_ << "\" contains a wildcard, but domain \"" << domain
+          << "\" is not a column domain.";
+      Exceptions::amanzi_throw(msg);
+    }
+    header_.replace(wildcard, 1, id);
+  }
+
+  cache_ = MetForcingCache::Get(plist_.get<std::string>("file"),
+          plist_.get<std::string>("time header", "time"));
+}
+
+
+MetForcingEvaluator::MetForcingEvaluator(const MetForcingEvaluator& other) :
+    IndependentVariableFieldEvaluator(other),
+    header_(other.header_),
+    cache_(other.cache_)
+{}
+
+
+Teuchos::RCP<FieldEvaluator>
+MetForcingEvaluator::Clone() const
+{
+  return Teuchos::rcp(new MetForcingEvaluator(*this));
+}
+
+
+void
+MetForcingEvaluator::UpdateField_(const Teuchos::Ptr<State>& S)
+{
+  S->GetFieldData(my_key_, my_key_)->PutScalar(cache_->Value(header_, S->time()));
+}
+
+} // namespace
+} // namespace
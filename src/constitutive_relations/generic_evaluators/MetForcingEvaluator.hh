@@ -0,0 +1,72 @@
+/*
+  MetForcingEvaluator is an independent variable evaluator that is spatially
+  uniform in its domain and whose value comes from a met forcing time series.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Met forcing data, as written by ``convert_met_to_h5.py``, is read through a
+process-wide MetForcingCache, so that many domains (e.g. every
+``surface_column_ID`` of a column ensemble) requiring the same forcing read
+the file once and interpolate once per time, rather than each evaluating its
+own function of the same data.
+
+* `"file`" ``[string]`` HDF5 file of met data.
+* `"time header`" ``[string]`` **time** Name of the times dataset, in [s].
+* `"variable header`" ``[string]`` Name of the dataset for this variable.  If
+  it contains a ``*``, the ``*`` is replaced by the column ID of the
+  evaluator's domain, i.e. ``ID`` in ``surface_column_ID`` or ``column_ID``,
+  allowing per-column forcing.
+* `"constant in time`" ``[bool]`` **false** Evaluate only once.
+
+Example:
+
+.. code-block:: xml
+
+    <ParameterList name="surface_column_*-air_temperature">
+      <Parameter name="field evaluator type" type="string" value="independent variable from met forcing"/>
+      <Parameter name="file" type="string" value="met_data.h5"/>
+      <Parameter name="variable header" type="string" value="Ta"/>
+    </ParameterList>
+
+*/
+
+#ifndef AMANZI_RELATIONS_MET_FORCING_EVALUATOR_
+#define AMANZI_RELATIONS_MET_FORCING_EVALUATOR_
+
+#include "factory.hh"
+#include "independent_variable_field_evaluator.hh"
+
+#include "MetForcingCache.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+class MetForcingEvaluator : public IndependentVariableFieldEvaluator {
+
+ public:
+  // constructor format for all derived classes
+  explicit
+  MetForcingEvaluator(Teuchos::ParameterList& plist);
+  MetForcingEvaluator(const MetForcingEvaluator& other);
+
+  Teuchos::RCP<FieldEvaluator> Clone() const;
+
+ protected:
+  // Required methods from IndependentVariableFieldEvaluator
+  virtual void UpdateField_(const Teuchos::Ptr<State>& S);
+
+ protected:
+  std::string header_;
+  Teuchos::RCP<MetForcingCache> cache_;
+
+ private:
+  static Utils::RegisteredFactory<FieldEvaluator,MetForcingEvaluator> factory_;
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,19 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+/*
+  MetForcingEvaluator is an independent variable evaluator that is spatially
+  uniform in its domain and whose value comes from a met forcing time series.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "MetForcingEvaluator.hh"
+
+namespace Amanzi {
+namespace Relations {
+
+// registry of method
+Utils::RegisteredFactory<FieldEvaluator,MetForcingEvaluator> MetForcingEvaluator::factory_("independent variable from met forcing");
+
+} // namespace
+} // namespace
@@ -0,0 +1,247 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: Ethan Coon
+
+Aggregated vis output for column ensembles: all columns of a rank in one
+file, one [column, cell] dataset per field per time.
+------------------------------------------------------------------------- */
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "errors.hh"
+#include "State.hh"
+
+#include "column_visualization.hh"
+
+namespace ATS {
+
+ColumnVisualization::ColumnVisualization(Teuchos::ParameterList& plist,
+        const std::string& suffix, Epetra_MpiComm* comm) :
+    Amanzi::IOEvent(plist),
+    ncells_(-1),
+    file_(-1)
+{
+  std::stringstream filename;
+  filename << plist.get<std::string>("file name base", "visdump_columns") << suffix;
+  if (comm->NumProc() > 1) filename << "_" << comm->MyPID();
+  filename_base_ = filename.str();
+
+  compression_level_ = plist.get<int>("compression level", 0);
+  chunk_columns_ = plist.get<int>("chunk columns", 256);
+  if (compression_level_ < 0 || compression_level_ > 9 || chunk_columns_ < 1) {
+    Errors::Message message("ColumnVisualization: \"compression level\" must be in [0,9] and \"chunk columns\" positive.");
+    Exceptions::amanzi_throw(message);
+  }
+}
+
+
+ColumnVisualization::~ColumnVisualization()
+{
+  if (file_ >= 0) H5Fclose(file_);
+}
+
+
+void
+ColumnVisualization::AddColumn(const std::string& domain, int id)
+{
+  domains_.push_back(domain);
+  ids_.push_back(id);
+}
+
+
+void
+ColumnVisualization::CreateFiles(const Amanzi::State& S)
+{
+  int ncols = domains_.size();
+  if (ncols == 0) return;
+
+  ncells_ = S.GetMesh(domains_[0])->num_entities(Amanzi::AmanziMesh::CELL,
+          Amanzi::AmanziMesh::OWNED);
+  for (int i=0; i!=ncols; ++i) {
+    if (S.GetMesh(domains_[i])->num_entities(Amanzi::AmanziMesh::CELL,
+            Amanzi::AmanziMesh::OWNED) != ncells_) {
+      Errors::Message message("ColumnVisualization: all columns must have the same number of cells to be aggregated, but \""+domains_[i]+"\" differs from \""+domains_[0]+"\".");
+      Exceptions::amanzi_throw(message);
+    }
+  }
+
+  std::string filename = filename_base_ + ".h5";
+  file_ = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if (file_ < 0) {
+    Errors::Message message("ColumnVisualization: cannot create file \""+filename+"\".");
+    Exceptions::amanzi_throw(message);
+  }
+
+  // column ids
+  hsize_t dims[2] = { (hsize_t) ncols, (hsize_t) ncells_ };
+  hid_t space = H5Screate_simple(1, dims, NULL);
+  hid_t dset = H5Dcreate2(file_, "column ids", H5T_NATIVE_INT, space,
+                          H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  H5Dwrite(dset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &ids_[0]);
+  H5Dclose(dset);
+  H5Sclose(space);
+
+  // cell centroid elevations
+  std::vector<double> z(ncols * ncells_);
+  for (int i=0; i!=ncols; ++i) {
+    const Amanzi::AmanziMesh::Mesh& mesh = *S.GetMesh(domains_[i]);
+    int dim = mesh.space_dimension();
+    for (int c=0; c!=ncells_; ++c) {
+      z[i*ncells_ + c] = mesh.cell_centroid(c)[dim-1];
+    }
+  }
+  space = H5Screate_simple(2, dims, NULL);
+  dset = H5Dcreate2(file_, "z", H5T_NATIVE_DOUBLE, space,
+                    H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  H5Dwrite(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &z[0]);
+  H5Dclose(dset);
+  H5Sclose(space);
+  H5Fflush(file_, H5F_SCOPE_LOCAL);
+}
+
+
+void
+ColumnVisualization::WriteVis(const Amanzi::State& S)
+{
+  int ncols = domains_.size();
+  if (ncols == 0) return;
+
+  // the vis fields of the first column name those of all columns
+  std::string prefix = domains_[0] + "-";
+  std::vector<std::string> names;
+  for (Amanzi::State::field_iterator field=S.field_begin();
+       field!=S.field_end(); ++field) {
+    if (field->first.compare(0, prefix.size(), prefix) != 0) continue;
+    if (field->second->type() != Amanzi::COMPOSITE_VECTOR_FIELD) continue;
+    if (!field->second->io_vis()) continue;
+    Teuchos::RCP<const Amanzi::CompositeVector> vec = S.GetFieldData(field->first);
+    if (!vec->HasComponent("cell")) continue;
+    if (vec->ViewComponent("cell", false)->MyLength() != ncells_) continue;
+    names.push_back(field->first.substr(prefix.size()));
+  }
+
+  std::vector<double> data(ncols * ncells_);
+  std::vector<std::string> groups;
+  for (std::vector<std::string>::const_iterator name=names.begin();
+       name!=names.end(); ++name) {
+    int nvecs = S.GetFieldData(prefix + *name)->ViewComponent("cell", false)->NumVectors();
+    for (int j=0; j!=nvecs; ++j) {
+      for (int i=0; i!=ncols; ++i) {
+        std::string key = domains_[i] + "-" + *name;
+        if (!S.HasField(key)) {
+          Errors::Message message("ColumnVisualization: field \""+key+"\" is missing, but columns are aggregated.");
+          Exceptions::amanzi_throw(message);
+        }
+        const Epetra_MultiVector& vec = *S.GetFieldData(key)->ViewComponent("cell", false);
+        for (int c=0; c!=ncells_; ++c) data[i*ncells_ + c] = vec[j][c];
+      }
+
+      std::stringstream group;
+      group << *name << ".cell." << j;
+      std::stringstream cycle;
+      cycle << S.cycle();
+      WriteDataset_(group.str(), cycle.str(), data, ncols, ncells_, S.time());
+      groups.push_back(group.str());
+    }
+  }
+  H5Fflush(file_, H5F_SCOPE_LOCAL);
+
+  if (!cycles_.empty() && cycles_.back() == S.cycle()) {
+    times_.back() = S.time();
+    fields_.back() = groups;
+  } else {
+    cycles_.push_back(S.cycle());
+    times_.push_back(S.time());
+    fields_.push_back(groups);
+  }
+  WriteXDMF_();
+}
+
+
+void
+ColumnVisualization::WriteDataset_(const std::string& group, const std::string& name,
+        const std::vector<double>& data, int ncols, int ncells, double time)
+{
+  hid_t gid;
+  if (H5Lexists(file_, group.c_str(), H5P_DEFAULT) > 0) {
+    gid = H5Gopen2(file_, group.c_str(), H5P_DEFAULT);
+  } else {
+    gid = H5Gcreate2(file_, group.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  }
+
+  // a forced dump may repeat a cycle
+  if (H5Lexists(gid, name.c_str(), H5P_DEFAULT) > 0)
+    H5Ldelete(gid, name.c_str(), H5P_DEFAULT);
+
+  hsize_t dims[2] = { (hsize_t) ncols, (hsize_t) ncells };
+  hid_t space = H5Screate_simple(2, dims, NULL);
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  if (compression_level_ > 0) {
+    hsize_t chunk[2] = { (hsize_t) std::min(chunk_columns_, ncols), (hsize_t) ncells };
+    H5Pset_chunk(dcpl, 2, chunk);
+    H5Pset_deflate(dcpl, compression_level_);
+  }
+  hid_t dset = H5Dcreate2(gid, name.c_str(), H5T_NATIVE_DOUBLE, space,
+                          H5P_DEFAULT, dcpl, H5P_DEFAULT);
+  H5Dwrite(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data[0]);
+
+  hid_t aspace = H5Screate(H5S_SCALAR);
+  hid_t attr = H5Acreate2(dset, "Time", H5T_NATIVE_DOUBLE, aspace, H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(attr, H5T_NATIVE_DOUBLE, &time);
+  H5Aclose(attr);
+  H5Sclose(aspace);
+
+  H5Dclose(dset);
+  H5Pclose(dcpl);
+  H5Sclose(space);
+  H5Gclose(gid);
+}
+
+
+// One descriptor for all times, rewritten at each dump so that it is always
+// complete.  Columns and cells are laid out as a 2D structured grid.
+void
+ColumnVisualization::WriteXDMF_()
+{
+  int ncols = domains_.size();
+  std::string h5name = filename_base_ + ".h5";
+  std::size_t slash = h5name.find_last_of('/');
+  if (slash != std::string::npos) h5name = h5name.substr(slash+1);
+
+  std::ofstream xmf((filename_base_ + ".xmf").c_str());
+  xmf << "<?xml version=\"1.0\" ?>" << std::endl
+      << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>" << std::endl
+      << "<Xdmf Version=\"2.0\">" << std::endl
+      << "  <Domain>" << std::endl
+      << "    <Grid Name=\"columns\" GridType=\"Collection\" CollectionType=\"Temporal\">" << std::endl;
+  xmf.precision(15);
+  for (int n=0; n!=cycles_.size(); ++n) {
+    xmf << "      <Grid Name=\"" << cycles_[n] << "\" GridType=\"Uniform\">" << std::endl
+        << "        <Time Value=\"" << times_[n] << "\" />" << std::endl
+        << "        <Topology TopologyType=\"2DCoRectMesh\" Dimensions=\""
+        << ncols+1 << " " << ncells_+1 << "\" />" << std::endl
+        << "        <Geometry GeometryType=\"ORIGIN_DXDY\">" << std::endl
+        << "          <DataItem Dimensions=\"2\" Format=\"XML\">0 0</DataItem>" << std::endl
+        << "          <DataItem Dimensions=\"2\" Format=\"XML\">1 1</DataItem>" << std::endl
+        << "        </Geometry>" << std::endl;
+    for (std::vector<std::string>::const_iterator field=fields_[n].begin();
+         field!=fields_[n].end(); ++field) {
+      xmf << "        <Attribute Name=\"" << *field << "\" AttributeType=\"Scalar\" Center=\"Cell\">" << std::endl
+          << "          <DataItem Dimensions=\"" << ncols << " " << ncells_
+          << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">"
+          << h5name << ":/" << *field << "/" << cycles_[n] << "</DataItem>" << std::endl
+          << "        </Attribute>" << std::endl;
+    }
+    xmf << "      </Grid>" << std::endl;
+  }
+  xmf << "    </Grid>" << std::endl
+      << "  </Domain>" << std::endl
+      << "</Xdmf>" << std::endl;
+}
+
+} // namespace ATS
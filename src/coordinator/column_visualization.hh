@@ -0,0 +1,102 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! ColumnVisualization: aggregated vis output for column ensembles.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Columns of a column ensemble are visualized together, in one HDF5 file per
+rank rather than one file per column.  Each field is written as a 2D
+``[column, cell]`` dataset per vis time, under the group
+``FIELD.cell.VECTOR`` and named by the cycle, as in the usual
+``visdump_data.h5``.  The file also holds ``column ids``, the global id of the
+surface cell of each column, and ``z``, the cell centroid elevations.  A
+single XDMF descriptor lists all times.
+
+This is used when the `"visualization columns`" and `"visualization surface
+cells`" lists set `"aggregate columns`", in addition to the usual
+[visualization-spec] time control:
+
+* `"aggregate columns`" ``[bool]`` **true** If false, each column writes its
+  own ``visdump_column_ID`` files instead.
+
+* `"file name base`" ``[string]`` **visdump_columns** Written to BASE.h5 and
+  BASE.xmf, with ``_surface`` appended for the surface cells, and ``_RANK``
+  in parallel.
+
+* `"compression level`" ``[int]`` **0** If positive, datasets are chunked by
+  blocks of columns and gzip compressed at this level (1-9).
+
+* `"chunk columns`" ``[int]`` **256** Columns per chunk when compressing.
+
+*/
+
+#ifndef ATS_COLUMN_VISUALIZATION_HH_
+#define ATS_COLUMN_VISUALIZATION_HH_
+
+#include <string>
+#include <vector>
+
+#include "hdf5.h"
+
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "IOEvent.hh"
+
+namespace Amanzi {
+class State;
+}
+
+namespace ATS {
+
+class ColumnVisualization : public Amanzi::IOEvent {
+
+ public:
+  ColumnVisualization(Teuchos::ParameterList& plist, const std::string& suffix,
+                      Epetra_MpiComm* comm);
+  ~ColumnVisualization();
+
+  // Adds a column, by its domain name and global column id.  All columns
+  // must have the same number of cells.
+  void AddColumn(const std::string& domain, int id);
+  int num_columns() const { return domains_.size(); }
+
+  // Creates the file and writes the columns' ids and geometry.
+  void CreateFiles(const Amanzi::State& S);
+
+  // Writes all vis fields of the columns at the current time of S.
+  void WriteVis(const Amanzi::State& S);
+
+ protected:
+  void WriteDataset_(const std::string& group, const std::string& name,
+                     const std::vector<double>& data, int ncols, int ncells,
+                     double time);
+  void WriteXDMF_();
+
+ protected:
+  std::string filename_base_;
+  std::vector<std::string> domains_;
+  std::vector<int> ids_;
+  int ncells_;
+
+  int compression_level_;
+  int chunk_columns_;
+
+  hid_t file_;
+
+  // cycles, times, and fields written, for the XDMF
+  std::vector<std::vector<std::string> > fields_;
+  std::vector<int> cycles_;
+  std::vector<double> times_;
+};
+
+} // namespace ATS
+
+#endif
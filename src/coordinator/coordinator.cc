@@ -12,7 +12,10 @@ including Vis and restart/checkpoint dumps.  It contains one and only one PK
 -- most likely this PK is an MPC of some type -- to do the actual work.
 ------------------------------------------------------------------------- */
 
+#include <cstdlib>
 #include <iostream>
+#include <fstream>
+#include <map>
 #include <unistd.h>
 #include <sys/resource.h>
 #include "errors.hh"
@@ -23,12 +26,16 @@ including Vis and restart/checkpoint dumps.  It contains one and only one PK
 
 #include "TimeStepManager.hh"
 #include "Visualization.hh"
+#include "column_visualization.hh"
 #include "checkpoint.hh"
 #include "UnstructuredObservations.hh"
 #include "State.hh"
 #include "PK.hh"
 #include "TreeVector.hh"
 #include "PK_Factory.hh"
+#include "pk_bdf_default.hh"
+#include "pk_physical_bdf_default.hh"
+#include "mpc.hh"
 //#include "pk_factory_ats.hh"
 
 #include "coordinator.hh"
@@ -37,13 +44,67 @@ including Vis and restart/checkpoint dumps.  It contains one and only one PK
 
 namespace ATS {
 
+// Columns of a column ensemble all share one visualization list, differing
+// only in their file name.  If mesh_name is a column domain, this returns the
+// name of that shared list, the column's id, and the suffix of its files.
+static bool
+getColumnVisualizationList(const std::string& mesh_name, std::string& plist_name,
+                           int& id, std::string& suffix) {
+  std::string prefix;
+  if (mesh_name.compare(0, 7, "column_") == 0) {
+    plist_name = "visualization columns";
+    prefix = "column_";
+    suffix = "";
+  } else if (mesh_name.compare(0, 15, "surface_column_") == 0) {
+    plist_name = "visualization surface cells";
+    prefix = "surface_column_";
+    suffix = "_surface";
+  } else {
+    return false;
+  }
+
+  std::string id_str = mesh_name.substr(prefix.size());
+  if (id_str.empty() || id_str.find_first_not_of("0123456789") != std::string::npos)
+    return false;
+  id = std::atoi(id_str.c_str());
+  return true;
+}
+
+
+// Nonlinear iterations taken by the BDF time integrators of the PK tree under
+// pk, each as counted by the PK that owns it.
+static int
+nonlinearIterations(const Teuchos::RCP<Amanzi::PK>& pk) {
+  int count = 0;
+  Teuchos::RCP<Amanzi::PK_BDF_Default> pk_bdf =
+      Teuchos::rcp_dynamic_cast<Amanzi::PK_BDF_Default>(pk);
+  if (pk_bdf != Teuchos::null) count += pk_bdf->NonlinearIterations();
+
+  Teuchos::RCP<Amanzi::MPC<Amanzi::PK> > mpc =
+      Teuchos::rcp_dynamic_cast<Amanzi::MPC<Amanzi::PK> >(pk);
+  if (mpc != Teuchos::null) {
+    for (int i=0; i!=mpc->get_subpks().size(); ++i)
+      count += nonlinearIterations(mpc->get_subpks()[i]);
+  }
+
+  Teuchos::RCP<Amanzi::MPC<Amanzi::PK_PhysicalBDF_Default> > mpc_bdf =
+      Teuchos::rcp_dynamic_cast<Amanzi::MPC<Amanzi::PK_PhysicalBDF_Default> >(pk);
+  if (mpc_bdf != Teuchos::null) {
+    for (int i=0; i!=mpc_bdf->get_subpks().size(); ++i)
+      count += nonlinearIterations(mpc_bdf->get_subpks()[i]);
+  }
+  return count;
+}
+
+
 Coordinator::Coordinator(Teuchos::ParameterList& parameter_list,
                          Teuchos::RCP<Amanzi::State>& S,
                          Epetra_MpiComm* comm ) :
     parameter_list_(Teuchos::rcp(new Teuchos::ParameterList(parameter_list))),
     S_(S),
     comm_(comm),
-    restart_(false) {
+    restart_(false),
+    failed_cycles_(0) {
 
   // create and start the global timer
   timer_ = Teuchos::rcp(new Teuchos::Time("wallclock_monitor",true));
@@ -105,6 +166,19 @@ void Coordinator::coordinator_init() {
   observations_ = Teuchos::rcp(new Amanzi::UnstructuredObservations(observation_plist,
           Teuchos::null, comm_));
 
+  // create the memory accounting
+  if (coordinator_list_->isSublist("memory accounting")) {
+    Teuchos::ParameterList& mem_plist = coordinator_list_->sublist("memory accounting");
+    memory_event_ = Teuchos::rcp(new Amanzi::IOEvent(mem_plist));
+
+    std::stringstream filename;
+    filename << mem_plist.get<std::string>("file name base", "memory");
+    if (size > 1) filename << "_" << rank;
+    filename << ".csv";
+    memory_file_ = Teuchos::rcp(new std::ofstream(filename.str().c_str()));
+    *memory_file_ << "cycle,time [s],category,name,bytes" << std::endl;
+  }
+
   // check whether meshes are deformable, and if so require a nodal position
   for (Amanzi::State::mesh_iterator mesh=S_->mesh_begin();
        mesh!=S_->mesh_end(); ++mesh) {
@@ -225,6 +299,7 @@ void Coordinator::initialize() {
     }
   }
 
+  std::map<std::string, Teuchos::RCP<ColumnVisualization> > column_vis;
   for (Amanzi::State::mesh_iterator mesh=S_->mesh_begin();
        mesh!=S_->mesh_end(); ++mesh) {
     if (mesh->first == "surface_3d") {
@@ -246,6 +321,31 @@ void Coordinator::initialize() {
         vis->set_mesh(mesh->second.first);
         vis->CreateFiles();
         visualization_.push_back(vis);
+      } else {
+        // columns use the shared column list, and by default are written
+        // together, one file per rank
+        std::string col_plist_name, suffix;
+        int id;
+        if (getColumnVisualizationList(mesh->first, col_plist_name, id, suffix) &&
+            parameter_list_->isSublist(col_plist_name)) {
+          Teuchos::ParameterList& col_plist = parameter_list_->sublist(col_plist_name);
+          if (col_plist.get<bool>("aggregate columns", true)) {
+            Teuchos::RCP<ColumnVisualization>& col_vis = column_vis[col_plist_name];
+            if (col_vis == Teuchos::null)
+              col_vis = Teuchos::rcp(new ColumnVisualization(col_plist, suffix, comm_));
+            col_vis->AddColumn(mesh->first, id);
+          } else {
+            std::stringstream file_base;
+            file_base << "visdump_column_" << id << suffix;
+            Teuchos::ParameterList vis_plist(col_plist);
+            vis_plist.set("file name base", file_base.str());
+            Teuchos::RCP<Amanzi::Visualization> vis =
+              Teuchos::rcp(new Amanzi::Visualization(vis_plist, comm_));
+            vis->set_mesh(mesh->second.first);
+            vis->CreateFiles();
+            visualization_.push_back(vis);
+          }
+        }
       }
 
       // vis unsuccessful steps
@@ -266,6 +366,12 @@ void Coordinator::initialize() {
     }
   }
 
+  for (std::map<std::string, Teuchos::RCP<ColumnVisualization> >::iterator vis=column_vis.begin();
+       vis!=column_vis.end(); ++vis) {
+    vis->second->CreateFiles(*S_);
+    column_visualization_.push_back(vis->second);
+  }
+
   // make observations
   observations_->MakeObservations(*S_);
 
@@ -278,6 +384,10 @@ void Coordinator::initialize() {
        vis!=visualization_.end(); ++vis) {
     (*vis)->RegisterWithTimeStepManager(tsm_.ptr());
   }
+  for (std::vector<Teuchos::RCP<ColumnVisualization> >::iterator vis=column_visualization_.begin();
+       vis!=column_visualization_.end(); ++vis) {
+    (*vis)->RegisterWithTimeStepManager(tsm_.ptr());
+  }
 
   // -- register checkpoint times
   checkpoint_->RegisterWithTimeStepManager(tsm_.ptr());
@@ -337,6 +447,18 @@ double rss_usage() { // return ru_maxrss in MBytes
 }
 
 
+double rss_current() { // return the current resident set size in MBytes, 0 if unknown
+#if defined(__linux__)
+  long pages_total(0), pages_resident(0);
+  std::ifstream statm("/proc/self/statm");
+  if (statm >> pages_total >> pages_resident) {
+    return static_cast<double>(pages_resident) * sysconf(_SC_PAGESIZE)/1024.0/1024.0;
+  }
+#endif
+  return 0.0;
+}
+
+
 void Coordinator::report_memory() {
   // report the memory high water mark (using ru_maxrss)
   // this should be called at the very end of a simulation
@@ -408,6 +530,119 @@ void Coordinator::report_memory() {
 
 
 
+// -----------------------------------------------------------------------------
+// Write a machine-readable account of memory use on this process, as lines of
+// "cycle,time,category,name,bytes".
+//
+//   Nothing here is collective, so this may be called at any cycle on any
+//   rank, including ranks whose meshes and fields differ (e.g. columns).
+// -----------------------------------------------------------------------------
+void Coordinator::write_memory_accounting(std::ostream& os) {
+  const double MB = 1024.0*1024.0;
+  std::stringstream prefix;
+  prefix << std::setprecision(15) << S_next_->cycle() << "," << S_next_->time() << ",";
+
+  double accounted = 0.;
+
+  // meshes -- an estimate of geometric data (centroids, volumes, face
+  // normals, areas, and coordinates), as storage of the mesh framework itself
+  // is not visible from here
+  for (Amanzi::State::mesh_iterator mesh=S_->mesh_begin();
+       mesh!=S_->mesh_end(); ++mesh) {
+    const Amanzi::AmanziMesh::Mesh& m = *mesh->second.first;
+    int dim = m.space_dimension();
+    double ncells = m.num_entities(Amanzi::AmanziMesh::CELL, Amanzi::AmanziMesh::USED);
+    double nfaces = m.num_entities(Amanzi::AmanziMesh::FACE, Amanzi::AmanziMesh::USED);
+    double nnodes = m.num_entities(Amanzi::AmanziMesh::NODE, Amanzi::AmanziMesh::USED);
+    double bytes = sizeof(double) * (ncells*(dim+1) + nfaces*(2*dim+1) + nnodes*dim);
+    os << prefix.str() << "mesh," << mesh->first << "," << bytes << "\n";
+    accounted += bytes;
+  }
+
+  // fields, for each copy of state, and the PKs that own them
+  std::map<std::string, double> owner_bytes;
+  std::vector<std::pair<std::string, Teuchos::RCP<Amanzi::State> > > states;
+  states.push_back(std::make_pair("current", S_));
+  states.push_back(std::make_pair("intermediate", S_inter_));
+  states.push_back(std::make_pair("next", S_next_));
+  for (int i=0; i!=states.size(); ++i) {
+    if (states[i].second == Teuchos::null) continue;
+    double state_bytes = 0.;
+    for (Amanzi::State::field_iterator field=states[i].second->field_begin();
+         field!=states[i].second->field_end(); ++field) {
+      double bytes = sizeof(double)
+          * static_cast<double>(field->second->GetLocalElementCount());
+      os << prefix.str() << "field " << states[i].first << "," << field->first
+         << "," << bytes << "\n";
+      owner_bytes[field->second->owner()] += bytes;
+      state_bytes += bytes;
+    }
+    os << prefix.str() << "state," << states[i].first << "," << state_bytes << "\n";
+    accounted += state_bytes;
+  }
+
+  for (std::map<std::string, double>::const_iterator owner=owner_bytes.begin();
+       owner!=owner_bytes.end(); ++owner) {
+    os << prefix.str() << "owner," << owner->first << "," << owner->second << "\n";
+  }
+
+  // the process as a whole, and what is not accounted for above (operators,
+  // preconditioners, solvers, evaluators, parameter lists, ...)
+  double rss = rss_current() * MB;
+  os << prefix.str() << "process,rss," << rss << "\n";
+  os << prefix.str() << "process,rss high water mark," << rss_usage() * MB << "\n";
+  if (rss > 0.) {
+    os << prefix.str() << "process,unaccounted," << rss - accounted << "\n";
+  }
+  os << std::flush;
+}
+
+
+
+// -----------------------------------------------------------------------------
+// Write a JSON summary of the run's performance, for comparison across
+// builds and machines.
+//
+//   This is collective.  Nonlinear iterations are given both as a maximum over
+//   processes (the count of a single, domain-decomposed time integrator) and a
+//   sum (the total over independent integrators, e.g. one per column).
+// -----------------------------------------------------------------------------
+void Coordinator::write_benchmark_summary(const std::string& filename) {
+  double local[3], max[3], sum[3];
+  local[0] = 0.;
+  for (Amanzi::State::mesh_iterator mesh=S_->mesh_begin();
+       mesh!=S_->mesh_end(); ++mesh) {
+    local[0] += mesh->second.first->num_entities(Amanzi::AmanziMesh::CELL,
+            Amanzi::AmanziMesh::OWNED);
+  }
+  local[1] = nonlinearIterations(pk_);
+  local[2] = rss_usage();
+  comm_->SumAll(local, sum, 3);
+  comm_->MaxAll(local, max, 3);
+
+  if (comm_->MyPID() == 0) {
+    int cycles = S_->cycle() - cycle0_;
+    double cycle_time = cycle_timer_->totalElapsedTime();
+
+    std::ofstream os(filename.c_str());
+    os << std::setprecision(8);
+    os << "{" << std::endl
+       << "  \"processes\": " << comm_->NumProc() << "," << std::endl
+       << "  \"cells\": " << sum[0] << "," << std::endl
+       << "  \"cycles\": " << cycles << "," << std::endl
+       << "  \"failed cycles\": " << failed_cycles_ << "," << std::endl
+       << "  \"nonlinear iterations\": " << max[1] << "," << std::endl
+       << "  \"nonlinear iterations, all processes\": " << sum[1] << "," << std::endl
+       << "  \"setup time [s]\": " << setup_timer_->totalElapsedTime() << "," << std::endl
+       << "  \"cycle time [s]\": " << cycle_time << "," << std::endl
+       << "  \"time per cycle [s]\": " << (cycles > 0 ? cycle_time / cycles : 0.) << "," << std::endl
+       << "  \"memory high water mark, max per process [MB]\": " << max[2] << "," << std::endl
+       << "  \"memory high water mark, total [MB]\": " << sum[2] << std::endl
+       << "}" << std::endl;
+  }
+}
+
+
 void Coordinator::read_parameter_list() {
   t0_ = coordinator_list_->get<double>("start time");
   t1_ = coordinator_list_->get<double>("end time");
@@ -448,6 +683,9 @@ void Coordinator::read_parameter_list() {
     restart_filename_ = coordinator_list_->get<std::string>("restart from checkpoint file");
     // likely should ensure the file exists here? --etc
   }
+
+  // performance summary
+  benchmark_filename_ = coordinator_list_->get<std::string>("benchmark summary file", "");
 }
 
 
@@ -492,22 +730,26 @@ bool Coordinator::advance(double t_old, double t_new) {
 
   if (!fail) {
     // commit the state
-
-    if (coordinator_list_->get<bool>("subcycle", false)){}
-    else{
-        pk_->CommitStep(t_old, t_new, S_next_);
-      }
+    pk_->CommitStep(t_old, t_new, S_next_);
 
     // make observations, vis, and checkpoints
     observations_->MakeObservations(*S_next_);
     visualize();
     checkpoint(dt);
 
+    // memory accounting
+    if (memory_event_ != Teuchos::null &&
+        memory_event_->DumpRequested(S_next_->cycle(), S_next_->time())) {
+      write_memory_accounting(*memory_file_);
+    }
+
     // we're done with this time step, copy the state
     *S_ = *S_next_;
     *S_inter_ = *S_next_;
 
   } else {
+    failed_cycles_++;
+
     // Failed the timestep.  
     // Potentially write out failed timestep for debugging
     for (std::vector<Teuchos::RCP<Amanzi::Visualization> >::iterator vis=failed_visualization_.begin();
@@ -557,6 +799,12 @@ void Coordinator::visualize(bool force) {
         dump = true;
       }
     }
+    for (std::vector<Teuchos::RCP<ColumnVisualization> >::iterator vis=column_visualization_.begin();
+         vis!=column_visualization_.end(); ++vis) {
+      if ((*vis)->DumpRequested(S_next_->cycle(), S_next_->time())) {
+        dump = true;
+      }
+    }
   }
 
   if (dump) {
@@ -569,6 +817,13 @@ void Coordinator::visualize(bool force) {
       WriteVis((*vis).ptr(), S_next_.ptr());
     }
   }
+
+  for (std::vector<Teuchos::RCP<ColumnVisualization> >::iterator vis=column_visualization_.begin();
+       vis!=column_visualization_.end(); ++vis) {
+    if (force || (*vis)->DumpRequested(S_next_->cycle(), S_next_->time())) {
+      (*vis)->WriteVis(*S_next_);
+    }
+  }
 }
 
 void Coordinator::checkpoint(double dt, bool force) {
@@ -601,6 +856,10 @@ void Coordinator::cycle_driver() {
   // visualization at IC
   visualize();
   checkpoint(dt);
+  if (memory_event_ != Teuchos::null &&
+      memory_event_->DumpRequested(S_next_->cycle(), S_next_->time())) {
+    write_memory_accounting(*memory_file_);
+  }
 
 
 
@@ -667,6 +926,7 @@ void Coordinator::cycle_driver() {
   // finalizing simulation                                                                                                                                                                                                               
   S_->WriteStatistics(vo_);  
   report_memory();
+  if (!benchmark_filename_.empty()) write_benchmark_summary(benchmark_filename_);
   Teuchos::TimeMonitor::summarize(*vo_->os());
 
   finalize();
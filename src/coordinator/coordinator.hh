@@ -31,6 +31,22 @@ the simulation, including starting and ending times and restart options.
 * `"required times`" ``[time-control-spec]``
 
   A TimeControl_ spec that sets a collection of times/cycles at which the simulation is guaranteed to hit exactly.  This is useful for situations such as where data is provided at a regular interval, and interpolation error related to that data is to be minimized.
+
+* `"memory accounting`" ``[list]`` If provided, memory use is written, in
+  CSV, at the cycles/times given by its TimeControl_ spec, attributing bytes
+  to each mesh (estimated from geometry), each field of each State copy
+  (`"current`", `"intermediate`", and `"next`"), and each owning PK, along
+  with the process's current and high water mark RSS.
+
+  * `"file name base`" ``[string]`` **memory** Written to BASE.csv, or
+    BASE_RANK.csv in parallel, as meshes and fields need not be the same on
+    every rank.
+
+* `"benchmark summary file`" ``[string]`` If provided, a JSON summary of the
+  run's performance is written to this file at the end of the simulation:
+  cells, cycles, failed cycles, nonlinear iterations, setup and cycle
+  wallclock times, and the memory high water mark.  This is the format
+  collected by ``tools/benchmarks/run_benchmarks.py``.
    
 Note: Either `"end cycle`" or `"end time`" are required, and if
 both are present, the simulation will stop with whichever arrives
@@ -58,6 +74,8 @@ Example:
 #ifndef ATS_COORDINATOR_HH_
 #define ATS_COORDINATOR_HH_
 
+#include <fstream>
+
 #include "Teuchos_Time.hpp"
 #include "Teuchos_RCP.hpp"
 #include "Teuchos_ParameterList.hpp"
@@ -74,11 +92,14 @@ class TreeVector;
 class PK;
 class PK_ATS;
 class UnstructuredObservations;
+class IOEvent;
 };
 
 
 namespace ATS {
 
+class ColumnVisualization;
+
 class Coordinator {
 
 public:
@@ -92,6 +113,8 @@ public:
   void initialize();
   void finalize();
   void report_memory();
+  void write_memory_accounting(std::ostream& os);
+  void write_benchmark_summary(const std::string& filename);
   bool advance(double t_old, double t_new);
   void visualize(bool force=false);
   void checkpoint(double dt, bool force=false);
@@ -135,13 +158,22 @@ private:
   // vis and checkpointing
   std::vector<Teuchos::RCP<Amanzi::Visualization> > visualization_;
   std::vector<Teuchos::RCP<Amanzi::Visualization> > failed_visualization_;
+  std::vector<Teuchos::RCP<ColumnVisualization> > column_visualization_;
   Teuchos::RCP<Amanzi::Checkpoint> checkpoint_;
   bool restart_;
   std::string restart_filename_;
+  int failed_cycles_;
 
   // observations
   Teuchos::RCP<Amanzi::UnstructuredObservations> observations_;
 
+  // memory accounting
+  Teuchos::RCP<Amanzi::IOEvent> memory_event_;
+  Teuchos::RCP<std::ofstream> memory_file_;
+
+  // performance summary
+  std::string benchmark_filename_;
+
   // timers
   Teuchos::RCP<Teuchos::Time> setup_timer_;
   Teuchos::RCP<Teuchos::Time> cycle_timer_;
@@ -20,6 +20,7 @@
 #include "MeshSurfaceCell.hh"
 #include "GeometricModel.hh"
 
+#include "column_ensemble_mesh.hh"
 #include "ats_mesh_factory.hh"
 
 namespace ATS {
@@ -226,18 +227,70 @@ createMeshes(Teuchos::ParameterList& global_list,
     std::vector<Teuchos::RCP<Amanzi::AmanziMesh::Mesh> > col_meshes;
     std::vector<Teuchos::RCP<Amanzi::AmanziMesh::Mesh> > col_surf_meshes;
     auto surface_mesh = S.GetMesh("surface");
+    Teuchos::ParameterList& column_plist = plist.sublist("column");
+    bool deformable_columns = column_plist.get<bool>("deformable mesh", deformable);
+
+    if (column_plist.isSublist("column ensemble")) {
+      // columns built directly from the surface cells, with no 3D mesh
+      Teuchos::ParameterList& ens_plist = column_plist.sublist("column ensemble");
+      if (!S.HasMesh("surface_3d")) {
+        Errors::Message msg("\"column ensemble\" requires a \"surface\" mesh lifted from the domain mesh.");
+        Exceptions::amanzi_throw(msg);
+      }
+      if (deformable_columns) {
+        Errors::Message msg("\"column ensemble\" columns are logical meshes and cannot be deformed.");
+        Exceptions::amanzi_throw(msg);
+      }
 
-    int nc = mesh->num_columns();
-    col_meshes.resize(nc, Teuchos::null);
-    col_surf_meshes.resize(nc, Teuchos::null);
-    for (int c=0; c!=nc; ++c) {
-      col_meshes[c] = Teuchos::rcp(new Amanzi::AmanziMesh::MeshColumn(*mesh, c));
+      // columns are local, and each mesh holds on to this comm
+      Teuchos::RCP<const Epetra_MpiComm> comm_self =
+          Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_SELF));
+
+      // Column regions enumerate column-local entities, so they go in a
+      // geometric model of their own, holding the global regions as well,
+      // rather than in the domain's.
+      Teuchos::ParameterList col_reg_params = global_list.sublist("regions");
+      Teuchos::RCP<Amanzi::AmanziGeometry::GeometricModel> col_gm =
+          Teuchos::rcp(new Amanzi::AmanziGeometry::GeometricModel(3, col_reg_params, comm_self.get()));
+
+      ColumnTemplate col(ens_plist.get<Teuchos::Array<double> >("layer thicknesses").toVector());
+      addColumnRegions(col,
+                       ens_plist.get<std::string>("surface region name", "column surface"),
+                       ens_plist.get<std::string>("bottom region name", "column bottom"),
+                       *col_gm);
+      if (ens_plist.isSublist("layer regions"))
+        addColumnLayerRegions(col, ens_plist.sublist("layer regions"), *col_gm);
+
+      // The surface mesh's cells are ordered by its own extraction, so the
+      // elevation of each comes from its parent in the domain mesh: a face of
+      // a 3D mesh, or a cell of a 2D surface mesh.
+      int nc = surface_mesh->num_entities(Amanzi::AmanziMesh::CELL, Amanzi::AmanziMesh::OWNED);
+      col_meshes.resize(nc, Teuchos::null);
+      col_surf_meshes.resize(nc, Teuchos::null);
+      for (int c=0; c!=nc; ++c) {
+        double area = surface_mesh->cell_volume(c);
+        Amanzi::AmanziMesh::Entity_ID parent =
+            surface_mesh->entity_get_parent(Amanzi::AmanziMesh::CELL, c);
+        Amanzi::AmanziGeometry::Point top = mesh->manifold_dimension() == 3 ?
+            mesh->face_centroid(parent) : mesh->cell_centroid(parent);
+
+        col_meshes[c] = createColumnMesh(col, area, top, comm_self, col_gm);
+        if (plist.isSublist("column surface"))
+          col_surf_meshes[c] = createColumnSurfaceCellMesh(area, top, comm_self, col_gm);
+      }
+
+    } else {
+      int nc = mesh->num_columns();
+      col_meshes.resize(nc, Teuchos::null);
+      col_surf_meshes.resize(nc, Teuchos::null);
+      for (int c=0; c!=nc; ++c) {
+        col_meshes[c] = Teuchos::rcp(new Amanzi::AmanziMesh::MeshColumn(*mesh, c));
+      }
+      if (plist.isSublist("column surface"))
+        for (int c1=0; c1!=nc; ++c1)
+          col_surf_meshes[c1] = Teuchos::rcp(new Amanzi::AmanziMesh::MeshSurfaceCell(*col_meshes[c1], "surface"));
     }
-    if (plist.isSublist("column surface"))
-      for (int c1=0; c1!=nc; ++c1)
-        col_surf_meshes[c1] = Teuchos::rcp(new Amanzi::AmanziMesh::MeshSurfaceCell(*col_meshes[c1], "surface"));
 
-    bool deformable_columns = plist.sublist("column").get<bool>("deformable mesh", deformable);
     for (int c=0; c!=col_meshes.size(); ++c) {
       std::stringstream name_ss, name_surf;
       int id = surface_mesh->cell_map(false).GID(c);
@@ -248,31 +301,10 @@ createMeshes(Teuchos::ParameterList& global_list,
         S.RegisterMesh(name_surf.str(), col_surf_meshes[c], deformable_columns);
     }
     
-    // generalize vis for columns
-    if (global_list.isSublist("visualization columns")) {
-      Teuchos::ParameterList& vis_ss_plist = global_list.sublist("visualization columns"); 
-      for (int c=0; c!=nc; ++c){
-        int id = surface_mesh->cell_map(false).GID(c);
-        std::stringstream name_ss;
-        name_ss << "column_" << id;
-        vis_ss_plist.set("file name base", "visdump_"+name_ss.str());         
-        global_list.set("visualization " +name_ss.str(), vis_ss_plist);
-      }  
-      global_list.remove("visualization columns");
-    }
-
-    // generalize vis for surface columns
-    if (global_list.isSublist("visualization surface cells")) {
-      Teuchos::ParameterList& vis_sf_plist = global_list.sublist("visualization surface cells");
-      for (int c=0; c!=nc; ++c){
-        int id = surface_mesh->cell_map(false).GID(c);
-        std::stringstream name_ss, name_sf;
-        name_sf << "column_" << id << "_surface";
-        vis_sf_plist.set("file name base", "visdump_"+name_sf.str());
-        global_list.set("visualization " +name_sf.str(), vis_sf_plist);
-      }
-      global_list.remove("visualization surface cells");
-    }
+    // Note that vis for columns is not generalized here: one sublist per
+    // column makes the global list, and every copy of it, grow with the number
+    // of columns.  The coordinator instead uses the single "visualization
+    // columns" and "visualization surface cells" lists for all columns.
   }
 
 
@@ -136,6 +136,21 @@ ColumnMeshes
 
 ** Document me! **
 
+By default, columns are sliced from the base mesh, which must then be an
+extruded 3D mesh.  A column ensemble may instead be built without the 3D mesh,
+from a 2D base mesh and a layering given in a `"column ensemble`" sublist of
+the column list; see ColumnEnsembleMesh.
+
+Visualization of columns is controlled by two lists in the top level
+parameter list, each shared by all columns.  By default all columns of a rank
+are written together as 2D ``[column, cell]`` datasets to
+``visdump_columns.h5`` and ``visdump_columns_surface.h5`` (see
+ColumnVisualization); with `"aggregate columns`" false, each column instead
+writes its own files, ``visdump_column_ID`` and ``visdump_column_ID_surface``:
+
+* `"visualization columns`" ``[visualization-spec]`` Vis for each column mesh.
+* `"visualization surface cells`" ``[visualization-spec]`` Vis for each column's surface cell mesh.
+
 Example:
 
 .. code-block:: xml
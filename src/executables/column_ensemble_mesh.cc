@@ -0,0 +1,208 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+/* -------------------------------------------------------------------------
+ATS
+
+License: see $ATS_DIR/COPYRIGHT
+Author: Ethan Coon
+
+Column meshes of a column ensemble, built from the surface mesh and a
+layering rather than sliced from a 3D mesh.
+------------------------------------------------------------------------- */
+
+#include "errors.hh"
+#include "RegionEnumerated.hh"
+
+#include "column_ensemble_mesh.hh"
+
+namespace ATS {
+
+ColumnTemplate::ColumnTemplate(const std::vector<double>& dz_) :
+    ncells(dz_.size()),
+    dz(dz_),
+    depth(dz_.size()),
+    face_cell_list(dz_.size()+1),
+    face_cell_lengths(dz_.size()+1),
+    face_normal_z(dz_.size()+1, -1.)
+{
+  if (ncells == 0) {
+    Errors::Message message("Column ensemble: \"layer thicknesses\" is empty.");
+    Exceptions::amanzi_throw(message);
+  }
+
+  double z = 0.;
+  for (int c=0; c!=ncells; ++c) {
+    if (dz[c] <= 0.) {
+      Errors::Message message("Column ensemble: \"layer thicknesses\" must be positive.");
+      Exceptions::amanzi_throw(message);
+    }
+    depth[c] = z + dz[c]/2.;
+    z += dz[c];
+  }
+
+  // the top face points up, out of cell 0; all others point down, from the
+  // cell above to the one below
+  face_cell_list[0].push_back(0);
+  face_cell_lengths[0].push_back(dz[0]/2.);
+  face_normal_z[0] = 1.;
+  for (int f=1; f!=ncells; ++f) {
+    face_cell_list[f].push_back(f-1);
+    face_cell_list[f].push_back(f);
+    face_cell_lengths[f].push_back(dz[f-1]/2.);
+    face_cell_lengths[f].push_back(dz[f]/2.);
+  }
+  face_cell_list[ncells].push_back(ncells-1);
+  face_cell_lengths[ncells].push_back(dz[ncells-1]/2.);
+}
+
+
+ColumnSurfaceCellMesh::ColumnSurfaceCellMesh(const Epetra_MpiComm* comm,
+        const std::vector<double>& cell_volumes,
+        const std::vector<Amanzi::AmanziGeometry::Point>& cell_centroids) :
+    Amanzi::AmanziMesh::MeshLogical(comm, cell_volumes,
+            std::vector<std::vector<int> >(),
+            std::vector<std::vector<double> >(),
+            std::vector<Amanzi::AmanziGeometry::Point>(),
+            &cell_centroids)
+{
+  ASSERT(cell_volumes.size() == 1);
+}
+
+
+Amanzi::AmanziMesh::Entity_ID
+ColumnSurfaceCellMesh::entity_get_parent(const Amanzi::AmanziMesh::Entity_kind kind,
+        const Amanzi::AmanziMesh::Entity_ID entid) const
+{
+  ASSERT(kind == Amanzi::AmanziMesh::CELL);
+  ASSERT(entid == 0);
+  return 0;
+}
+
+
+Teuchos::RCP<Amanzi::AmanziMesh::Mesh>
+createColumnMesh(const ColumnTemplate& col, double area,
+                 const Amanzi::AmanziGeometry::Point& top,
+                 const Teuchos::RCP<const Epetra_MpiComm>& comm,
+                 const Teuchos::RCP<const Amanzi::AmanziGeometry::GeometricModel>& gm)
+{
+  std::vector<double> cell_volumes(col.ncells);
+  std::vector<Amanzi::AmanziGeometry::Point> cell_centroids(col.ncells, top);
+  for (int c=0; c!=col.ncells; ++c) {
+    cell_volumes[c] = area * col.dz[c];
+    cell_centroids[c][2] -= col.depth[c];
+  }
+
+  std::vector<Amanzi::AmanziGeometry::Point> face_area_normals(col.ncells+1,
+          Amanzi::AmanziGeometry::Point(0., 0., 0.));
+  for (int f=0; f!=col.ncells+1; ++f)
+    face_area_normals[f][2] = area * col.face_normal_z[f];
+
+  Teuchos::RCP<Amanzi::AmanziMesh::Mesh> mesh =
+      Teuchos::rcp(new Amanzi::AmanziMesh::MeshLogical(comm.get(), cell_volumes,
+              col.face_cell_list, col.face_cell_lengths, face_area_normals,
+              &cell_centroids));
+  mesh->set_geometric_model(gm);
+
+  // the mesh only keeps a raw pointer to its comm
+  Teuchos::set_extra_data(comm, "comm", Teuchos::inOutArg(mesh), Teuchos::POST_DESTROY);
+  return mesh;
+}
+
+
+Teuchos::RCP<Amanzi::AmanziMesh::Mesh>
+createColumnSurfaceCellMesh(double area,
+        const Amanzi::AmanziGeometry::Point& top,
+        const Teuchos::RCP<const Epetra_MpiComm>& comm,
+        const Teuchos::RCP<const Amanzi::AmanziGeometry::GeometricModel>& gm)
+{
+  std::vector<double> cell_volumes(1, area);
+  std::vector<Amanzi::AmanziGeometry::Point> cell_centroids(1, top);
+  Teuchos::RCP<Amanzi::AmanziMesh::Mesh> mesh =
+      Teuchos::rcp(new ColumnSurfaceCellMesh(comm.get(), cell_volumes, cell_centroids));
+  mesh->set_geometric_model(gm);
+  Teuchos::set_extra_data(comm, "comm", Teuchos::inOutArg(mesh), Teuchos::POST_DESTROY);
+  return mesh;
+}
+
+
+void
+addColumnRegions(const ColumnTemplate& col,
+                 const std::string& surface_region,
+                 const std::string& bottom_region,
+                 Amanzi::AmanziGeometry::GeometricModel& gm)
+{
+  if (gm.FindRegion(surface_region) == Teuchos::null) {
+    gm.AddRegion(Teuchos::rcp(new Amanzi::AmanziGeometry::RegionEnumerated(
+        surface_region, gm.RegionSize()+1, "FACE",
+        std::vector<Amanzi::AmanziMesh::Entity_ID>(1, 0))));
+  }
+  if (gm.FindRegion(bottom_region) == Teuchos::null) {
+    gm.AddRegion(Teuchos::rcp(new Amanzi::AmanziGeometry::RegionEnumerated(
+        bottom_region, gm.RegionSize()+1, "FACE",
+        std::vector<Amanzi::AmanziMesh::Entity_ID>(1, col.ncells))));
+  }
+}
+
+
+std::vector<Amanzi::AmanziMesh::Entity_ID>
+columnLayerRegionCells(const ColumnTemplate& col, const std::string& name,
+                       Teuchos::ParameterList& region_plist)
+{
+  std::vector<Amanzi::AmanziMesh::Entity_ID> cells;
+  if (region_plist.isParameter("layers")) {
+    Teuchos::Array<int> layers = region_plist.get<Teuchos::Array<int> >("layers");
+    for (int i=0; i!=layers.size(); ++i) {
+      if (layers[i] < 0 || layers[i] >= col.ncells) {
+        Errors::Message message;
+        message << "Column ensemble: layer region \"" << name << "\" has layer "
+                << layers[i] << ", but columns have " << col.ncells << " layers.";
+        Exceptions::amanzi_throw(message);
+      }
+      cells.push_back(layers[i]);
+    }
+  } else if (region_plist.isParameter("depth range")) {
+    Teuchos::Array<double> range = region_plist.get<Teuchos::Array<double> >("depth range");
+    if (range.size() != 2 || range[0] > range[1]) {
+      Errors::Message message;
+      message << "Column ensemble: layer region \"" << name
+              << "\" \"depth range\" must be [top, bottom], top above bottom.";
+      Exceptions::amanzi_throw(message);
+    }
+    for (int c=0; c!=col.ncells; ++c)
+      if (col.depth[c] >= range[0] && col.depth[c] < range[1]) cells.push_back(c);
+  } else {
+    Errors::Message message;
+    message << "Column ensemble: layer region \"" << name
+            << "\" requires either \"layers\" or \"depth range\".";
+    Exceptions::amanzi_throw(message);
+  }
+  return cells;
+}
+
+
+void
+addColumnLayerRegions(const ColumnTemplate& col,
+                      Teuchos::ParameterList& plist,
+                      Amanzi::AmanziGeometry::GeometricModel& gm)
+{
+  for (Teuchos::ParameterList::ConstIterator it=plist.begin();
+       it!=plist.end(); ++it) {
+    std::string name = plist.name(it);
+    if (!plist.isSublist(name)) {
+      Errors::Message message;
+      message << "Column ensemble: \"layer regions\" entry \"" << name << "\" is not a list.";
+      Exceptions::amanzi_throw(message);
+    }
+    std::vector<Amanzi::AmanziMesh::Entity_ID> cells =
+        columnLayerRegionCells(col, name, plist.sublist(name));
+
+    if (gm.FindRegion(name) != Teuchos::null) {
+      Errors::Message message;
+      message << "Column ensemble: layer region \"" << name << "\" already exists.";
+      Exceptions::amanzi_throw(message);
+    }
+    gm.AddRegion(Teuchos::rcp(new Amanzi::AmanziGeometry::RegionEnumerated(
+        name, gm.RegionSize()+1, "CELL", cells)));
+  }
+}
+
+} // namespace ATS
@@ -0,0 +1,144 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Column meshes of a column ensemble, built without a 3D parent mesh.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Column ensembles (e.g. for WeakMPCSemiCoupled) only need the columns, not the
+3D mesh they are sliced from.  Given a `"column ensemble`" sublist, each
+column is instead built directly from a cell of the surface mesh as a 1D
+logical mesh: its cells are the layers, scaled by the projected area of the
+surface cell and hung from the elevation of its centroid.  The 1D geometry of
+the layering is computed once and used to build all columns.
+
+The domain mesh is then the 2D surface mesh itself, read or generated as
+usual, and a `"surface`" mesh must be lifted from it.
+
+* `"layer thicknesses`" ``[Array(double)]`` Thickness of each layer, top
+  down [m].
+
+The columns have a geometric model of their own, with the regions of the
+`"regions`" list plus the column regions below, which are local to the
+columns and so are not regions of the domain.
+
+* `"surface region name`" ``[string]`` **column surface** Name of an
+  enumerated region, created if it does not exist, holding the top face of
+  each column.
+
+* `"bottom region name`" ``[string]`` **column bottom** Name of an enumerated
+  region, created if it does not exist, holding the bottom face of each
+  column.
+
+* `"layer regions`" ``[list]`` **optional** Enumerated cell regions of the
+  columns, e.g. for soil types or initial conditions by horizon, in place of
+  the 3D regions a column sliced from a 3D mesh would have.  Each sublist,
+  named for its region, gives one of:
+
+  * `"layers`" ``[Array(int)]`` Indices of the layers in the region, from 0
+    at the top.
+
+  * `"depth range`" ``[Array(double)]`` ``[top, bottom]`` depths [m]; the
+    layers whose centroid depth is in ``[top, bottom)`` are in the region.
+
+Logical meshes have no nodes, so column meshes built this way cannot be
+deformed, and evaluators that need node coordinates (e.g. the meshed
+elevation evaluator) must be replaced by their standalone versions on the
+columns and their surface cells.
+
+*/
+
+#ifndef ATS_COLUMN_ENSEMBLE_MESH_HH_
+#define ATS_COLUMN_ENSEMBLE_MESH_HH_
+
+#include <string>
+#include <vector>
+
+#include "Teuchos_RCP.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Epetra_MpiComm.h"
+
+#include "Point.hh"
+#include "GeometricModel.hh"
+#include "MeshLogical.hh"
+
+namespace ATS {
+
+// The 1D geometry of a column, per unit area, from which columns of that
+// layering are built.  Cell 0 is the top layer; face 0 is the top face and
+// face ncells the bottom face.
+struct ColumnTemplate {
+  explicit ColumnTemplate(const std::vector<double>& dz);
+
+  int ncells;
+  std::vector<double> dz;
+  std::vector<double> depth;    // cell centroid depth below the surface
+  std::vector<std::vector<int> > face_cell_list;
+  std::vector<std::vector<double> > face_cell_lengths;
+  std::vector<double> face_normal_z;    // from the first cell of the face
+};
+
+
+// The surface cell of a column, whose parent is the top face of the column.
+class ColumnSurfaceCellMesh : public Amanzi::AmanziMesh::MeshLogical {
+ public:
+  ColumnSurfaceCellMesh(const Epetra_MpiComm* comm,
+                        const std::vector<double>& cell_volumes,
+                        const std::vector<Amanzi::AmanziGeometry::Point>& cell_centroids);
+
+  virtual Amanzi::AmanziMesh::Entity_ID
+  entity_get_parent(const Amanzi::AmanziMesh::Entity_kind kind,
+                    const Amanzi::AmanziMesh::Entity_ID entid) const;
+};
+
+
+// Creates the column of the given projected area whose top face centroid is
+// top.  The mesh keeps comm alive.
+Teuchos::RCP<Amanzi::AmanziMesh::Mesh>
+createColumnMesh(const ColumnTemplate& col, double area,
+                 const Amanzi::AmanziGeometry::Point& top,
+                 const Teuchos::RCP<const Epetra_MpiComm>& comm,
+                 const Teuchos::RCP<const Amanzi::AmanziGeometry::GeometricModel>& gm);
+
+
+// Creates the surface cell of the column of the given projected area whose
+// top face centroid is top.
+Teuchos::RCP<Amanzi::AmanziMesh::Mesh>
+createColumnSurfaceCellMesh(double area,
+        const Amanzi::AmanziGeometry::Point& top,
+        const Teuchos::RCP<const Epetra_MpiComm>& comm,
+        const Teuchos::RCP<const Amanzi::AmanziGeometry::GeometricModel>& gm);
+
+
+// Adds the enumerated regions of the top and bottom faces of the columns to
+// gm, if they do not exist.
+void
+addColumnRegions(const ColumnTemplate& col,
+                 const std::string& surface_region,
+                 const std::string& bottom_region,
+                 Amanzi::AmanziGeometry::GeometricModel& gm);
+
+
+// The cells, in columns of layering col, of the layer region name given by
+// region_plist, one sublist of a "layer regions" list.
+std::vector<Amanzi::AmanziMesh::Entity_ID>
+columnLayerRegionCells(const ColumnTemplate& col, const std::string& name,
+                       Teuchos::ParameterList& region_plist);
+
+
+// Adds the enumerated cell regions of a "layer regions" list, for columns of
+// layering col, to gm.  Throws if a region already exists.
+void
+addColumnLayerRegions(const ColumnTemplate& col,
+                      Teuchos::ParameterList& plist,
+                      Amanzi::AmanziGeometry::GeometricModel& gm);
+
+} // namespace ATS
+
+#endif
@@ -0,0 +1,164 @@
+/*
+  Tests of the column ensemble meshes: the layering of a column template,
+  the cells of its layer regions, and the columns built from it.
+*/
+
+#include <string>
+#include <vector>
+
+#include "UnitTest++.h"
+
+#include "Epetra_MpiComm.h"
+#include "Teuchos_Array.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_RCP.hpp"
+
+#include "errors.hh"
+#include "GeometricModel.hh"
+
+#include "column_ensemble_mesh.hh"
+
+using namespace ATS;
+
+// three layers, of 0.1, 0.3 and 0.6 m, with centroids at 0.05, 0.25 and 0.7 m
+std::vector<double> Layers() {
+  std::vector<double> dz;
+  dz.push_back(0.1);
+  dz.push_back(0.3);
+  dz.push_back(0.6);
+  return dz;
+}
+
+SUITE(COLUMN_ENSEMBLE_MESH) {
+
+TEST(TEMPLATE_GEOMETRY) {
+  ColumnTemplate col(Layers());
+  CHECK_EQUAL(3, col.ncells);
+  CHECK_CLOSE(0.05, col.depth[0], 1.e-12);
+  CHECK_CLOSE(0.25, col.depth[1], 1.e-12);
+  CHECK_CLOSE(0.7, col.depth[2], 1.e-12);
+
+  // the top and bottom faces are boundary faces, the others join the cells
+  // above and below them
+  CHECK_EQUAL(4, (int) col.face_cell_list.size());
+  CHECK_EQUAL(1, (int) col.face_cell_list[0].size());
+  CHECK_EQUAL(0, col.face_cell_list[0][0]);
+  CHECK_EQUAL(2, (int) col.face_cell_list[2].size());
+  CHECK_EQUAL(1, col.face_cell_list[2][0]);
+  CHECK_EQUAL(2, col.face_cell_list[2][1]);
+  CHECK_EQUAL(1, (int) col.face_cell_list[3].size());
+  CHECK_EQUAL(2, col.face_cell_list[3][0]);
+
+  CHECK_CLOSE(0.05, col.face_cell_lengths[0][0], 1.e-12);
+  CHECK_CLOSE(0.15, col.face_cell_lengths[2][0], 1.e-12);
+  CHECK_CLOSE(0.3, col.face_cell_lengths[2][1], 1.e-12);
+  CHECK_CLOSE(0.3, col.face_cell_lengths[3][0], 1.e-12);
+
+  // the top face points up, out of the column, and the others down
+  CHECK_EQUAL(1., col.face_normal_z[0]);
+  CHECK_EQUAL(-1., col.face_normal_z[1]);
+  CHECK_EQUAL(-1., col.face_normal_z[3]);
+}
+
+TEST(TEMPLATE_BAD_LAYERS) {
+  CHECK_THROW(ColumnTemplate col((std::vector<double>())), Errors::Message);
+
+  std::vector<double> dz = Layers();
+  dz[1] = 0.;
+  CHECK_THROW(ColumnTemplate col(dz), Errors::Message);
+}
+
+TEST(LAYER_REGION_LAYERS) {
+  ColumnTemplate col(Layers());
+  Teuchos::ParameterList region_plist;
+  Teuchos::Array<int> layers(2);
+  layers[0] = 0; layers[1] = 2;
+  region_plist.set("layers", layers);
+
+  std::vector<Amanzi::AmanziMesh::Entity_ID> cells = columnLayerRegionCells(col, "ends", region_plist);
+  CHECK_EQUAL(2, (int) cells.size());
+  CHECK_EQUAL(0, cells[0]);
+  CHECK_EQUAL(2, cells[1]);
+
+  layers[1] = 3;
+  region_plist.set("layers", layers);
+  CHECK_THROW(columnLayerRegionCells(col, "ends", region_plist), Errors::Message);
+}
+
+TEST(LAYER_REGION_DEPTH_RANGE) {
+  ColumnTemplate col(Layers());
+  Teuchos::ParameterList region_plist;
+  Teuchos::Array<double> range(2);
+
+  // by centroid, in [top, bottom)
+  range[0] = 0.05; range[1] = 0.7;
+  region_plist.set("depth range", range);
+  std::vector<Amanzi::AmanziMesh::Entity_ID> cells = columnLayerRegionCells(col, "upper", region_plist);
+  CHECK_EQUAL(2, (int) cells.size());
+  CHECK_EQUAL(0, cells[0]);
+  CHECK_EQUAL(1, cells[1]);
+
+  range[0] = 0.2; range[1] = 10.;
+  region_plist.set("depth range", range);
+  cells = columnLayerRegionCells(col, "lower", region_plist);
+  CHECK_EQUAL(2, (int) cells.size());
+  CHECK_EQUAL(1, cells[0]);
+  CHECK_EQUAL(2, cells[1]);
+
+  // between centroids
+  range[0] = 0.3; range[1] = 0.6;
+  region_plist.set("depth range", range);
+  cells = columnLayerRegionCells(col, "none", region_plist);
+  CHECK_EQUAL(0, (int) cells.size());
+
+  // upside down
+  range[0] = 0.6; range[1] = 0.3;
+  region_plist.set("depth range", range);
+  CHECK_THROW(columnLayerRegionCells(col, "bad", region_plist), Errors::Message);
+}
+
+TEST(LAYER_REGION_MISSING) {
+  ColumnTemplate col(Layers());
+  Teuchos::ParameterList region_plist;
+  CHECK_THROW(columnLayerRegionCells(col, "bad", region_plist), Errors::Message);
+}
+
+TEST(COLUMN_MESH) {
+  Teuchos::RCP<const Epetra_MpiComm> comm =
+      Teuchos::rcp(new Epetra_MpiComm(MPI_COMM_SELF));
+  Teuchos::ParameterList region_list;
+  Teuchos::RCP<Amanzi::AmanziGeometry::GeometricModel> gm =
+      Teuchos::rcp(new Amanzi::AmanziGeometry::GeometricModel(3, region_list, comm.get()));
+
+  ColumnTemplate col(Layers());
+  addColumnRegions(col, "column surface", "column bottom", *gm);
+
+  Teuchos::ParameterList layer_regions;
+  Teuchos::Array<double> range(2);
+  range[0] = 0.; range[1] = 0.5;
+  layer_regions.sublist("upper soil").set("depth range", range);
+  addColumnLayerRegions(col, layer_regions, *gm);
+  CHECK_THROW(addColumnLayerRegions(col, layer_regions, *gm), Errors::Message);
+
+  Amanzi::AmanziGeometry::Point top(1., 2., 10.);
+  Teuchos::RCP<Amanzi::AmanziMesh::Mesh> mesh = createColumnMesh(col, 2., top, comm, gm);
+  comm = Teuchos::null;  // the mesh keeps its comm
+
+  CHECK_EQUAL(3, mesh->num_entities(Amanzi::AmanziMesh::CELL, Amanzi::AmanziMesh::OWNED));
+  CHECK_CLOSE(0.2, mesh->cell_volume(0), 1.e-12);
+  CHECK_CLOSE(1.2, mesh->cell_volume(2), 1.e-12);
+  CHECK_CLOSE(1., mesh->cell_centroid(1)[0], 1.e-12);
+  CHECK_CLOSE(2., mesh->cell_centroid(1)[1], 1.e-12);
+  CHECK_CLOSE(9.75, mesh->cell_centroid(1)[2], 1.e-12);
+
+  Amanzi::AmanziMesh::Entity_ID_List cells;
+  mesh->get_set_entities("upper soil", Amanzi::AmanziMesh::CELL, Amanzi::AmanziMesh::OWNED, &cells);
+  CHECK_EQUAL(2, (int) cells.size());
+
+  Amanzi::AmanziMesh::Entity_ID_List faces;
+  mesh->get_set_entities("column bottom", Amanzi::AmanziMesh::FACE, Amanzi::AmanziMesh::OWNED, &faces);
+  CHECK_EQUAL(1, (int) faces.size());
+  CHECK_EQUAL(3, faces[0]);
+}
+
+}
@@ -550,9 +550,9 @@ void MatrixMFD_TPFA::AnalyticJacobian(const Upwinding& upwinding,
   int ierr = 0;
 
   // Get the derivatives
-  std::vector<Teuchos::RCP<Teuchos::SerialDenseMatrix<int, double> > > Jpp_faces;
+  std::vector<double> Jpp_faces;
   upwinding.UpdateDerivatives(S, potential_key, dconductivity, bc_markers, bc_values, &Jpp_faces);
-  ASSERT(Jpp_faces.size() == nfaces_owned);
+  ASSERT(Jpp_faces.size() == 4*nfaces_owned);
 
   // Assemble into App
   for (unsigned int f=0; f!=nfaces_owned; ++f) {
@@ -562,7 +562,7 @@ void MatrixMFD_TPFA::AnalyticJacobian(const Upwinding& upwinding,
     for (int n=0; n!=mcells; ++n) {
       cells_GID[n] = cmap_wghost.GID(cells[n]);
     }
-    ierr = (*App_).SumIntoGlobalValues(mcells, cells_GID, Jpp_faces[f]->values());
+    ierr = (*App_).SumIntoGlobalValues(mcells, cells_GID, &Jpp_faces[4*f]);
     ASSERT(!ierr);
   }
 
@@ -257,6 +257,7 @@ void Matrix_TPFA::SymbolicAssembleGlobalMatrices() {
 
   Spp_ = Teuchos::rcp(new Epetra_FECrsMatrix(Copy, pp_graph));
   Spp_->GlobalAssemble();
+  jac_entries_.clear();
 
   Aff_ = Teuchos::rcp(new Epetra_FECrsMatrix(Copy, *fbfb_graph));
   Aff_->GlobalAssemble();
@@ -733,7 +734,6 @@ void Matrix_TPFA::AnalyticJacobian(const Upwinding& upwinding,
   //AssertAssembledOperator_or_die_();
 
   // maps and counts
-  AmanziMesh::Entity_ID_List faces;
   int ncells_owned = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
   int nfaces_owned = mesh_->num_entities(AmanziMesh::FACE, AmanziMesh::OWNED);
   const Epetra_Map& cmap_wghost = mesh_->cell_map(true);
@@ -741,23 +741,40 @@ void Matrix_TPFA::AnalyticJacobian(const Upwinding& upwinding,
   // local work arrays
   AmanziMesh::Entity_ID_List cells;
   int cells_GID[2];
+  double row[2];
   int ierr = 0;
 
-  // Get the derivatives
-  std::vector<Teuchos::RCP<Teuchos::SerialDenseMatrix<int, double> > > Jpp_faces;
-  upwinding.UpdateDerivatives(S, potential_key, dconductivity, bc_markers, bc_values, &Jpp_faces);
-  ASSERT(Jpp_faces.size() == nfaces_owned);
+  // Get the derivatives, into a buffer kept across calls
+  upwinding.UpdateDerivatives(S, potential_key, dconductivity, bc_markers, bc_values, &Jpp_faces_);
+  ASSERT(Jpp_faces_.size() == 4*nfaces_owned);
+
+  if (jac_entries_.size() != 4*nfaces_owned) InitializeJacobianEntries_();
 
-  // Assemble into Spp
+  // Assemble into Spp, adding directly into the entries of local rows
   for (unsigned int f=0; f!=nfaces_owned; ++f) {
-    mesh_->face_get_cells(f, AmanziMesh::USED, &cells);
+    const double* Jpp = &Jpp_faces_[4*f];
+    double* const * entries = &jac_entries_[4*f];
+    for (int k=0; k!=4; ++k) {
+      if (entries[k] != NULL) *entries[k] += Jpp[k];
+    }
+  }
+
+  // -- rows of ghost cells go through the FE matrix's nonlocal assembly
+  for (std::vector<int>::const_iterator f=jac_offproc_faces_.begin();
+       f!=jac_offproc_faces_.end(); ++f) {
+    mesh_->face_get_cells(*f, AmanziMesh::USED, &cells);
+    const double* Jpp = &Jpp_faces_[4*(*f)];
 
     int mcells = cells.size();
     for (int n=0; n!=mcells; ++n) {
       cells_GID[n] = cmap_wghost.GID(cells[n]);
     }
-    ierr = (*Spp_).SumIntoGlobalValues(mcells, cells_GID, Jpp_faces[f]->values());
-    ASSERT(!ierr);
+    for (int n=0; n!=mcells; ++n) {
+      if (cells[n] < ncells_owned) continue;
+      for (int m=0; m!=mcells; ++m) row[m] = Jpp[n + 2*m];
+      ierr = Spp_->SumIntoGlobalValues(cells_GID[n], mcells, row, cells_GID);
+      ASSERT(!ierr);
+    }
   }
 
   // finish assembly
@@ -765,6 +782,54 @@ void Matrix_TPFA::AnalyticJacobian(const Upwinding& upwinding,
   ASSERT(!ierr);
 }
 
+
+/* ******************************************************************
+ * Map each owned face's 2x2 Jacobian block, column-major, to the entries
+ * of Spp it is added into.  Entries in rows of ghost cells are left NULL
+ * and their faces listed in jac_offproc_faces_.  Spp has a static graph,
+ * so these stay valid until it is recreated.
+ ****************************************************************** */
+void Matrix_TPFA::InitializeJacobianEntries_()
+{
+  int ncells_owned = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
+  int nfaces_owned = mesh_->num_entities(AmanziMesh::FACE, AmanziMesh::OWNED);
+  const Epetra_Map& cmap_wghost = mesh_->cell_map(true);
+  const Epetra_Map& colmap = Spp_->ColMap();
+
+  jac_entries_.assign(4*nfaces_owned, NULL);
+  jac_offproc_faces_.clear();
+
+  AmanziMesh::Entity_ID_List cells;
+  for (unsigned int f=0; f!=nfaces_owned; ++f) {
+    mesh_->face_get_cells(f, AmanziMesh::USED, &cells);
+    int mcells = cells.size();
+
+    for (int n=0; n!=mcells; ++n) {
+      if (cells[n] >= ncells_owned) {
+        jac_offproc_faces_.push_back(f);
+        continue;
+      }
+
+      int nentries;
+      double* values;
+      int* indices;
+      int ierr = Spp_->ExtractMyRowView(cells[n], nentries, values, indices);
+      ASSERT(!ierr);
+
+      for (int m=0; m!=mcells; ++m) {
+        int lcol = colmap.LID(cmap_wghost.GID(cells[m]));
+        for (int k=0; k!=nentries; ++k) {
+          if (indices[k] == lcol) {
+            jac_entries_[4*f + n + 2*m] = &values[k];
+            break;
+          }
+        }
+        ASSERT(jac_entries_[4*f + n + 2*m] != NULL);
+      }
+    }
+  }
+}
+
 /* ******************************************************************
  * Compute transmissibilities on faces
  ****************************************************************** */
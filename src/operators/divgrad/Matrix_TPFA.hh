@@ -63,6 +63,7 @@ class Matrix_TPFA :  public MatrixMFD {
 
 
   void ComputeTransmissibilities_(const Teuchos::Ptr<std::vector<WhetStone::Tensor> >& K);
+  void InitializeJacobianEntries_();
   Teuchos::RCP<Epetra_Vector>  gravity_terms() {return gravity_term_;}
 
 
@@ -110,6 +111,12 @@ class Matrix_TPFA :  public MatrixMFD {
   Teuchos::RCP<Epetra_Vector> gravity_term_;
   std::vector<int> face_flag_;  
 
+  // analytic Jacobian work space: per-face derivatives from the upwinding,
+  // the entries of Spp each is added into, and faces with off-process rows
+  std::vector<double> Jpp_faces_;
+  std::vector<double*> jac_entries_;
+  std::vector<int> jac_offproc_faces_;
+
  private:
   Matrix_TPFA(const MatrixMFD& other);
   void operator=(const Matrix_TPFA& matrix);
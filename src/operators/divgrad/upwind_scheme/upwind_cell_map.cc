@@ -0,0 +1,93 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+// Author: Ethan Coon (ecoon@lanl.gov)
+//
+// Upwind and downwind cells of each local face, given a flux.
+// -----------------------------------------------------------------------------
+
+#include "upwind_cell_map.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+void
+UpwindCellMap::Update(const AmanziMesh::Mesh& mesh, const Epetra_MultiVector& flux) {
+  int nfaces = flux.MyLength();
+  if (nfaces != nfaces_ ||
+      mesh.num_entities(AmanziMesh::CELL, AmanziMesh::USED) != ncells_) {
+    Initialize_(mesh, nfaces);
+  }
+
+  for (int f=0; f!=nfaces_; ++f) {
+    double flux_f = flux[0][f];
+    int sign = flux_f > 0. ? 1 : (flux_f < 0. ? -1 : 0);
+    if (sign != flux_sign_[f]) {
+      UpdateFace_(f, flux_f);
+      flux_sign_[f] = sign;
+    }
+  }
+}
+
+
+void
+UpwindCellMap::Initialize_(const AmanziMesh::Mesh& mesh, int nfaces) {
+  nfaces_ = nfaces;
+  ncells_ = mesh.num_entities(AmanziMesh::CELL, AmanziMesh::USED);
+
+  face_cells_.assign(2*nfaces_, -1);
+  face_dirs_.assign(2*nfaces_, 0);
+  flux_sign_.assign(nfaces_, 2);
+  upwind_.assign(nfaces_, -1);
+  downwind_.assign(nfaces_, -1);
+
+  // Loop over cells, not faces, to get the direction of each face relative
+  // to each of its cells.
+  AmanziMesh::Entity_ID_List faces;
+  std::vector<int> fdirs;
+  for (int c=0; c!=ncells_; ++c) {
+    mesh.cell_get_faces_and_dirs(c, &faces, &fdirs);
+
+    for (unsigned int n=0; n!=faces.size(); ++n) {
+      int f = faces[n];
+      if (f < nfaces_) {
+        int i = face_cells_[2*f] == -1 ? 0 : 1;
+        face_cells_[2*f+i] = c;
+        face_dirs_[2*f+i] = fdirs[n];
+      }
+    }
+  }
+}
+
+
+void
+UpwindCellMap::UpdateFace_(int f, double flux) {
+  int uw = -1;
+  int dw = -1;
+  for (int i=0; i!=2; ++i) {
+    int c = face_cells_[2*f+i];
+    if (c == -1) continue;
+
+    if (flux * face_dirs_[2*f+i] > 0) {
+      uw = c;
+    } else if (flux * face_dirs_[2*f+i] < 0) {
+      dw = c;
+    } else {
+      // We don't care, but we have to get one into upwind and the other
+      // into downwind.
+      if (uw == -1) {
+        uw = c;
+      } else {
+        dw = c;
+      }
+    }
+  }
+  upwind_[f] = uw;
+  downwind_[f] = dw;
+}
+
+} // namespace
+} // namespace
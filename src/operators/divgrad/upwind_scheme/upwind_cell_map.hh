@@ -0,0 +1,62 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+
+// -----------------------------------------------------------------------------
+// ATS
+//
+// License: see $ATS_DIR/COPYRIGHT
+// Author: Ethan Coon (ecoon@lanl.gov)
+//
+// Upwind and downwind cells of each local face, given a flux.
+//
+// The cells of each face, and the face's direction relative to each, are
+// found once from the mesh.  Each update then only revisits faces whose flux
+// changed sign since the last one, so upwinding schemes that keep one of
+// these across Newton iterations avoid rebuilding the maps from the mesh.
+// -----------------------------------------------------------------------------
+
+#ifndef AMANZI_UPWINDING_CELL_MAP_
+#define AMANZI_UPWINDING_CELL_MAP_
+
+#include <vector>
+
+#include "Epetra_MultiVector.h"
+#include "Mesh.hh"
+
+namespace Amanzi {
+namespace Operators {
+
+class UpwindCellMap {
+
+ public:
+  UpwindCellMap() : nfaces_(-1), ncells_(-1) {}
+
+  // Updates the maps for the flux on local faces.  Upwind/downwind cells may
+  // be ghost cells, and are -1 where a boundary face has no such cell.
+  void Update(const AmanziMesh::Mesh& mesh, const Epetra_MultiVector& flux);
+
+  const std::vector<int>& upwind_cells() const { return upwind_; }
+  const std::vector<int>& downwind_cells() const { return downwind_; }
+
+ private:
+  void Initialize_(const AmanziMesh::Mesh& mesh, int nfaces);
+  void UpdateFace_(int f, double flux);
+
+ private:
+  int nfaces_, ncells_;
+
+  // the (up to) two cells of each local face, in increasing cell order, and
+  // the face's direction relative to each
+  std::vector<int> face_cells_;
+  std::vector<int> face_dirs_;
+
+  // sign of the flux the maps were last computed for, with 2 for never
+  std::vector<int> flux_sign_;
+
+  std::vector<int> upwind_;
+  std::vector<int> downwind_;
+};
+
+} // namespace
+} // namespace
+
+#endif
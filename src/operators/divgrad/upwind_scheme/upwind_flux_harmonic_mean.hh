@@ -14,6 +14,7 @@
 #define AMANZI_UPWINDING_FLUXHARMONICMEAN_SCHEME_
 
 #include "upwinding.hh"
+#include "upwind_cell_map.hh"
 
 namespace Amanzi {
 
@@ -47,7 +48,7 @@ public:
                     const CompositeVector& dconductivity,
                     const std::vector<int>& bc_markers,
                     const std::vector<double>& bc_values,
-                    std::vector<Teuchos::RCP<Teuchos::SerialDenseMatrix<int, double> > >* Jpp_faces) const;
+                    std::vector<double>* Jpp_faces) const;
 
   virtual std::string
   CoefficientLocation() { return "upwind: face"; }
@@ -59,6 +60,9 @@ private:
   std::string face_coef_;
   std::string flux_;
   double flux_eps_;
+
+  // upwind/downwind cells of each face, kept across calls
+  mutable UpwindCellMap cell_map_;
 };
 
 } // namespace
@@ -13,6 +13,7 @@
 #define AMANZI_UPWINDING_FLUXSPLITDENOMINATOR_SCHEME_
 
 #include "upwinding.hh"
+#include "upwind_cell_map.hh"
 
 namespace Amanzi {
 
@@ -54,7 +55,7 @@ public:
                     const CompositeVector& dconductivity,
                     const std::vector<int>& bc_markers,
                     const std::vector<double>& bc_values,
-                    std::vector<Teuchos::RCP<Teuchos::SerialDenseMatrix<int, double> > >* Jpp_faces) const;
+                    std::vector<double>* Jpp_faces) const;
 
   virtual std::string
   CoefficientLocation() { return "upwind: face"; }
@@ -70,6 +71,9 @@ private:
   std::string manning_coef_;
   double slope_regularization_;
   std::string ponded_depth_;
+
+  // upwind/downwind cells of each face, kept across calls
+  mutable UpwindCellMap cell_map_;
 };
 
 } // namespace
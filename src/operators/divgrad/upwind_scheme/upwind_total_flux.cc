@@ -16,7 +16,6 @@
 #include "Debugger.hh"
 #include "VerboseObject.hh"
 #include "upwind_total_flux.hh"
-#include "Epetra_IntVector.h"
 
 namespace Amanzi {
 namespace Operators {
@@ -65,39 +64,9 @@ void UpwindTotalFlux::CalculateCoefficientsOnFaces(
 
   // Identify upwind/downwind cells for each local face.  Note upwind/downwind
   // may be a ghost cell.
-  Epetra_IntVector upwind_cell(*face_coef->ComponentMap("face",true));
-  upwind_cell.PutValue(-1);
-  Epetra_IntVector downwind_cell(*face_coef->ComponentMap("face",true));
-  downwind_cell.PutValue(-1);
-
-  AmanziMesh::Entity_ID_List faces;
-  std::vector<int> fdirs;
-  int nfaces_local = flux.size("face",false);
-
-  int ncells = cell_coef.size("cell",true);
-  for (int c=0; c!=ncells; ++c) {
-    mesh->cell_get_faces_and_dirs(c, &faces, &fdirs);
-
-    for (unsigned int n=0; n!=faces.size(); ++n) {
-      int f = faces[n];
-
-      if (f < nfaces_local) {
-        if (flux_v[0][f] * fdirs[n] > 0) {
-          upwind_cell[f] = c;
-        } else if (flux_v[0][f] * fdirs[n] < 0) {
-          downwind_cell[f] = c;
-        } else {
-          // We don't care, but we have to get one into upwind and the other
-          // into downwind.
-          if (upwind_cell[f] == -1) {
-            upwind_cell[f] = c;
-          } else {
-            downwind_cell[f] = c;
-          }
-        }
-      }
-    }
-  }
+  const std::vector<int>& upwind_cell = cell_map_.upwind_cells();
+  const std::vector<int>& downwind_cell = cell_map_.downwind_cells();
+  cell_map_.Update(*mesh, flux_v);
 
   // Determine the face coefficient of local faces.
   // These parameters may be key to a smooth convergence rate near zero flux.
@@ -173,7 +142,7 @@ UpwindTotalFlux::UpdateDerivatives(const Teuchos::Ptr<State>& S,
                                         const CompositeVector& dconductivity,
                                         const std::vector<int>& bc_markers,
                                         const std::vector<double>& bc_values,
-                                        std::vector<Teuchos::RCP<Teuchos::SerialDenseMatrix<int, double> > >* Jpp_faces) const {
+                                        std::vector<double>* Jpp_faces) const {
   // Grab derivatives
   dconductivity.ScatterMasterToGhosted("cell");
   const Epetra_MultiVector& dcell_v = *dconductivity.ViewComponent("cell",true);
@@ -189,7 +158,7 @@ UpwindTotalFlux::UpdateDerivatives(const Teuchos::Ptr<State>& S,
   // Grab mesh and allocate space
   Teuchos::RCP<const AmanziMesh::Mesh> mesh = dconductivity.Mesh();
   unsigned int nfaces_owned = mesh->num_entities(AmanziMesh::FACE,AmanziMesh::OWNED);
-  Jpp_faces->resize(nfaces_owned);
+  Jpp_faces->resize(4*nfaces_owned);
 
   // workspace
   double dK_dp[2];
@@ -198,46 +167,17 @@ UpwindTotalFlux::UpdateDerivatives(const Teuchos::Ptr<State>& S,
 
   // Identify upwind/downwind cells for each local face.  Note upwind/downwind
   // may be a ghost cell.
-  Epetra_IntVector upwind_cell(mesh->face_map(true));
-  upwind_cell.PutValue(-1);
-  Epetra_IntVector downwind_cell(mesh->face_map(true));
-  downwind_cell.PutValue(-1);
-
-  AmanziMesh::Entity_ID_List faces;
-  std::vector<int> fdirs;
-
-  int ncells = dcell_v.MyLength();
-  for (int c=0; c!=ncells; ++c) {
-    mesh->cell_get_faces_and_dirs(c, &faces, &fdirs);
-
-    for (unsigned int n=0; n!=faces.size(); ++n) {
-      int f = faces[n];
-
-      if (f < nfaces_owned) {
-        if (flux_v[0][f] * fdirs[n] > 0) {
-          upwind_cell[f] = c;
-        } else if (flux_v[0][f] * fdirs[n] < 0) {
-          downwind_cell[f] = c;
-        } else {
-          // We don't care, but we have to get one into upwind and the other
-          // into downwind.
-          if (upwind_cell[f] == -1) {
-            upwind_cell[f] = c;
-          } else {
-            downwind_cell[f] = c;
-          }
-        }
-      }
-    }
-  }
+  const std::vector<int>& upwind_cell = cell_map_.upwind_cells();
+  const std::vector<int>& downwind_cell = cell_map_.downwind_cells();
+  cell_map_.Update(*mesh, flux_v);
 
 
+  AmanziMesh::Entity_ID_List cells;
   for (unsigned int f=0; f!=nfaces_owned; ++f) {
     int uw = upwind_cell[f];
     int dw = downwind_cell[f];
     ASSERT(!((uw == -1) && (dw == -1)));
 
-    AmanziMesh::Entity_ID_List cells;
     mesh->face_get_cells(f, AmanziMesh::USED, &cells);
     int mcells = cells.size();
 
@@ -286,10 +226,9 @@ UpwindTotalFlux::UpdateDerivatives(const Teuchos::Ptr<State>& S,
       }
     }
 
-    // create the local matrix
-    Teuchos::RCP<Teuchos::SerialDenseMatrix<int, double> > Jpp =
-      Teuchos::rcp(new Teuchos::SerialDenseMatrix<int, double>(mcells, mcells));
-    (*Jpp_faces)[f] = Jpp;
+    // the local matrix, column-major, with only (0,0) used on boundaries
+    double* Jpp = &(*Jpp_faces)[4*f];
+    Jpp[0] = Jpp[1] = Jpp[2] = Jpp[3] = 0.;
 
     if (mcells == 1) {
       if (bc_markers[f] == Operators::OPERATOR_BC_DIRICHLET) {
@@ -298,19 +237,19 @@ UpwindTotalFlux::UpdateDerivatives(const Teuchos::Ptr<State>& S,
         p[1] = bc_values[f];
         double dp = p[0] - p[1];
 
-        (*Jpp)(0,0) = dp * mesh->face_area(f) * dK_dp[0];
+        Jpp[0] = dp * mesh->face_area(f) * dK_dp[0];
       } else {
-        (*Jpp)(0,0) = 0.;
+        Jpp[0] = 0.;
       }
 
     } else {
       p[0] = pres_v[0][cells[0]];
       p[1] = pres_v[0][cells[1]];
 
-      (*Jpp)(0,0) = (p[0] - p[1]) * mesh->face_area(f) * dK_dp[0];
-      (*Jpp)(0,1) = (p[0] - p[1]) * mesh->face_area(f) * dK_dp[1];
-      (*Jpp)(1,0) = -(*Jpp)(0,0);
-      (*Jpp)(1,1) = -(*Jpp)(0,1);
+      Jpp[0] = (p[0] - p[1]) * mesh->face_area(f) * dK_dp[0];
+      Jpp[2] = (p[0] - p[1]) * mesh->face_area(f) * dK_dp[1];
+      Jpp[1] = -Jpp[0];
+      Jpp[3] = -Jpp[2];
     }
   }
 }
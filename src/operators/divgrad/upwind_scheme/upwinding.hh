@@ -14,7 +14,6 @@
 #define AMANZI_UPWINDING_SCHEME_
 
 #include "Teuchos_RCP.hpp"
-#include "Teuchos_SerialDenseMatrix.hpp"
 
 #include "dbc.hh"
 #include "OperatorDefs.hh"
@@ -45,13 +44,17 @@ class Upwinding {
   virtual void
   Update(const Teuchos::Ptr<State>& S, const Teuchos::Ptr<Debugger>& db=Teuchos::null) = 0;
 
+  // Derivatives of the face flux with respect to the potential of the two
+  // neighboring cells.  Jpp_faces is a flat array of one 2x2 matrix, stored
+  // column-major, per owned face; it is resized on the first call and
+  // should be kept by the caller so that later calls do not allocate.
   virtual void
   UpdateDerivatives(const Teuchos::Ptr<State>& S, 
                     std::string potential_key,
                     const CompositeVector& dconductivity,
                     const std::vector<int>& bc_markers,
                     const std::vector<double>& bc_values,
-                    std::vector<Teuchos::RCP<Teuchos::SerialDenseMatrix<int, double> > >* Jpp_faces) const {
+                    std::vector<double>* Jpp_faces) const {
     ASSERT(0);
   }
 
@@ -16,6 +16,7 @@
 #include "MeshPartition.hh"
 
 #include "bgc_simple_funcs.hh"
+#include "debugger_helpers.hh"
 
 #include "bgc_simple.hh"
 
@@ -437,6 +438,7 @@ bool BGCSimple::AdvanceStep(double t_old, double t_new, bool reinit) {
   total_lai.PutScalar(0.);
 
   // loop over columns and apply the model
+  int rank = mesh_->get_comm()->MyPID();
   for (AmanziMesh::Entity_ID col=0; col!=ncols; ++col) {
     // update the various soil arrays
     FieldToColumn_(col, *temp(0), temp_c.ptr());
@@ -469,7 +471,7 @@ bool BGCSimple::AdvanceStep(double t_old, double t_new, bool reinit) {
     BGCAdvance(S_inter_->time(), dt, scv[0][col], cryoturbation_coef_, met,
                *temp_c, *pres_c, *depth_c, *dz_c,
                pfts_[col], soil_carbon_pools_[col],
-               co2_decomp_c, trans_c, sw_c);
+               co2_decomp_c, trans_c, sw_c, vo_);
 
     // copy back
     // -- serious cache thrash... --etc
@@ -484,8 +486,9 @@ bool BGCSimple::AdvanceStep(double t_old, double t_new, bool reinit) {
 
       // and pull in the transpiration, converting to mol/m^3/s, as a sink
       trans[0][col_iter[i]] = -trans_c[i]/ .01801528;
-      std::cout << std::scientific;
-      std::cout << "Transpiration at " << col_iter[i] << "," << i << " = " << trans[0][col_iter[i]] << std::endl;
+      Teuchos::RCP<VerboseObject> dcvo = GetDebugCellVerboseObject(vo_, db_, col_iter[i], rank, Teuchos::VERB_EXTREME);
+      if (dcvo != Teuchos::null)
+        *dcvo->os() << std::scientific << "Transpiration at " << col_iter[i] << "," << i << " = " << trans[0][col_iter[i]] << std::endl;
       sw[0][col] = sw_c;
     }
 
@@ -35,6 +35,7 @@ namespace BGC {
   // SoilThicknessArr [m] (dz)
   // TransArr[kg H2O/m3/s]
   // sw_shaded[W/m^s] (shaded shortwave radiation that makes it to the surface)
+  // vo (optional) reports killed plants and unconverged photosynthesis at high verbosity
   void BGCAdvance(double t, double dt, double gridarea, double cryoturbation_coef,
 		  const MetData& met,
 		  const Epetra_SerialDenseVector& SoilTArr,
@@ -45,7 +46,8 @@ namespace BGC {
 		  std::vector<Teuchos::RCP<SoilCarbon> >& soilcarr,
 		  Epetra_SerialDenseVector& SoilCO2Arr,
 		  Epetra_SerialDenseVector& TransArr,
-		  double& sw_shaded)
+		  double& sw_shaded,
+		  const Teuchos::RCP<VerboseObject>& vo)
   {
   // required constants
   double p_atm = 101325.;
@@ -54,7 +56,7 @@ namespace BGC {
   double t_days = t / 86400.;
   double wp_max = -1.e-6; //MPa wp = p - p_atm
   double wp_min = -10.; //MPa
-  int max_leaf_layers = 10;
+  const int max_leaf_layers = 10;
   int ncells = SoilTArr.Length();
 
   // calculate fractional day length
@@ -223,15 +225,38 @@ namespace BGC {
       double  relCLNCa;  //relative leaf nitrogen content comapred to the top canopy
       double  Vcmax25i; //Vcmax at each leaf layers 
       if (PAR>0.0) {
+	  // light and Vcmax of every leaf layer are known up front, so solve all
+	  // layers together
+	  double PARi_l[max_leaf_layers], Vcmax25_l[max_leaf_layers];
+	  double LUE_l[max_leaf_layers], LER_l[max_leaf_layers], mp_l[max_leaf_layers];
+	  double psn_l[max_leaf_layers], tleaf_l[max_leaf_layers];
+	  double leafresp_l[max_leaf_layers], ET_l[max_leaf_layers];
 	  for (int leaf_layer=0; leaf_layer!=max_leaf_layers; ++leaf_layer){
 	    relRad   = PARi/PAR;
 	    relCLNCa = 0.1802 * std::log(relRad)+1.0; //see Ali et al 2015
 	    relCLNCa = std::max(0.2,relCLNCa);
 	    relCLNCa = std:: min(1.0,relCLNCa);
 	    Vcmax25i = Vcmax25 * relCLNCa;
-	    Photosynthesis(PARi, pft.LUE, pft.LER, p_atm,
-			   met.windv,double(met.tair - 273.15), met.relhum, met.CO2a, pft.mp, Vcmax25i,
-			   &psn, &tleaf, &leafresp,&ET);
+	    PARi_l[leaf_layer] = PARi;
+	    Vcmax25_l[leaf_layer] = Vcmax25i;
+	    LUE_l[leaf_layer] = pft.LUE;
+	    LER_l[leaf_layer] = pft.LER;
+	    mp_l[leaf_layer] = pft.mp;
+	    ET_l[leaf_layer] = 0.;
+	    PARi *= std::exp(-pft.LER);
+	  }
+	  int ncapped = PhotosynthesisBatch(max_leaf_layers, PARi_l, LUE_l, LER_l, p_atm,
+			      met.windv,double(met.tair - 273.15), met.relhum, met.CO2a, mp_l, Vcmax25_l,
+			      psn_l, tleaf_l, leafresp_l, ET_l);
+	  if (ncapped > 0 && vo != Teuchos::null && vo->os_OK(Teuchos::VERB_HIGH))
+	    *vo->os() << "WARNING: photosynthesis not converged in " << ncapped
+		      << " leaf layers of pft " << pft.pft_type << std::endl;
+
+	  for (int leaf_layer=0; leaf_layer!=max_leaf_layers; ++leaf_layer){
+	    psn = psn_l[leaf_layer];
+	    tleaf = tleaf_l[leaf_layer];
+	    leafresp = leafresp_l[leaf_layer];
+	    ET = ET_l[leaf_layer];
 	    psn *= Btran;
 	    ET  *= Btran; 
 	    if (thawD <= 0.0) {
@@ -253,7 +278,6 @@ namespace BGC {
 	      leafresptotal += dt * Cv * leafresp * gridarea;
 	      pft.ET += dt * 18.0 * 1.0e-9 * ET * gridarea;
 	    }
-	    PARi *= std::exp(-pft.LER);
          }
       }
       //------------------------------------------------------------------------------------------------
@@ -505,7 +529,8 @@ namespace BGC {
           pft.Bstore < 0.00001*(pft.Bleaf + pft.Bleafmemory)) {
         // kill all to avoid very small vegetation types and numerical errors
         mort = 1.0;
-        std::cout << "WARNING: plant killed for pft " << pft.pft_type;
+        if (vo != Teuchos::null && vo->os_OK(Teuchos::VERB_HIGH))
+          *vo->os() << "WARNING: plant killed for pft " << pft.pft_type << std::endl;
       }
 
       if ( mort > 0.0) {
@@ -683,7 +708,6 @@ namespace BGC {
   double radi = met.qSWin;
   for (std::vector<Teuchos::RCP<PFT> >::iterator pft_iter=pftarr.begin();
        pft_iter!=pftarr.end(); ++pft_iter) {
-    std::cout << "wtf: (" << (*pft_iter)->pft_type << ") " << (*pft_iter)->LER << ", " << (*pft_iter)->lai << ", " << radi << std::endl;
     radi *= std::exp(-(*pft_iter)->LER * (*pft_iter)->lai);
    }
   sw_shaded = radi;
@@ -692,9 +716,9 @@ namespace BGC {
 
  //=========================================================================
   // do soil decomposition
+  std::vector<double> rate(ncells);
   for (int k=0; k!=ncells; ++k) {
     double TFactor = TEffectsQ10(2.0, SoilTArr[k] - 273.15, 25.0);
-    SoilCO2Arr[k] = 0.0;
     double WFactor;
 
     double soil_wp = std::max(std::min( (SoilWPArr[k] - p_atm) / 1.e6, wp_max), wp_min);
@@ -705,33 +729,33 @@ namespace BGC {
     }
 
     double DFactor = std::exp(-SoilDArr[k] / 0.5);
-    int nPools = soilcarr[k]->params->nPools;
-    std::vector<double> SOMConvt(nPools);
-
-    for (int l=0; l!=nPools; ++l){
-      // AFFECTED BY DT --etc
-      double turnover = dt_days * WFactor*TFactor*DFactor / (soilcarr[k]->params->TurnoverRates[l] * 365.25);
-      ASSERT(turnover <= 0.9);
-
-      double SOMDecomp = soilcarr[k]->SOM[l] * turnover;
-      soilcarr[k]->SOM[l] *= 1.0 - turnover;
+    rate[k] = WFactor*TFactor*DFactor;
+  }
 
-      SoilCO2Arr[k] += SOMDecomp * soilcarr[k]->params->RespF[l];
-      SOMConvt[l] = SOMDecomp * (1.0 - soilcarr[k]->params->RespF[l]);
+  // decompose runs of cells sharing soil carbon parameters together, with
+  // the pools gathered pool-major so the kernel runs across cells
+  std::vector<double> SOM, CO2;
+  int k0 = 0;
+  while (k0 < ncells) {
+    const SoilCarbonParameters& params = *soilcarr[k0]->params;
+    int k1 = k0 + 1;
+    while (k1 < ncells && soilcarr[k1]->params.get() == &params) k1++;
+    int nrun = k1 - k0;
+    int nPools = params.nPools;
+
+    SOM.resize(nPools*nrun);
+    CO2.resize(nrun);
+    for (int k=0; k!=nrun; ++k) {
+      for (int l=0; l!=nPools; ++l) SOM[l*nrun+k] = soilcarr[k0+k]->SOM[l];
     }
 
-    double totalSoilCz = 0.0;
-    for (int l=0; l!=nPools; ++l) {
-      double totalConvrtC = 0.0;
-      for (int m=0; m!=nPools; ++m) {
-        if (m != l) {
-          totalConvrtC += SOMConvt[m]* soilcarr[k]->params->Tij[m][l]; // *SOMConvt[l];
-        }
-      }
+    DecomposeSoilCarbon(params, dt_days, nrun, &rate[k0], &SOM[0], &CO2[0]);
 
-      soilcarr[k]->SOM[l] += totalConvrtC;
-      totalSoilCz += soilcarr[k]->SOM[l];
+    for (int k=0; k!=nrun; ++k) {
+      for (int l=0; l!=nPools; ++l) soilcarr[k0+k]->SOM[l] = SOM[l*nrun+k];
+      SoilCO2Arr[k0+k] = CO2[k];
     }
+    k0 = k1;
   }
 
   //================================================
@@ -741,6 +765,91 @@ namespace BGC {
 
   }
 
+  // Decomposition and transfer of soil carbon between pools is the linear
+  // system
+  //
+  //   dC_l/dt = - k_l C_l + sum_{m != l} (1 - RespF_m) k_m Tij[m][l] C_m
+  //   dCO2/dt = sum_m RespF_m k_m C_m
+  //
+  // with k_m = rate / (TurnoverRates[m] * 365.25) [1/d].  Appending CO2 to
+  // the pools, this is dC/dt = rate B C for a constant matrix B, so the step
+  // is exp(rate dt B) C, evaluated by a Taylor series in substeps of
+  // ||rate dt B|| <= 1, truncated at round-off.  This is unconditionally
+  // stable, so the step is not limited by the fastest pool.
+  void DecomposeSoilCarbon(const SoilCarbonParameters& params, double dt_days,
+                           int ncells, const double* rate, double* SOM, double* CO2)
+  {
+    int npools = params.nPools;
+    int nrows = npools + 1;
+
+    // nonzeros of B, and its 1-norm
+    std::vector<int> row, col;
+    std::vector<double> val;
+    double normB = 0.;
+    for (int m=0; m!=npools; ++m) {
+      double k_m = 1.0 / (params.TurnoverRates[m] * 365.25);
+      double colsum = k_m;
+      row.push_back(m); col.push_back(m); val.push_back(-k_m);
+      for (int l=0; l!=npools; ++l) {
+        double v = (1.0 - params.RespF[m]) * k_m * params.Tij[m][l];
+        if (l != m && v != 0.) {
+          row.push_back(l); col.push_back(m); val.push_back(v);
+          colsum += std::abs(v);
+        }
+      }
+      double v = params.RespF[m] * k_m;
+      if (v != 0.) {
+        row.push_back(npools); col.push_back(m); val.push_back(v);
+        colsum += v;
+      }
+      normB = std::max(normB, colsum);
+    }
+    int nnz = val.size();
+
+    // substeps and series order
+    double max_rate = 0.;
+    for (int k=0; k!=ncells; ++k) max_rate = std::max(max_rate, rate[k]);
+    double eta = max_rate * dt_days * normB;
+    for (int k=0; k!=ncells; ++k) CO2[k] = 0.;
+    if (eta == 0.) return;
+
+    int nsteps = std::max(1, (int) std::ceil(eta));
+    eta /= nsteps;
+    int order = 1;
+    double err = eta;
+    while (order < 30 && err * eta / (order+1) > 1.e-15) {
+      order++;
+      err *= eta / order;
+    }
+
+    std::vector<double> y(nrows*ncells), term(nrows*ncells), next(nrows*ncells);
+    std::vector<double> h(ncells), scale(ncells);
+    std::copy(SOM, SOM + npools*ncells, y.begin());
+    std::fill(y.begin() + npools*ncells, y.end(), 0.);
+    for (int k=0; k!=ncells; ++k) h[k] = rate[k] * dt_days / nsteps;
+
+    for (int step=0; step!=nsteps; ++step) {
+      term = y;
+      for (int j=1; j<=order; ++j) {
+        // next = (h B / j) term
+        for (int k=0; k!=ncells; ++k) scale[k] = h[k] / j;
+        std::fill(next.begin(), next.end(), 0.);
+        for (int e=0; e!=nnz; ++e) {
+          double* next_r = &next[row[e]*ncells];
+          const double* term_c = &term[col[e]*ncells];
+          double v = val[e];
+          for (int k=0; k!=ncells; ++k) next_r[k] += v * scale[k] * term_c[k];
+        }
+        for (int i=0; i!=nrows*ncells; ++i) y[i] += next[i];
+        std::swap(term, next);
+      }
+    }
+
+    std::copy(y.begin(), y.begin() + npools*ncells, SOM);
+    std::copy(y.begin() + npools*ncells, y.end(), CO2);
+  }
+
+
   // Cryoturbation -- move the carbon around via diffusion
   void Cryoturbate(double dt,
 		   const Epetra_SerialDenseVector& SoilTArr,
@@ -760,65 +869,37 @@ namespace BGC {
 		   const Epetra_SerialDenseVector& SoilThicknessArr,
 		   std::vector<Teuchos::RCP<SoilCarbon> >& soilcarr,
 		   std::vector<double>& diffusion_coefs) {
-    int ncells = SoilTArr.Length();
     // only cryoturbate unfrozen soil
     int k_frozen = PermafrostDepthIndex(SoilTArr, 273.15);
 
-    // fast and dirty diffusion
+    // fast and dirty diffusion, on the pools gathered pool-major
     int npools = soilcarr[0]->nPools;
-    Epetra_SerialDenseVector dC_up(npools);
-    Epetra_SerialDenseVector dC_dn(npools);
-    std::vector<Epetra_SerialDenseVector> dC(k_frozen, Epetra_SerialDenseVector(npools));
+    int n = k_frozen;
+    if (n == 0) return;
 
-    int k = 0;
-    while (k < k_frozen) {
-      Epetra_SerialDenseVector& C = soilcarr[k]->SOM;
-
-      // dC/dz on the face above
-      if (k == 0) {
-	// dC_up initialized to zero already
-      } else {
-	Epetra_SerialDenseVector& C_up = soilcarr[k-1]->SOM;
-	double dz_up = SoilDArr[k] - SoilDArr[k-1];
-	for (int l=0; l!=npools; ++l) {
-	  dC_up[l] = (C[l] - C_up[l]) / dz_up;
-	}
-      }
+    std::vector<double> C(npools*n);
+    for (int k=0; k!=n; ++k) {
+      for (int l=0; l!=npools; ++l) C[l*n+k] = soilcarr[k]->SOM[l];
+    }
 
-      // dC/dz on the face below
-      if ((k == ncells-1) || k+1 >= k_frozen) {
-	// boundary case
-	for (int l=0; l!=npools; ++l) {
-	  dC_dn[l] = 0;
-	}
-      } else {
-	Epetra_SerialDenseVector& C_dn = soilcarr[k+1]->SOM;
-	double dz_dn = SoilDArr[k+1] - SoilDArr[k];
-	for (int l=0; l!=npools; ++l) {
-	  dC_dn[l] = (C_dn[l] - C[l]) / dz_dn;
-	}
+    // dC/dz on the faces between unfrozen cells, zero on the boundaries
+    std::vector<double> dCdz(n+1, 0.);
+    std::vector<double> dC(n);
+    for (int l=0; l!=npools; ++l) {
+      double* C_l = &C[l*n];
+      for (int k=1; k!=n; ++k) {
+	dCdz[k] = (C_l[k] - C_l[k-1]) / (SoilDArr[k] - SoilDArr[k-1]);
       }
 
       // dC = dt * D * (dC/dz_below - dC/dz_above) / dz
-      double dz = SoilThicknessArr[k];
-      for (int l=0; l!=npools; ++l) {
-	dC[k][l] = dt * diffusion_coefs[l] / dz * (dC_dn[l] - dC_up[l]);
+      for (int k=0; k!=n; ++k) {
+	dC[k] = dt * diffusion_coefs[l] / SoilThicknessArr[k] * (dCdz[k+1] - dCdz[k]);
       }
-
-      // increment
-      k++;
+      for (int k=0; k!=n; ++k) C_l[k] += dC[k];
     }
-  
-    // Now that dC is calculated everywhere, update carbon pools
-    k = 0;
-    while (k < k_frozen) {
-      Epetra_SerialDenseVector& C_k = soilcarr[k]->SOM;
-      Epetra_SerialDenseVector& dC_k = dC[k];
-    
-      for (int l=0; l!=npools; ++l) {
-	C_k[l] += dC_k[l];
-      }
-      k++;
+
+    for (int k=0; k!=n; ++k) {
+      for (int l=0; l!=npools; ++l) soilcarr[k]->SOM[l] = C[l*n+k];
     }
   }
 
@@ -15,6 +15,7 @@ License: BSD
 
 #include "Epetra_SerialDenseVector.h"
 #include "Teuchos_RCP.hpp"
+#include "VerboseObject.hh"
 
 #include "utils.hh"
 #include "PFT.hh"
@@ -33,7 +34,14 @@ void BGCAdvance(double t, double dt, double gridarea, double cryoturbation_coef,
              std::vector<Teuchos::RCP<SoilCarbon> >& soilcarr,
              Epetra_SerialDenseVector& SoilCO2Arr,
              Epetra_SerialDenseVector& TransArr,
-             double& sw_shaded);
+             double& sw_shaded,
+             const Teuchos::RCP<VerboseObject>& vo=Teuchos::null);
+
+// Decompose soil carbon over dt_days [d] in ncells cells sharing params, with
+// SOM stored pool-major (SOM[l*ncells + k]).  rate[k] scales the turnover
+// rates of cell k; CO2[k] is the carbon respired over the step.
+void DecomposeSoilCarbon(const SoilCarbonParameters& params, double dt_days,
+                         int ncells, const double* rate, double* SOM, double* CO2);
 
 void Cryoturbate(double dt,
 		 const Epetra_SerialDenseVector& SoilTArr,
@@ -0,0 +1,61 @@
+#include "UnitTest++.h"
+#include "TestReporterStdout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "vegetation.hh"
+
+using namespace Amanzi::BGC;
+
+// Leaf layers of one column, with light attenuated through the canopy as in
+// BGCAdvance.  Dark leaves at the bottom and block boundaries are exercised
+// by nleaves > 16.
+struct TestCanopy {
+  std::vector<double> PARi, LUE, LER, mp, Vcmax25;
+
+  TestCanopy(int nleaves, double PAR) :
+      PARi(nleaves), LUE(nleaves, 0.04), LER(nleaves, 0.2),
+      mp(nleaves, 9.), Vcmax25(nleaves) {
+    double PARi_l = PAR;
+    for (int i=0; i!=nleaves; ++i) {
+      PARi[i] = (i < nleaves - 3) ? PARi_l : 0.;
+      double relCLNCa = PAR > 0. ? 0.1802 * std::log(PARi_l/PAR) + 1.0 : 1.;
+      Vcmax25[i] = 60. * std::min(1.0, std::max(0.2, relCLNCa));
+      PARi_l *= std::exp(-LER[i]);
+    }
+  }
+};
+
+
+SUITE(BGC_PHOTOSYNTHESIS) {
+
+  TEST(BATCHED_MATCHES_SCALAR) {
+    const int nleaves = 37;
+    const double tairs[] = { -5., 0., 1., 12.5, 25., 38. };
+    const double PARs[] = { 0., 50., 400., 1500. };
+
+    for (int t=0; t!=6; ++t) {
+      for (int p=0; p!=4; ++p) {
+        TestCanopy cn(nleaves, PARs[p]);
+        std::vector<double> A(nleaves), tleaf(nleaves), Resp(nleaves), ET(nleaves, 0.);
+        int ncapped = PhotosynthesisBatch(nleaves, &cn.PARi[0], &cn.LUE[0], &cn.LER[0],
+                101325., 2., tairs[t], 0.6, 390., &cn.mp[0], &cn.Vcmax25[0],
+                &A[0], &tleaf[0], &Resp[0], &ET[0]);
+        CHECK_EQUAL(0, ncapped);
+
+        for (int i=0; i!=nleaves; ++i) {
+          double A_s, tleaf_s, Resp_s, ET_s = 0.;
+          Photosynthesis(cn.PARi[i], cn.LUE[i], cn.LER[i], 101325., 2., tairs[t], 0.6, 390.,
+                         cn.mp[i], cn.Vcmax25[i], &A_s, &tleaf_s, &Resp_s, &ET_s);
+          CHECK_CLOSE(A_s, A[i], 1.e-10 * std::max(1., std::abs(A_s)));
+          CHECK_CLOSE(tleaf_s, tleaf[i], 1.e-10 * std::max(1., std::abs(tleaf_s)));
+          CHECK_CLOSE(Resp_s, Resp[i], 1.e-10 * std::max(1., std::abs(Resp_s)));
+          CHECK_CLOSE(ET_s, ET[i], 1.e-10 * std::max(1., std::abs(ET_s)));
+        }
+      }
+    }
+  }
+
+}
@@ -0,0 +1,97 @@
+#include "UnitTest++.h"
+#include "TestReporterStdout.h"
+
+#include <cmath>
+#include <vector>
+
+#include "SoilCarbonParameters.hh"
+#include "bgc_simple_funcs.hh"
+
+using namespace Amanzi::BGC;
+
+// Explicit RK4 reference for one cell, in n substeps, of
+//   dC_l/dt = - k_l C_l + sum_{m != l} (1 - RespF_m) k_m Tij[m][l] C_m
+//   dCO2/dt = sum_m RespF_m k_m C_m
+void DecomposeReference(const SoilCarbonParameters& params, double dt_days, int n,
+                        double rate, std::vector<double>& C, double& CO2) {
+  int npools = params.nPools;
+  std::vector<double> y(C), k1(npools+1), k2(npools+1), k3(npools+1), k4(npools+1);
+  y.push_back(0.);
+
+  struct {
+    const SoilCarbonParameters* p;
+    double rate;
+    void operator()(const std::vector<double>& y, std::vector<double>& dy) const {
+      int npools = p->nPools;
+      for (int l=0; l!=npools+1; ++l) dy[l] = 0.;
+      for (int m=0; m!=npools; ++m) {
+        double flux = rate * y[m] / (p->TurnoverRates[m] * 365.25);
+        dy[m] -= flux;
+        for (int l=0; l!=npools; ++l) {
+          if (l != m) dy[l] += (1.0 - p->RespF[m]) * p->Tij[m][l] * flux;
+        }
+        dy[npools] += p->RespF[m] * flux;
+      }
+    }
+  } rhs = { &params, rate };
+
+  double h = dt_days / n;
+  std::vector<double> tmp(npools+1);
+  for (int s=0; s!=n; ++s) {
+    rhs(y, k1);
+    for (int l=0; l!=npools+1; ++l) tmp[l] = y[l] + 0.5*h*k1[l];
+    rhs(tmp, k2);
+    for (int l=0; l!=npools+1; ++l) tmp[l] = y[l] + 0.5*h*k2[l];
+    rhs(tmp, k3);
+    for (int l=0; l!=npools+1; ++l) tmp[l] = y[l] + h*k3[l];
+    rhs(tmp, k4);
+    for (int l=0; l!=npools+1; ++l) y[l] += h/6. * (k1[l] + 2*k2[l] + 2*k3[l] + k4[l]);
+  }
+  for (int l=0; l!=npools; ++l) C[l] = y[l];
+  CO2 = y[npools];
+}
+
+
+SUITE(BGC_SOIL_CARBON) {
+
+  // Cells from frozen (no decomposition) to fast, over a day and over a year,
+  // the latter many times the turnover time of the fastest pools.
+  TEST(DECOMPOSE_CONSERVES_AND_MATCHES_REFERENCE) {
+    SoilCarbonParameters params(7, 50.);
+    int npools = params.nPools;
+    const int ncells = 5;
+    const double rate[ncells] = { 0., 0.3, 1., 2.5, 7. };
+    const double dts[] = { 1., 365.25 };
+
+    for (int t=0; t!=2; ++t) {
+      std::vector<double> SOM(npools*ncells), CO2(ncells);
+      for (int l=0; l!=npools; ++l) {
+        for (int k=0; k!=ncells; ++k) SOM[l*ncells+k] = 1. + l + 0.1*k;
+      }
+      std::vector<double> SOM0(SOM);
+
+      DecomposeSoilCarbon(params, dts[t], ncells, rate, &SOM[0], &CO2[0]);
+
+      for (int k=0; k!=ncells; ++k) {
+        double total0 = 0., total = CO2[k];
+        std::vector<double> C(npools);
+        for (int l=0; l!=npools; ++l) {
+          total0 += SOM0[l*ncells+k];
+          total += SOM[l*ncells+k];
+          C[l] = SOM0[l*ncells+k];
+          CHECK(SOM[l*ncells+k] >= 0.);
+        }
+        CHECK(CO2[k] >= 0.);
+        CHECK_CLOSE(total0, total, 1.e-12 * total0);
+
+        double CO2_ref;
+        DecomposeReference(params, dts[t], 10000, rate[k], C, CO2_ref);
+        for (int l=0; l!=npools; ++l) {
+          CHECK_CLOSE(C[l], SOM[l*ncells+k], 1.e-10 * total0);
+        }
+        CHECK_CLOSE(CO2_ref, CO2[k], 1.e-10 * total0);
+      }
+    }
+  }
+
+}
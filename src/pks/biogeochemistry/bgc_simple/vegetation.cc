@@ -82,6 +82,31 @@ QSat::operator()(double tleafk, double pressure,
 }
 
 
+void
+QSat::operator()(int n, const double* tleafk, double pressure,
+                 double* es, double* esdT, double* qs, double* qsdT) {
+  for (int i=0; i!=n; ++i) {
+    double td = tleafk[i] - 273.15;
+    td = std::min(std::max(-75.0, td), 100.0);
+
+    // evaluate both branches and select, keeping the loop free of branches
+    double es_w = a0 + td * (a1 + td * (a2 + td * (a3 + td * (a4 + td * (a5 + td * (a6 + td * (a7 + td * a8)))))));
+    double esdT_w = b0 + td * (b1 + td * (b2 + td * (b3 + td * (b4 + td * (b5 + td * (b6 + td * (b7 + td * b8)))))));
+    double es_i = c0 + td * (c1 + td * (c2 + td * (c3 + td * (c4 + td * (c5 + td * (c6 + td * (c7 + td * c8)))))));
+    double esdT_i = d0 + td * (d1 + td * (d2 + td * (d3 + td * (d4 + td * (d5 + td * (d6 + td * (d7 + td * d8)))))));
+
+    es[i] = (td >= 0.0 ? es_w : es_i) * 100; // [Pa]
+    esdT[i] = (td >= 0.0 ? esdT_w : esdT_i) * 100; // [Pa/K]
+
+    double vp = 1.0 / (pressure - 0.378 * es[i]);
+    double vp1 = 0.622 * vp;
+    double vp2 = vp1 * vp;
+    qs[i] = es[i] * vp1;  // [kg/kg]
+    qsdT[i] = esdT[i] * vp2 * pressure; // [1/K]
+  }
+}
+
+
 double DayLength(double lat, int doy) {
   const double PI = 3.141592653589793;
   double LatRad = lat * (2.0 * PI) / 360.0;
@@ -131,6 +156,17 @@ double HighTLim(double tleaf) {
   return 1.0 / (1.0 + std::exp((-2.2e5 + 710.0 * (tleaf + SHR_CONST_TKFRZ))
           / (SHR_CONST_RGAS * 0.001 * (tleaf + SHR_CONST_TKFRZ))));
 }
+
+void HighTLim(int n, const double* tleaf, double* lim) {
+  double SHR_CONST_TKFRZ = 273.15;
+  double SHR_CONST_RGAS = 8314.467591;
+
+  for (int i=0; i!=n; ++i) {
+    lim[i] = 1.0 / (1.0 + std::exp((-2.2e5 + 710.0 * (tleaf[i] + SHR_CONST_TKFRZ))
+            / (SHR_CONST_RGAS * 0.001 * (tleaf[i] + SHR_CONST_TKFRZ))));
+  }
+}
+
 // This function calculate the net photosynthetic rate based on Farquhar
 // model, with updated leaf temperature based on energy balances, fixed the bugs with non-convergence for dry conditions
 void Photosynthesis(double PARi, double LUE, double LER, double pressure, double windv,
@@ -299,6 +335,231 @@ void Photosynthesis(double PARi, double LUE, double LER, double pressure, double
 }
 
 
+namespace {
+
+// Leaves solved together by PhotosynthesisBatch, enough for all leaf layers
+// of a PFT, with work arrays kept on the stack.
+const int PHOTOSYNTHESIS_BLOCK = 16;
+
+// PhotosynthesisBatch on n <= PHOTOSYNTHESIS_BLOCK leaves.  This is the
+// iteration of Photosynthesis, turned inside out: each fixed point loop runs
+// over the leaves still iterating, and a leaf leaves the loop on its own
+// convergence criteria.  Returns the number of leaves that stopped at an
+// iteration limit rather than converging.
+int PhotosynthesisBlock(int n, const double* PARi, const double* LUE, const double* LER,
+                         double pressure, double windv, double tair, double relh, double CO2a,
+                         const double* mp, const double* Vcmax25,
+                         double* A, double* tleaf, double* Resp, double* ET)
+{
+  const int NB = PHOTOSYNTHESIS_BLOCK;
+  double q10actf = 2.4; // Q10 coefficients
+
+  // per-leaf state
+  double ARAD[NB], JmeanL[NB];
+  double tleafnew[NB], tleafold[NB], Vcmax[NB], myA[NB], myET[NB];
+  bool lit[NB], active[NB], capped[NB];
+
+  // dark or frozen leaves need no iteration
+  int nactive = 0;
+  for (int i=0; i!=n; ++i) {
+    lit[i] = !(tair <= 0. || PARi[i] <= 0.);
+    tleafnew[i] = tair;
+    Vcmax[i] = 0.;
+    active[i] = lit[i];
+    capped[i] = false;
+    if (lit[i]) {
+      ARAD[i] = PARi[i] * (1.0 - std::exp(-LER[i])) / 2.3;
+      double APAR = PARi[i] * (1.0 - std::exp(-LER[i])) * 0.95; //assumes only 5% reflectance
+      JmeanL[i] = APAR*LUE[i]*4.0; //4.0 is a factor converting CO2 to electron
+      nactive++;
+    } else {
+      double ARAD_dark = PARi[i] / 2.3*(1.0 - std::exp(-LER[i]));
+      tleaf[i] = tair +  ARAD_dark / 38.4;
+      A[i] = 0.;
+
+      double q10act = q10actf * std::exp(-0.009 * (tleaf[i] - 15.0));
+      double Vc = Vcmax25[i] * HighTLim(tleaf[i]) * std::pow(q10act, 0.1 * (tleaf[i] - 25.0));
+      Resp[i] = Vc * 0.0089; // maintenance respiration
+      if (tleaf[i] < -1.0) Resp[i] *= 0.1;
+    }
+  }
+  if (nactive == 0) return 0;
+
+  // terms shared by all leaves
+  double o2a = 209460.0;
+  double co2c = CO2a * pressure * 1.e-6;
+  double o2c = o2a * pressure * 1.e-6;
+
+  double dleaf = 0.04;
+  double kc25 = 30.0;
+  double ko25 = 30000.0;
+  double akc = 2.1;
+  double ako = 1.2;
+  double bp = 2000.0;
+  double R = 8.314;
+
+  double rb0 = 100.0 * std::sqrt(dleaf / windv);
+
+  double tairk = tair + 273.15;
+  double es, esdT, qs, qsdT;
+  QSat qsat;
+  qsat(tairk, pressure, &es, &esdT, &qs, &qsdT);
+  double ea = es * relh;
+
+  double aquad = 1.0; // Terms for quadratic equations
+  double theta_cj = 0.95 ;// coefficient for interpolation, which is normally close to 1.0
+
+  // per-iteration work arrays
+  double tleafk[NB], q10act[NB], HighT[NB], ei[NB], esdT_l[NB], qs_l[NB], qsdT_l[NB];
+  double bbb[NB], gb_mol[NB], gs_mol[NB], c_p[NB], awc[NB], cea[NB];
+  double ci[NB], Wc[NB], Wj[NB];
+  bool inner[NB];
+
+  int itr = 0;
+  while (nactive > 0) {
+    itr++;
+
+    // Temperature dependent terms.  These are computed for every leaf to keep
+    // the loops free of branches, but only iterating leaves keep the new
+    // Vcmax, which is reported at the temperature of their last iteration.
+    for (int i=0; i!=n; ++i) {
+      tleafold[i] = tleafnew[i];
+      tleafk[i] = tleafnew[i] + 273.15;
+    }
+    HighTLim(n, tleafnew, HighT);
+    qsat(n, tleafk, pressure, ei, esdT_l, qs_l, qsdT_l);
+
+    for (int i=0; i!=n; ++i) {
+      q10act[i] = q10actf * std::exp(-0.009 * (tleafnew[i] - 15.0));
+      double cf = pressure * 1.e6 / (R * tleafk[i]);
+      double rb = rb0 / cf;
+      bbb[i] = cf/bp;
+      gb_mol[i] = 1.0/rb;
+      double k_o = ko25 * std::pow(ako, 0.1 * (tleafnew[i] - 25.0));
+      double k_c = kc25 * std::pow(akc, 0.1 * (tleafnew[i] - 25.0));
+      c_p[i] = 0.5 * k_c / k_o * o2c * 0.21;
+      awc[i] = k_c * (1.0 + o2c / k_o);
+
+      double Vc = Vcmax25[i] * HighT[i] * std::pow(q10act[i], (0.1 * (tleafnew[i] - 25.0)));
+      Vcmax[i] = active[i] ? Vc : Vcmax[i];
+      cea[i] = std::max(0.3 * ei[i], std::min(ea, ei[i]));
+      ci[i] = 0.7 * co2c;
+    }
+
+    // converge ci, RUBISCO-limited
+    int ninner = 0;
+    for (int i=0; i!=n; ++i) {
+      inner[i] = active[i];
+      if (inner[i]) ninner++;
+    }
+
+    int inner_itr = 0;
+    while (ninner > 0) {
+      inner_itr++;
+      for (int i=0; i!=n; ++i) {
+        if (!inner[i]) continue;
+        double ci_old = ci[i];
+        double Kc = std::max(ci[i] - c_p[i], 0.0) / (ci[i] + awc[i]);
+        Wc[i] = Kc * Vcmax[i];
+        gs_mol[i] = bbb[i] + mp[i] * Wc[i] / co2c * pressure * cea[i] / es;
+        double phi = (pressure * (1.37 * gs_mol[i] + 1.6 * gb_mol[i]) / (gb_mol[i] * gs_mol[i]));
+        double bquad = awc[i] - co2c + phi * Vcmax[i];
+        double cquad = -(c_p[i] * phi * Vcmax[i] + awc[i] * co2c);
+        double r1, r2;
+        Quadratic(aquad, bquad, cquad, &r1, &r2);
+        ci[i] = std::max(r1, r2);
+        if (ci[i] < 0.0) ci[i] = c_p[i] + 0.5 * ci_old;
+        if (inner_itr > 50 || std::abs((ci[i] - ci_old)/ci[i]) < 0.001) {
+          inner[i] = false;
+          ninner--;
+        }
+        if (inner_itr > 50) capped[i] = true;
+      }
+    }
+
+    // choose the limiting rate
+    for (int i=0; i!=n; ++i) {
+      if (!active[i]) continue;
+      double Kj = (std::max(ci[i] - c_p[i], 0.0)) / (4.0 * ci[i] + 8.0 * c_p[i]);
+      double Kc = (std::max(ci[i] - c_p[i], 0.0)) / (ci[i] + awc[i]);
+      Wc[i] = Kc * Vcmax[i];
+      Wj[i] = Kj * JmeanL[i];
+      inner[i] = Wj[i] < Wc[i]; //light limited
+      if (inner[i]) ninner++;
+    }
+
+    // converge ci, light-limited
+    inner_itr = 0;
+    while (ninner > 0) {
+      inner_itr++;
+      for (int i=0; i!=n; ++i) {
+        if (!inner[i]) continue;
+        double ci_old = ci[i];
+        double Kj = std::max(ci[i] - c_p[i], 0.0) / (4.0 * ci[i] + 8.0 * c_p[i]);
+        Wj[i] = Kj * JmeanL[i];
+        gs_mol[i] = bbb[i] + mp[i] * Wj[i] / co2c * pressure * cea[i] / es;
+        double phi = (pressure * (1.37 * gs_mol[i] + 1.6 * gb_mol[i]) / (gb_mol[i] * gs_mol[i]));
+        double bquad = 2 * c_p[i] - co2c + phi * JmeanL[i] / 4.0;
+        double cquad = -(c_p[i] * phi * JmeanL[i] / 4.0 + 2 * c_p[i] * co2c);
+        double r1, r2;
+        Quadratic(aquad, bquad, cquad, &r1, &r2);
+        ci[i] = std::max(r1, r2);
+        if (ci[i] < 0.0) ci[i] = c_p[i] + 0.5 * ci_old;
+        if (inner_itr > 50 || std::abs((ci[i] - ci_old)/ci[i]) < 0.001) {
+          inner[i] = false;
+          ninner--;
+        }
+        if (inner_itr > 50) capped[i] = true;
+      }
+    }
+
+    // update leaf temperatures and check convergence
+    for (int i=0; i!=n; ++i) {
+      if (!active[i]) continue;
+      myA[i] = (1.0 - theta_cj) * std::max(Wc[i], Wj[i]) + theta_cj * std::min(Wc[i], Wj[i]);
+      double lamda = (2501000 - 2400 * tleafnew[i]) * 14.0 / 1000 * 1.0 / 1000000; // J/kg to J/mol to J/umol;
+      myET[i] =  gs_mol[i] * gb_mol[i] / (gb_mol[i] + gs_mol[i]) * std::max(0.0, ei[i] - ea) / pressure; //unit: umol H20/m2 leaf/s
+      tleafnew[i] = tair + 1 / 38.4 * (ARAD[i] - (lamda * myET[i]));
+
+      if (itr > 10 || std::abs((tleafnew[i] - tleafold[i]) / tleafnew[i]) < 0.001) {
+        active[i] = false;
+        nactive--;
+      }
+      if (itr > 10) capped[i] = true;
+    }
+  }
+
+  int ncapped = 0;
+  for (int i=0; i!=n; ++i) {
+    if (!lit[i]) continue;
+    if (capped[i]) ncapped++;
+    tleaf[i] = tleafnew[i];
+    Resp[i] = Vcmax[i] * 0.0089; //maintenance respiration
+    if (tleafnew[i] < -1.0) Resp[i] *= 0.1;
+    A[i] = myA[i];
+    ET[i] = myET[i]; //unit: umol H20/m2 leaf/s
+  }
+  return ncapped;
+}
+
+} // namespace
+
+
+int PhotosynthesisBatch(int n, const double* PARi, const double* LUE, const double* LER,
+                         double pressure, double windv, double tair, double relh, double CO2a,
+                         const double* mp, const double* Vcmax25,
+                         double* A, double* tleaf, double* Resp, double* ET)
+{
+  int ncapped = 0;
+  for (int start=0; start < n; start += PHOTOSYNTHESIS_BLOCK) {
+    int m = std::min(PHOTOSYNTHESIS_BLOCK, n - start);
+    ncapped += PhotosynthesisBlock(m, PARi+start, LUE+start, LER+start, pressure, windv, tair, relh, CO2a,
+                        mp+start, Vcmax25+start, A+start, tleaf+start, Resp+start, ET+start);
+  }
+  return ncapped;
+}
+
+
 // This function calculate the net photosynthetic rate based on Farquhar
 // model, with updated leaf temperature based on energy balances
 void Photosynthesis0(double PARi, double LUE, double LER, double pressure, double windv,
@@ -22,6 +22,11 @@ class QSat {
   void operator()(double tleafk, double pressure,
                   double* es, double* esdT, double* qs, double* qsdT);
 
+  // Batched version over n leaf temperatures, branch free so that it
+  // vectorizes.
+  void operator()(int n, const double* tleafk, double pressure,
+                  double* es, double* esdT, double* qs, double* qsdT);
+
  private:
   double a0, a1, a2, a3, a4, a5, a6, a7, a8;
   double b0, b1, b2, b3, b4, b5, b6, b7, b8;
@@ -35,6 +40,9 @@ double DayLength(double lat, int doy);
 // Limit the highest temp?
 double HighTLim(double tleaf);
 
+// Batched version of HighTLim over n leaf temperatures.
+void HighTLim(int n, const double* tleaf, double* lim);
+
 //solve the quadratic equation
 void Quadratic (double a, double b, double c, double* r1, double* r2) ;
 
@@ -43,6 +51,18 @@ void Quadratic (double a, double b, double c, double* r1, double* r2) ;
 void Photosynthesis(double PARi, double LUE, double LER, double pressure, double windv,
                     double tair, double relh, double CO2a, double mp, double Vcmax25,
                     double* A, double* tleaf, double* Resp, double *ET);
+
+// Batched version of Photosynthesis for n leaves sharing the same atmospheric
+// forcing, e.g. all leaf layers of all PFTs in a column.  Per-leaf inputs and
+// outputs are arrays of length n.  Leaves are iterated together, each
+// dropping out of the fixed point iterations as it converges, so results
+// match calling Photosynthesis on each leaf.  Returns the number of leaves
+// whose iterations stopped at their limit rather than converging.
+int PhotosynthesisBatch(int n, const double* PARi, const double* LUE, const double* LER,
+                         double pressure, double windv, double tair, double relh, double CO2a,
+                         const double* mp, const double* Vcmax25,
+                         double* A, double* tleaf, double* Resp, double* ET);
+
 //// This function calculate the net photosynthetic rate based on Farquhar
 // model, with updated leaf temperature based on energy balances by jointly solving light and RUBISCO-limited carboxylations
 void Photosynthesis0(double PARi, double LUE, double LER, double pressure, double windv,
@@ -0,0 +1,56 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Helpers for per-cell debugging output through a Debugger.
+
+/*
+  ATS is released under the three-clause BSD License.
+  The terms of use and "as is" disclaimer for this license are
+  provided in the top-level COPYRIGHT file.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+
+/*!
+
+Per-cell diagnostics inside cell loops should never write to ``std::cout``
+directly.  Instead, they go through the ``VerboseObject`` of a cell selected
+in the Debugger (`"debug cells`" in the PK or evaluator list), and only
+when the owner's verbosity is at least the requested level:
+
+.. code-block:: c++
+
+    Teuchos::RCP<VerboseObject> dcvo = GetDebugCellVerboseObject(vo_, db_, c, rank);
+    if (dcvo != Teuchos::null) *dcvo->os() << "Cell " << c << ": ..." << std::endl;
+
+When the owner's verbosity is below the requested level this is a single
+branch per cell, so it costs nothing in production runs.
+
+*/
+
+#ifndef ATS_DEBUGGER_HELPERS_HH_
+#define ATS_DEBUGGER_HELPERS_HH_
+
+#include "Teuchos_RCP.hpp"
+#include "VerboseObject.hh"
+#include "Debugger.hh"
+
+namespace Amanzi {
+
+// Returns the VerboseObject for cell c if c is a debug cell of db and both vo
+// and the cell's VerboseObject are at or above level, otherwise null.
+inline Teuchos::RCP<VerboseObject>
+GetDebugCellVerboseObject(const Teuchos::RCP<VerboseObject>& vo,
+                          const Teuchos::RCP<Debugger>& db,
+                          AmanziMesh::Entity_ID c, int rank,
+                          Teuchos::EVerbosityLevel level=Teuchos::VERB_HIGH) {
+  if (vo == Teuchos::null || !vo->os_OK(level) || db == Teuchos::null)
+    return Teuchos::null;
+
+  Teuchos::RCP<VerboseObject> dcvo = db->GetVerboseObject(c, rank);
+  if (dcvo != Teuchos::null && dcvo->os_OK(level)) return dcvo;
+  return Teuchos::null;
+}
+
+} // namespace
+
+#endif
@@ -19,6 +19,7 @@
 #include "LinearOperatorFactory.hh"
 #include "CompositeVectorFunctionFactory.hh"
 
+#include "debugger_helpers.hh"
 #include "volumetric_deformation.hh"
 
 #define DEBUG 0
@@ -523,6 +524,7 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
       nodal_dz.PutScalar(0.);
       int ncols = mesh_->num_columns(false);
       int z_index = mesh_->space_dimension()-1;
+      int rank = mesh_->get_comm()->MyPID();
       for (int col=0; col!=ncols; ++col) {
 	auto& col_cells = mesh_->cells_of_column(col);
 	auto& col_faces = mesh_->faces_of_column(col);
@@ -537,8 +539,9 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
 	  double dz = mesh_->face_centroid(f_above)[z_index] - mesh_->face_centroid(f_below)[z_index];
 	  face_displacement += -dz * dcell_vol_c[0][col_cells[ci]] / cv[0][col_cells[ci]];
 	  ASSERT(face_displacement >= 0.);
-	  if (face_displacement > 0.) {
-	    std::cout << "  Shifting cell " << col_cells[ci] << ", with personal displacement of " << -dz * dcell_vol_c[0][col_cells[ci]] / cv[0][col_cells[ci]] << " and frac " << -dcell_vol_c[0][col_cells[ci]] / cv[0][col_cells[ci]] << std::endl;
+	  Teuchos::RCP<VerboseObject> dcvo = GetDebugCellVerboseObject(vo_, db_, col_cells[ci], rank);
+	  if (face_displacement > 0. && dcvo != Teuchos::null) {
+	    *dcvo->os() << "  Shifting cell " << col_cells[ci] << ", with personal displacement of " << -dz * dcell_vol_c[0][col_cells[ci]] / cv[0][col_cells[ci]] << " and frac " << -dcell_vol_c[0][col_cells[ci]] / cv[0][col_cells[ci]] << std::endl;
 	  }
 
 	  // shove the face changes into the nodal averages
@@ -717,10 +720,12 @@ bool VolumetricDeformation::AdvanceStep(double t_old, double t_new, bool reinit)
   Epetra_MultiVector& base_poro = *S_next_->GetFieldData(key_, name_)->ViewComponent("cell");
 
   int ncells = base_poro.MyLength();
+  int rank = mesh_->get_comm()->MyPID();
   for (int c=0; c!=ncells; ++c) {
     base_poro[0][c] = 1. - (1. - base_poro_old[0][c]) * cv[0][c]/cv_new[0][c];
-    if (fabs(cv_new[0][c] - cv[0][c]) > 1.e-12) {
-      std::cout << "Deformed Cell " << c << ": V,V_new " << cv[0][c] << " " << cv_new[0][c] << std::endl
+    Teuchos::RCP<VerboseObject> dcvo = GetDebugCellVerboseObject(vo_, db_, c, rank);
+    if (fabs(cv_new[0][c] - cv[0][c]) > 1.e-12 && dcvo != Teuchos::null) {
+      *dcvo->os() << "Deformed Cell " << c << ": V,V_new " << cv[0][c] << " " << cv_new[0][c] << std::endl
 		<< "             result porosity " << base_poro_old[0][c] << " " << base_poro[0][c] << std::endl;
     }
   }  
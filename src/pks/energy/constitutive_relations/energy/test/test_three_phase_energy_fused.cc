@@ -0,0 +1,188 @@
+/*
+  Tests of the three phase energy fused evaluator against the three phase
+  energy evaluator and the internal energy evaluators it fuses.
+*/
+
+#include <cmath>
+#include <string>
+
+#include "UnitTest++.h"
+
+#include "Epetra_MpiComm.h"
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_RCP.hpp"
+
+#include "GeometricModel.hh"
+#include "MeshFactory.hh"
+#include "State.hh"
+#include "primary_variable_field_evaluator.hh"
+
+#include "iem_evaluator.hh"
+#include "iem_linear.hh"
+#include "three_phase_energy_evaluator.hh"
+#include "three_phase_energy_fused_evaluator.hh"
+
+using namespace Amanzi;
+using namespace Amanzi::AmanziMesh;
+
+const int nprimaries = 12;
+const char* primaries[nprimaries] = { "porosity", "base_porosity",
+    "saturation_liquid", "molar_density_liquid", "saturation_ice",
+    "molar_density_ice", "saturation_gas", "molar_density_gas",
+    "internal_energy_gas", "density_rock", "cell_volume", "temperature" };
+
+// A state with the unfused energy, "energy", and the fused energy,
+// "energy_fused", of the same primary variables, which vary from cell to cell
+// across frozen and unfrozen temperatures.
+struct FusedEnergyState {
+  FusedEnergyState() : comm(MPI_COMM_WORLD) {
+    Teuchos::ParameterList region_list;
+    Teuchos::RCP<AmanziGeometry::GeometricModel> gm =
+        Teuchos::rcp(new AmanziGeometry::GeometricModel(3, region_list, &comm));
+
+    FrameworkPreference pref;
+    pref.clear();
+    pref.push_back(MSTK);
+
+    MeshFactory meshfactory(&comm);
+    meshfactory.preference(pref);
+    Teuchos::RCP<Mesh> mesh = meshfactory(0.,0.,0., 1.,1.,1., 3,3,3, gm);
+
+    Teuchos::ParameterList state_list;
+    S = Teuchos::rcp(new State(state_list));
+    S->RegisterDomainMesh(mesh);
+
+    for (int k=0; k!=nprimaries; ++k) {
+      Teuchos::ParameterList pv_plist;
+      pv_plist.set("evaluator name", primaries[k]);
+      S->SetFieldEvaluator(primaries[k],
+                           Teuchos::rcp(new PrimaryVariableFieldEvaluator(pv_plist)));
+      S->RequireField(primaries[k], "test")->SetMesh(mesh)->SetGhosted()
+          ->AddComponent("cell", CELL, 1);
+    }
+
+    // internal energies, linear in temperature
+    const char* iem_keys[3] = { "internal_energy_liquid",
+                                "internal_energy_ice",
+                                "internal_energy_rock" };
+    for (int k=0; k!=3; ++k) {
+      Teuchos::ParameterList iem_plist;
+      iem_plist.set("evaluator name", iem_keys[k]);
+      iem_plist.set("temperature key", "temperature");
+      Teuchos::ParameterList& iem_params = iem_plist.sublist("IEM parameters");
+      if (k == 0) {
+        iem_params.set("heat capacity [J/mol-K]", 76.0);
+        iem_params.set("latent heat [J/mol]", 6007.);
+      } else if (k == 1) {
+        iem_params.set("heat capacity [J/mol-K]", 37.7);
+      } else {
+        iem_params.set("heat capacity [J/kg-K]", 620.0);
+      }
+      Teuchos::RCP<Energy::IEM> iem = Teuchos::rcp(new Energy::IEMLinear(iem_params));
+      S->SetFieldEvaluator(iem_keys[k],
+                           Teuchos::rcp(new Energy::IEMEvaluator(iem_plist, iem)));
+    }
+
+    Teuchos::ParameterList e_plist;
+    e_plist.set("evaluator name", "energy");
+    S->SetFieldEvaluator("energy",
+            Teuchos::rcp(new Energy::Relations::ThreePhaseEnergyEvaluator(e_plist)));
+    S->RequireField("energy")->SetMesh(mesh)->SetGhosted()
+        ->AddComponent("cell", CELL, 1);
+
+    Teuchos::ParameterList ef_plist;
+    ef_plist.set("evaluator name", "energy_fused");
+    S->SetFieldEvaluator("energy_fused",
+            Teuchos::rcp(new Energy::Relations::ThreePhaseEnergyFusedEvaluator(ef_plist)));
+    S->RequireField("energy_fused")->SetMesh(mesh)->SetGhosted()
+        ->AddComponent("cell", CELL, 1);
+
+    S->Setup();
+
+    for (int k=0; k!=nprimaries; ++k) {
+      Epetra_MultiVector& v =
+          *S->GetFieldData(primaries[k], "test")->ViewComponent("cell", false);
+      for (int c=0; c!=v.MyLength(); ++c) v[0][c] = Value(k, c);
+      S->GetField(primaries[k], "test")->set_initialized();
+    }
+  }
+
+  double Value(int k, int c) {
+    double x = (c % 7) / 7.;
+    double sl = 0.1 + 0.6 * x;
+    double si = 0.25 * (1. - x);
+    switch (k) {
+      case 0: return 0.2 + 0.3 * x;                  // porosity
+      case 1: return 0.25 + 0.2 * x;                 // base porosity
+      case 2: return sl;
+      case 3: return 55000. + 500. * x;              // molar density liquid
+      case 4: return si;
+      case 5: return 50000. + 300. * x;              // molar density ice
+      case 6: return 1. - sl - si;
+      case 7: return 40. + 2. * x;                   // molar density gas
+      case 8: return 2.5e-3 + 1.e-4 * x;             // internal energy gas
+      case 9: return 2170. + 100. * x;               // density rock
+      case 10: return 1. / 27.;                      // cell volume
+      default: return 263.15 + (c % 5) * 5.;         // temperature
+    }
+  }
+
+  // Checks that the fused and unfused fields, or their derivatives with
+  // respect to wrt, agree.
+  void CheckAgree(const std::string& wrt="") {
+    Key key = "energy", key_fused = "energy_fused";
+    if (wrt.empty()) {
+      S->GetFieldEvaluator(key)->HasFieldChanged(S.ptr(), "test");
+      S->GetFieldEvaluator(key_fused)->HasFieldChanged(S.ptr(), "test");
+    } else {
+      S->GetFieldEvaluator(key)->HasFieldDerivativeChanged(S.ptr(), "test", wrt);
+      S->GetFieldEvaluator(key_fused)->HasFieldDerivativeChanged(S.ptr(), "test", wrt);
+      key = Keys::getDerivKey(key, wrt);
+      key_fused = Keys::getDerivKey(key_fused, wrt);
+    }
+
+    const Epetra_MultiVector& e =
+        *S->GetFieldData(key)->ViewComponent("cell", false);
+    const Epetra_MultiVector& e_fused =
+        *S->GetFieldData(key_fused)->ViewComponent("cell", false);
+    CHECK_EQUAL(e.MyLength(), e_fused.MyLength());
+    for (int c=0; c!=e.MyLength(); ++c) {
+      CHECK_CLOSE(e[0][c], e_fused[0][c], 1.e-12 * std::abs(e[0][c]) + 1.e-15);
+    }
+  }
+
+  Epetra_MpiComm comm;
+  Teuchos::RCP<State> S;
+};
+
+
+SUITE(THREE_PHASE_ENERGY_FUSED) {
+
+  TEST_FIXTURE(FusedEnergyState, ENERGY_MATCHES_UNFUSED) {
+    CheckAgree();
+  }
+
+  // The temperature derivative is the chain rule through the internal
+  // energies when unfused, and is evaluated inline when fused.
+  TEST_FIXTURE(FusedEnergyState, TEMPERATURE_DERIVATIVE_MATCHES_UNFUSED) {
+    CheckAgree("temperature");
+  }
+
+  TEST_FIXTURE(FusedEnergyState, OTHER_DERIVATIVES_MATCH_UNFUSED) {
+    for (int k=0; k!=nprimaries-1; ++k) CheckAgree(primaries[k]);
+  }
+
+  // A changed temperature must reach the fused energy, which no longer
+  // depends upon the internal energies.
+  TEST_FIXTURE(FusedEnergyState, FUSED_ENERGY_TRACKS_TEMPERATURE) {
+    CheckAgree();
+
+    Epetra_MultiVector& temp =
+        *S->GetFieldData("temperature", "test")->ViewComponent("cell", false);
+    for (int c=0; c!=temp.MyLength(); ++c) temp[0][c] -= 20.;
+    Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(
+        S->GetFieldEvaluator("temperature"))->SetFieldAsChanged(S.ptr());
+    CheckAgree();
+    CheckAgree("temperature");
+  }
+}
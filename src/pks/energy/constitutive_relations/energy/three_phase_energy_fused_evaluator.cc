@@ -0,0 +1,225 @@
+/*
+  The three phase energy fused evaluator is the three phase energy evaluator
+  with the liquid, ice, and rock internal energies evaluated inline.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "errors.hh"
+#include "iem.hh"
+#include "iem_evaluator.hh"
+#include "three_phase_energy_fused_evaluator.hh"
+#include "three_phase_energy_model.hh"
+
+namespace Amanzi {
+namespace Energy {
+namespace Relations {
+
+// Constructor from ParameterList
+ThreePhaseEnergyFusedEvaluator::ThreePhaseEnergyFusedEvaluator(Teuchos::ParameterList& plist) :
+    ThreePhaseEnergyEvaluator(plist)
+{
+  // the internal energies are replaced by the temperature they are a
+  // function of
+  dependencies_.erase(ul_key_);
+  dependencies_.erase(ui_key_);
+  dependencies_.erase(ur_key_);
+
+  Key domain_name = Keys::getDomainPrefix(my_key_);
+  temp_key_ = plist_.get<std::string>("temperature key",
+          domain_name+"temperature");
+  dependencies_.insert(temp_key_);
+}
+
+
+// Copy constructor
+ThreePhaseEnergyFusedEvaluator::ThreePhaseEnergyFusedEvaluator(const ThreePhaseEnergyFusedEvaluator& other) :
+    ThreePhaseEnergyEvaluator(other),
+    temp_key_(other.temp_key_),
+    iem_liquid_(other.iem_liquid_),
+    iem_ice_(other.iem_ice_),
+    iem_rock_(other.iem_rock_) {}
+
+
+// Virtual copy constructor
+Teuchos::RCP<FieldEvaluator>
+ThreePhaseEnergyFusedEvaluator::Clone() const
+{
+  return Teuchos::rcp(new ThreePhaseEnergyFusedEvaluator(*this));
+}
+
+
+void
+ThreePhaseEnergyFusedEvaluator::EnsureCompatibility(const Teuchos::Ptr<State>& S)
+{
+  if (iem_liquid_ == Teuchos::null) {
+    iem_liquid_ = GetIEM_(S, ul_key_);
+    iem_ice_ = GetIEM_(S, ui_key_);
+    iem_rock_ = GetIEM_(S, ur_key_);
+  }
+  ThreePhaseEnergyEvaluator::EnsureCompatibility(S);
+}
+
+
+Teuchos::RCP<IEM>
+ThreePhaseEnergyFusedEvaluator::GetIEM_(const Teuchos::Ptr<State>& S, const Key& key)
+{
+  Teuchos::RCP<IEMEvaluator> iem_me =
+      Teuchos::rcp_dynamic_cast<IEMEvaluator>(S->RequireFieldEvaluator(key));
+  if (iem_me == Teuchos::null) {
+    Errors::Message msg;
+    msg << "ThreePhaseEnergyFusedEvaluator for \"" << my_key_ << "\": evaluator for \""
+        << key << "\" must be of type \"iem\" to be fused.";
+    Exceptions::amanzi_throw(msg);
+  }
+  return iem_me->get_IEM();
+}
+
+
+void
+ThreePhaseEnergyFusedEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
+        const Teuchos::Ptr<CompositeVector>& result)
+{
+  Teuchos::RCP<const CompositeVector> phi = S->GetFieldData(phi_key_);
+  Teuchos::RCP<const CompositeVector> phi0 = S->GetFieldData(phi0_key_);
+  Teuchos::RCP<const CompositeVector> sl = S->GetFieldData(sl_key_);
+  Teuchos::RCP<const CompositeVector> nl = S->GetFieldData(nl_key_);
+  Teuchos::RCP<const CompositeVector> si = S->GetFieldData(si_key_);
+  Teuchos::RCP<const CompositeVector> ni = S->GetFieldData(ni_key_);
+  Teuchos::RCP<const CompositeVector> sg = S->GetFieldData(sg_key_);
+  Teuchos::RCP<const CompositeVector> ng = S->GetFieldData(ng_key_);
+  Teuchos::RCP<const CompositeVector> ug = S->GetFieldData(ug_key_);
+  Teuchos::RCP<const CompositeVector> rho_r = S->GetFieldData(rho_r_key_);
+  Teuchos::RCP<const CompositeVector> cv = S->GetFieldData(cv_key_);
+  Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
+
+  for (CompositeVector::name_iterator comp=result->begin();
+       comp!=result->end(); ++comp) {
+    const Epetra_MultiVector& phi_v = *phi->ViewComponent(*comp, false);
+    const Epetra_MultiVector& phi0_v = *phi0->ViewComponent(*comp, false);
+    const Epetra_MultiVector& sl_v = *sl->ViewComponent(*comp, false);
+    const Epetra_MultiVector& nl_v = *nl->ViewComponent(*comp, false);
+    const Epetra_MultiVector& si_v = *si->ViewComponent(*comp, false);
+    const Epetra_MultiVector& ni_v = *ni->ViewComponent(*comp, false);
+    const Epetra_MultiVector& sg_v = *sg->ViewComponent(*comp, false);
+    const Epetra_MultiVector& ng_v = *ng->ViewComponent(*comp, false);
+    const Epetra_MultiVector& ug_v = *ug->ViewComponent(*comp, false);
+    const Epetra_MultiVector& rho_r_v = *rho_r->ViewComponent(*comp, false);
+    const Epetra_MultiVector& cv_v = *cv->ViewComponent(*comp, false);
+    const Epetra_MultiVector& temp_v = *temp->ViewComponent(*comp, false);
+    Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
+
+    int ncomp = result->size(*comp, false);
+    for (int i=0; i!=ncomp; ++i) {
+      double T = temp_v[0][i];
+      result_v[0][i] = model_->Energy(phi_v[0][i], phi0_v[0][i],
+              sl_v[0][i], nl_v[0][i], iem_liquid_->InternalEnergy(T),
+              si_v[0][i], ni_v[0][i], iem_ice_->InternalEnergy(T),
+              sg_v[0][i], ng_v[0][i], ug_v[0][i],
+              rho_r_v[0][i], iem_rock_->InternalEnergy(T), cv_v[0][i]);
+    }
+  }
+}
+
+
+void
+ThreePhaseEnergyFusedEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+        Key wrt_key, const Teuchos::Ptr<CompositeVector>& result)
+{
+  typedef double (ThreePhaseEnergyModel::*Derivative)(double, double, double,
+          double, double, double, double, double, double, double, double,
+          double, double, double) const;
+
+  // all partials but temperature are the model's, evaluated at the inline
+  // internal energies
+  Derivative deriv = NULL;
+  if (wrt_key == phi_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDPorosity;
+  } else if (wrt_key == phi0_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDBasePorosity;
+  } else if (wrt_key == sl_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDSaturationLiquid;
+  } else if (wrt_key == nl_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDMolarDensityLiquid;
+  } else if (wrt_key == si_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDSaturationIce;
+  } else if (wrt_key == ni_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDMolarDensityIce;
+  } else if (wrt_key == sg_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDSaturationGas;
+  } else if (wrt_key == ng_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDMolarDensityGas;
+  } else if (wrt_key == ug_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDInternalEnergyGas;
+  } else if (wrt_key == rho_r_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDDensityRock;
+  } else if (wrt_key == cv_key_) {
+    deriv = &ThreePhaseEnergyModel::DEnergyDCellVolume;
+  } else {
+    ASSERT(wrt_key == temp_key_);
+  }
+
+  Teuchos::RCP<const CompositeVector> phi = S->GetFieldData(phi_key_);
+  Teuchos::RCP<const CompositeVector> phi0 = S->GetFieldData(phi0_key_);
+  Teuchos::RCP<const CompositeVector> sl = S->GetFieldData(sl_key_);
+  Teuchos::RCP<const CompositeVector> nl = S->GetFieldData(nl_key_);
+  Teuchos::RCP<const CompositeVector> si = S->GetFieldData(si_key_);
+  Teuchos::RCP<const CompositeVector> ni = S->GetFieldData(ni_key_);
+  Teuchos::RCP<const CompositeVector> sg = S->GetFieldData(sg_key_);
+  Teuchos::RCP<const CompositeVector> ng = S->GetFieldData(ng_key_);
+  Teuchos::RCP<const CompositeVector> ug = S->GetFieldData(ug_key_);
+  Teuchos::RCP<const CompositeVector> rho_r = S->GetFieldData(rho_r_key_);
+  Teuchos::RCP<const CompositeVector> cv = S->GetFieldData(cv_key_);
+  Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
+
+  for (CompositeVector::name_iterator comp=result->begin();
+       comp!=result->end(); ++comp) {
+    const Epetra_MultiVector& phi_v = *phi->ViewComponent(*comp, false);
+    const Epetra_MultiVector& phi0_v = *phi0->ViewComponent(*comp, false);
+    const Epetra_MultiVector& sl_v = *sl->ViewComponent(*comp, false);
+    const Epetra_MultiVector& nl_v = *nl->ViewComponent(*comp, false);
+    const Epetra_MultiVector& si_v = *si->ViewComponent(*comp, false);
+    const Epetra_MultiVector& ni_v = *ni->ViewComponent(*comp, false);
+    const Epetra_MultiVector& sg_v = *sg->ViewComponent(*comp, false);
+    const Epetra_MultiVector& ng_v = *ng->ViewComponent(*comp, false);
+    const Epetra_MultiVector& ug_v = *ug->ViewComponent(*comp, false);
+    const Epetra_MultiVector& rho_r_v = *rho_r->ViewComponent(*comp, false);
+    const Epetra_MultiVector& cv_v = *cv->ViewComponent(*comp, false);
+    const Epetra_MultiVector& temp_v = *temp->ViewComponent(*comp, false);
+    Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
+
+    int ncomp = result->size(*comp, false);
+    for (int i=0; i!=ncomp; ++i) {
+      double T = temp_v[0][i];
+      double ul = iem_liquid_->InternalEnergy(T);
+      double ui = iem_ice_->InternalEnergy(T);
+      double ur = iem_rock_->InternalEnergy(T);
+
+      if (deriv) {
+        result_v[0][i] = (model_.get()->*deriv)(phi_v[0][i], phi0_v[0][i],
+                sl_v[0][i], nl_v[0][i], ul, si_v[0][i], ni_v[0][i], ui,
+                sg_v[0][i], ng_v[0][i], ug_v[0][i], rho_r_v[0][i], ur, cv_v[0][i]);
+      } else {
+        // chain rule through the internal energies
+        result_v[0][i] =
+            model_->DEnergyDInternalEnergyLiquid(phi_v[0][i], phi0_v[0][i],
+                sl_v[0][i], nl_v[0][i], ul, si_v[0][i], ni_v[0][i], ui,
+                sg_v[0][i], ng_v[0][i], ug_v[0][i], rho_r_v[0][i], ur, cv_v[0][i])
+            * iem_liquid_->DInternalEnergyDT(T)
+          + model_->DEnergyDInternalEnergyIce(phi_v[0][i], phi0_v[0][i],
+                sl_v[0][i], nl_v[0][i], ul, si_v[0][i], ni_v[0][i], ui,
+                sg_v[0][i], ng_v[0][i], ug_v[0][i], rho_r_v[0][i], ur, cv_v[0][i])
+            * iem_ice_->DInternalEnergyDT(T)
+          + model_->DEnergyDInternalEnergyRock(phi_v[0][i], phi0_v[0][i],
+                sl_v[0][i], nl_v[0][i], ul, si_v[0][i], ni_v[0][i], ui,
+                sg_v[0][i], ng_v[0][i], ug_v[0][i], rho_r_v[0][i], ur, cv_v[0][i])
+            * iem_rock_->DInternalEnergyDT(T);
+      }
+    }
+  }
+}
+
+
+} //namespace
+} //namespace
+} //namespace
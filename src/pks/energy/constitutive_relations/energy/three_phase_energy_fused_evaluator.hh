@@ -0,0 +1,76 @@
+/*
+  The three phase energy fused evaluator is the three phase energy evaluator
+  with the liquid, ice, and rock internal energies evaluated inline.
+
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+/*!
+
+Evaluates the same model as `"three phase energy`", but instead of depending
+upon the `"internal_energy_liquid`", `"internal_energy_ice`", and
+`"internal_energy_rock`" fields, it depends upon temperature and evaluates
+those internal energies per cell, in the same sweep as the energy, using the
+IEMs of those fields' evaluators.  This removes three cell sweeps and their
+field reads and writes from each evaluation of energy and of its temperature
+derivative; the internal energy fields are only evaluated if something else
+depends upon them.
+
+The internal energy evaluators must still be in the `"field evaluators`"
+list, and must be of type `"iem`", as their IEMs are used here.
+
+* `"temperature key`" ``[string]`` **DOMAIN-temperature**
+
+All other parameters are as in `"three phase energy`".
+
+*/
+
+#ifndef AMANZI_ENERGY_THREE_PHASE_ENERGY_FUSED_EVALUATOR_HH_
+#define AMANZI_ENERGY_THREE_PHASE_ENERGY_FUSED_EVALUATOR_HH_
+
+#include "three_phase_energy_evaluator.hh"
+
+namespace Amanzi {
+namespace Energy {
+
+class IEM;
+
+namespace Relations {
+
+class ThreePhaseEnergyFusedEvaluator : public ThreePhaseEnergyEvaluator {
+
+ public:
+  explicit
+  ThreePhaseEnergyFusedEvaluator(Teuchos::ParameterList& plist);
+  ThreePhaseEnergyFusedEvaluator(const ThreePhaseEnergyFusedEvaluator& other);
+
+  virtual Teuchos::RCP<FieldEvaluator> Clone() const;
+
+  virtual void EnsureCompatibility(const Teuchos::Ptr<State>& S);
+
+  // Required methods from SecondaryVariableFieldEvaluator
+  virtual void EvaluateField_(const Teuchos::Ptr<State>& S,
+          const Teuchos::Ptr<CompositeVector>& result);
+  virtual void EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+          Key wrt_key, const Teuchos::Ptr<CompositeVector>& result);
+
+ protected:
+  Teuchos::RCP<IEM> GetIEM_(const Teuchos::Ptr<State>& S, const Key& key);
+
+ protected:
+  Key temp_key_;
+
+  Teuchos::RCP<IEM> iem_liquid_;
+  Teuchos::RCP<IEM> iem_ice_;
+  Teuchos::RCP<IEM> iem_rock_;
+
+ private:
+  static Utils::RegisteredFactory<FieldEvaluator,ThreePhaseEnergyFusedEvaluator> reg_;
+
+};
+
+} //namespace
+} //namespace
+} //namespace
+
+#endif
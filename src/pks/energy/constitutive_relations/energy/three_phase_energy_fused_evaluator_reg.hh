@@ -0,0 +1,11 @@
+#include "three_phase_energy_fused_evaluator.hh"
+
+namespace Amanzi {
+namespace Energy {
+namespace Relations {
+
+Utils::RegisteredFactory<FieldEvaluator,ThreePhaseEnergyFusedEvaluator> ThreePhaseEnergyFusedEvaluator::reg_("three phase energy fused");
+
+} //namespace
+} //namespace
+} //namespace
@@ -0,0 +1,123 @@
+#include "UnitTest++.h"
+#include "TestReporterStdout.h"
+
+#include <cmath>
+#include <vector>
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "thermal_conductivity_threephase_peterslidard.hh"
+#include "thermal_conductivity_threephase_wetdry.hh"
+#include "thermal_conductivity_threephase_volume_averaged.hh"
+
+using namespace Amanzi::Energy;
+
+// Cells spanning porosity, liquid and ice saturation, and temperature, with
+// room for finite differences around each.  Saturated cells have no gas.
+struct TestCells {
+  int n;
+  std::vector<double> poro, sl, si, temp;
+
+  explicit TestCells(bool saturated) : n(1003), poro(n), sl(n), si(n), temp(n) {
+    for (int i=0; i!=n; ++i) {
+      poro[i] = 0.1 + 0.8 * (i % 97) / 97.;
+      sl[i] = 0.01 + 0.98 * (i % 13) / 13.;
+      si[i] = saturated ? 1. - sl[i] : 0.9 * (1. - sl[i]) * (i % 7) / 7.;
+      temp[i] = 250. + (i % 40);
+    }
+  }
+};
+
+Teuchos::ParameterList TestParameters() {
+  Teuchos::ParameterList plist;
+  plist.set("unsaturated alpha unfrozen [-]", 0.5);
+  plist.set("unsaturated alpha frozen [-]", 1.0);
+  plist.set("thermal conductivity of soil [W/(m-K)]", 2.0);
+  plist.set("thermal conductivity of ice [W/(m-K)]", 2.1);
+  plist.set("thermal conductivity of liquid [W/(m-K)]", 0.6);
+  plist.set("thermal conductivity of gas [W/(m-K)]", 0.02);
+  plist.set("thermal conductivity, dry [W/(m-K)]", 0.3);
+  plist.set("thermal conductivity, saturated (unfrozen) [W/(m-K)]", 1.5);
+  return plist;
+}
+
+// The batched values, with and without porosity terms, must match the
+// per-cell method, and the batched derivatives must match centered finite
+// differences of it.  Saturation derivatives of models that require saturated
+// cells cannot be differenced one saturation at a time, and are not checked.
+void CheckBatched(ThermalConductivityThreePhase& tc, bool saturated=false) {
+  TestCells cells(saturated);
+  int n = cells.n;
+  std::vector<double> k(n), dk_dporo(n), dk_dsl(n), dk_dsi(n), dk_dtemp(n);
+  tc.ThermalConductivities(n, &cells.poro[0], &cells.sl[0], &cells.si[0], &cells.temp[0], NULL,
+                           &k[0], &dk_dporo[0], &dk_dsl[0], &dk_dsi[0], &dk_dtemp[0]);
+
+  std::vector<double> k_terms(n);
+  std::vector<double> terms(tc.NumPorosityTerms()*n + 1);
+  if (tc.NumPorosityTerms() > 0) {
+    tc.PorosityTerms(n, &cells.poro[0], &terms[0]);
+    tc.ThermalConductivities(n, &cells.poro[0], &cells.sl[0], &cells.si[0], &cells.temp[0], &terms[0],
+                             &k_terms[0], NULL, NULL, NULL, NULL);
+  }
+
+  double h = 1.e-6;
+  double h_temp = 1.e-4;
+  for (int i=0; i!=n; ++i) {
+    double p = cells.poro[i], sl = cells.sl[i], si = cells.si[i], T = cells.temp[i];
+    double k_s = tc.ThermalConductivity(p, sl, si, T);
+    CHECK_CLOSE(k_s, k[i], 1.e-12 * k_s);
+    if (tc.NumPorosityTerms() > 0) CHECK_CLOSE(k_s, k_terms[i], 1.e-12 * k_s);
+
+    double fd = (tc.ThermalConductivity(p+h, sl, si, T) - tc.ThermalConductivity(p-h, sl, si, T)) / (2*h);
+    CHECK_CLOSE(fd, dk_dporo[i], 1.e-6 * (1. + std::abs(fd)));
+    if (!saturated) {
+      fd = (tc.ThermalConductivity(p, sl+h, si, T) - tc.ThermalConductivity(p, sl-h, si, T)) / (2*h);
+      CHECK_CLOSE(fd, dk_dsl[i], 1.e-6 * (1. + std::abs(fd)));
+      fd = (tc.ThermalConductivity(p, sl, si+h, T) - tc.ThermalConductivity(p, sl, si-h, T)) / (2*h);
+      CHECK_CLOSE(fd, dk_dsi[i], 1.e-6 * (1. + std::abs(fd)));
+    }
+    fd = (tc.ThermalConductivity(p, sl, si, T+h_temp) - tc.ThermalConductivity(p, sl, si, T-h_temp)) / (2*h_temp);
+    CHECK_CLOSE(fd, dk_dtemp[i], 1.e-6 * (1. + std::abs(fd)));
+  }
+}
+
+
+SUITE(THERMAL_CONDUCTIVITY_BATCH) {
+
+  TEST(PETERS_LIDARD) {
+    Teuchos::ParameterList plist = TestParameters();
+    ThermalConductivityThreePhasePetersLidard tc(plist);
+    CheckBatched(tc);
+  }
+
+  TEST(WET_DRY) {
+    Teuchos::ParameterList plist = TestParameters();
+    ThermalConductivityThreePhaseWetDry tc(plist);
+    CheckBatched(tc);
+
+    // this model also has per-cell derivatives
+    TestCells cells(false);
+    int n = cells.n;
+    std::vector<double> k(n), dk_dporo(n), dk_dsl(n), dk_dsi(n), dk_dtemp(n);
+    tc.ThermalConductivities(n, &cells.poro[0], &cells.sl[0], &cells.si[0], &cells.temp[0], NULL,
+                             &k[0], &dk_dporo[0], &dk_dsl[0], &dk_dsi[0], &dk_dtemp[0]);
+    for (int i=0; i!=n; ++i) {
+      double p = cells.poro[i], sl = cells.sl[i], si = cells.si[i], T = cells.temp[i];
+      double d = tc.DThermalConductivity_DPorosity(p, sl, si, T);
+      CHECK_CLOSE(d, dk_dporo[i], 1.e-12 * (1. + std::abs(d)));
+      d = tc.DThermalConductivity_DSaturationLiquid(p, sl, si, T);
+      CHECK_CLOSE(d, dk_dsl[i], 1.e-12 * (1. + std::abs(d)));
+      d = tc.DThermalConductivity_DSaturationIce(p, sl, si, T);
+      CHECK_CLOSE(d, dk_dsi[i], 1.e-12 * (1. + std::abs(d)));
+      d = tc.DThermalConductivity_DTemperature(p, sl, si, T);
+      CHECK_CLOSE(d, dk_dtemp[i], 1.e-12 * (1. + std::abs(d)));
+    }
+  }
+
+  TEST(VOLUME_AVERAGED) {
+    Teuchos::ParameterList plist = TestParameters();
+    ThermalConductivityThreePhaseVolumeAveraged tc(plist);
+    CheckBatched(tc, true);
+  }
+
+}
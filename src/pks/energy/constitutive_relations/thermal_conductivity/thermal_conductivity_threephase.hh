@@ -14,6 +14,8 @@ UNITS: ????
 #ifndef PK_ENERGY_RELATIONS_TC_THREEPHASE_HH_
 #define PK_ENERGY_RELATIONS_TC_THREEPHASE_HH_
 
+#include <cmath>
+
 #include "dbc.hh"
 
 namespace Amanzi {
@@ -41,6 +43,45 @@ public:
     ASSERT(false);
     return 0.;
   }
+
+  // Terms of the conductivity that depend only on porosity, which callers may
+  // compute once with PorosityTerms() and reuse while porosity is unchanged.
+  // They are stored term-major, terms[i*n + c] for n cells.
+  virtual int NumPorosityTerms() const { return 0; }
+  virtual void PorosityTerms(int n, const double* porosity, double* terms) {}
+
+  // Conductivity and its derivatives for n cells, in one sweep.  Only the
+  // non-NULL outputs are computed.  poro_terms may be NULL, or the result of
+  // PorosityTerms() for this porosity.  The default calls the per-cell
+  // methods.
+  virtual void ThermalConductivities(int n, const double* porosity,
+          const double* sat_liq, const double* sat_ice, const double* temp,
+          const double* poro_terms,
+          double* k, double* dk_dporosity, double* dk_dsat_liq,
+          double* dk_dsat_ice, double* dk_dtemp) {
+    for (int c=0; c!=n; ++c) {
+      if (k) k[c] = ThermalConductivity(porosity[c], sat_liq[c], sat_ice[c], temp[c]);
+      if (dk_dporosity) dk_dporosity[c] = DThermalConductivity_DPorosity(porosity[c], sat_liq[c], sat_ice[c], temp[c]);
+      if (dk_dsat_liq) dk_dsat_liq[c] = DThermalConductivity_DSaturationLiquid(porosity[c], sat_liq[c], sat_ice[c], temp[c]);
+      if (dk_dsat_ice) dk_dsat_ice[c] = DThermalConductivity_DSaturationIce(porosity[c], sat_liq[c], sat_ice[c], temp[c]);
+      if (dk_dtemp) dk_dtemp[c] = DThermalConductivity_DTemperature(porosity[c], sat_liq[c], sat_ice[c], temp[c]);
+    }
+  }
+
+ protected:
+  // Kersten numbers (s + eps)^alpha, and their derivatives if dkersten is
+  // not NULL, for n cells.  The common alpha of 1 avoids pow.
+  static void Kersten_(int n, const double* s, double eps, double alpha,
+                       double* kersten, double* dkersten) {
+    if (alpha == 1.) {
+      for (int c=0; c!=n; ++c) kersten[c] = s[c] + eps;
+      if (dkersten) for (int c=0; c!=n; ++c) dkersten[c] = 1.;
+    } else {
+      for (int c=0; c!=n; ++c) kersten[c] = std::pow(s[c] + eps, alpha);
+      if (dkersten)
+        for (int c=0; c!=n; ++c) dkersten[c] = alpha * kersten[c] / (s[c] + eps);
+    }
+  }
 };
 
 } // namespace
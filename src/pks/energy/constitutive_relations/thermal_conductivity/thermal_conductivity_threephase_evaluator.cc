@@ -8,6 +8,8 @@
   Satish Karra (satkarra@lanl.gov)
 */
 
+#include <algorithm>
+
 #include "dbc.hh"
 #include "thermal_conductivity_threephase_factory.hh"
 #include "thermal_conductivity_threephase_evaluator.hh"
@@ -64,7 +66,11 @@ ThermalConductivityThreePhaseEvaluator::ThermalConductivityThreePhaseEvaluator(
     temp_key_(other.temp_key_),
     sat_key_(other.sat_key_),
     sat2_key_(other.sat2_key_),
-    tcs_(other.tcs_) {}
+    tcs_(other.tcs_),
+    region_cells_(other.region_cells_),
+    region_contiguous_(other.region_contiguous_),
+    poro_terms_(other.poro_terms_),
+    poro_terms_porosity_(other.poro_terms_porosity_) {}
 
 Teuchos::RCP<FieldEvaluator>
 ThermalConductivityThreePhaseEvaluator::Clone() const {
@@ -75,12 +81,13 @@ ThermalConductivityThreePhaseEvaluator::Clone() const {
 void ThermalConductivityThreePhaseEvaluator::EvaluateField_(
     const Teuchos::Ptr<State>& S,
     const Teuchos::Ptr<CompositeVector>& result) {
+  if (region_cells_.size() == 0) InitializeRegionCells_(*result->Mesh());
+
   // pull out the dependencies
   Teuchos::RCP<const CompositeVector> poro = S->GetFieldData(poro_key_);
   Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
   Teuchos::RCP<const CompositeVector> sat = S->GetFieldData(sat_key_);
   Teuchos::RCP<const CompositeVector> sat2 = S->GetFieldData(sat2_key_);
-  Teuchos::RCP<const AmanziMesh::Mesh> mesh = result->Mesh();
 
   for (CompositeVector::name_iterator comp = result->begin();
        comp!=result->end(); ++comp) {
@@ -91,26 +98,8 @@ void ThermalConductivityThreePhaseEvaluator::EvaluateField_(
     const Epetra_MultiVector& sat2_v = *sat2->ViewComponent(*comp,false);
     Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
 
-    for (std::vector<RegionModelPair>::const_iterator lcv = tcs_.begin();
-         lcv != tcs_.end(); ++lcv) {
-      std::string region_name = lcv->first;
-      if (mesh->valid_set_name(region_name, AmanziMesh::CELL)) {
-        // get the indices of the domain.
-        AmanziMesh::Entity_ID_List id_list;
-        mesh->get_set_entities(region_name, AmanziMesh::CELL, AmanziMesh::OWNED, &id_list);
-
-        // loop over indices
-        for (AmanziMesh::Entity_ID_List::const_iterator id=id_list.begin();
-             id!=id_list.end(); ++id) {
-          result_v[0][*id] = lcv->second->ThermalConductivity(poro_v[0][*id],
-                  sat_v[0][*id], sat2_v[0][*id], temp_v[0][*id]);
-        }
-      } else {
-        std::stringstream m;
-        m << "Thermal conductivity evaluator: unknown region on cells: \"" << region_name << "\"";
-        Errors::Message message(m.str());
-        Exceptions::amanzi_throw(message);
-      }
+    for (int r=0; r!=tcs_.size(); ++r) {
+      EvaluateRegion_(r, VALUE, poro_v, sat_v, sat2_v, temp_v, result_v);
     }
   }
   result->Scale(1.e-6); // convert to MJ
@@ -120,12 +109,13 @@ void ThermalConductivityThreePhaseEvaluator::EvaluateField_(
 void ThermalConductivityThreePhaseEvaluator::EvaluateFieldPartialDerivative_(
     const Teuchos::Ptr<State>& S, Key wrt_key,
     const Teuchos::Ptr<CompositeVector>& result) {
+  if (region_cells_.size() == 0) InitializeRegionCells_(*result->Mesh());
+
   // pull out the dependencies
   Teuchos::RCP<const CompositeVector> poro = S->GetFieldData(poro_key_);
   Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
   Teuchos::RCP<const CompositeVector> sat = S->GetFieldData(sat_key_);
   Teuchos::RCP<const CompositeVector> sat2 = S->GetFieldData(sat2_key_);
-  Teuchos::RCP<const AmanziMesh::Mesh> mesh = result->Mesh();
 
   for (CompositeVector::name_iterator comp = result->begin();
        comp!=result->end(); ++comp) {
@@ -136,109 +126,117 @@ void ThermalConductivityThreePhaseEvaluator::EvaluateFieldPartialDerivative_(
     const Epetra_MultiVector& sat2_v = *sat2->ViewComponent(*comp,false);
     Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
 
+    Output output = VALUE;
     if (wrt_key == poro_key_) {
-      for (std::vector<RegionModelPair>::const_iterator lcv = tcs_.begin();
-           lcv != tcs_.end(); ++lcv) {
-        std::string region_name = lcv->first;
-        if (mesh->valid_set_name(region_name, AmanziMesh::CELL)) {
-          // get the indices of the domain.
-          AmanziMesh::Entity_ID_List id_list;
-          mesh->get_set_entities(region_name, AmanziMesh::CELL, AmanziMesh::OWNED, &id_list);
-
-          // loop over indices
-          for (AmanziMesh::Entity_ID_List::const_iterator id=id_list.begin();
-               id!=id_list.end(); ++id) {
-            result_v[0][*id] = lcv->second->DThermalConductivity_DPorosity(poro_v[0][*id],
-                                              sat_v[0][*id], sat2_v[0][*id], temp_v[0][*id]);
-          }
-        } else {
-          std::stringstream m;
-          m << "Thermal conductivity evaluator: unknown region on cells: \"" << region_name << "\"";
-          Errors::Message message(m.str());
-          Exceptions::amanzi_throw(message);
-        }
-      }
-      
+      output = D_POROSITY;
     } else if (wrt_key == sat_key_) {
-      for (std::vector<RegionModelPair>::const_iterator lcv = tcs_.begin();
-           lcv != tcs_.end(); ++lcv) {
-        std::string region_name = lcv->first;
-        if (mesh->valid_set_name(region_name, AmanziMesh::CELL)) {
-          // get the indices of the domain.
-          AmanziMesh::Entity_ID_List id_list;
-          mesh->get_set_entities(region_name, AmanziMesh::CELL, AmanziMesh::OWNED, &id_list);
-
-          // loop over indices
-          for (AmanziMesh::Entity_ID_List::const_iterator id=id_list.begin();
-               id!=id_list.end(); ++id) {
-            result_v[0][*id] = lcv->second->DThermalConductivity_DSaturationLiquid(
-                                    poro_v[0][*id], sat_v[0][*id], sat2_v[0][*id], temp_v[0][*id]);
-          }
-        } else {
-          std::stringstream m;
-          m << "Thermal conductivity evaluator: unknown region on cells: \"" << region_name << "\"";
-          Errors::Message message(m.str());
-          Exceptions::amanzi_throw(message);
-        }
-      }
-
+      output = D_SAT_LIQ;
     } else if (wrt_key == sat2_key_) {
-      for (std::vector<RegionModelPair>::const_iterator lcv = tcs_.begin();
-           lcv != tcs_.end(); ++lcv) {
-        std::string region_name = lcv->first;
-        if (mesh->valid_set_name(region_name, AmanziMesh::CELL)) {
-          // get the indices of the domain.
-          AmanziMesh::Entity_ID_List id_list;
-          mesh->get_set_entities(region_name, AmanziMesh::CELL, AmanziMesh::OWNED, &id_list);
-
-          // loop over indices
-          for (AmanziMesh::Entity_ID_List::const_iterator id=id_list.begin();
-               id!=id_list.end(); ++id) {
-            result_v[0][*id] = lcv->second->DThermalConductivity_DSaturationIce(
-                                    poro_v[0][*id], sat_v[0][*id], sat2_v[0][*id], temp_v[0][*id]);
-          }
-        } else {
-          std::stringstream m;
-          m << "Thermal conductivity evaluator: unknown region on cells: \"" << region_name << "\"";
-          Errors::Message message(m.str());
-          Exceptions::amanzi_throw(message);
-        }
-      }
-
+      output = D_SAT_ICE;
     } else if (wrt_key == temp_key_) {
-      for (std::vector<RegionModelPair>::const_iterator lcv = tcs_.begin();
-           lcv != tcs_.end(); ++lcv) {
-        std::string region_name = lcv->first;
-        if (mesh->valid_set_name(region_name, AmanziMesh::CELL)) {
-          // get the indices of the domain.
-          AmanziMesh::Entity_ID_List id_list;
-          mesh->get_set_entities(region_name, AmanziMesh::CELL, AmanziMesh::OWNED, &id_list);
-
-          // loop over indices
-          for (AmanziMesh::Entity_ID_List::const_iterator id=id_list.begin();
-               id!=id_list.end(); ++id) {
-            result_v[0][*id] = lcv->second->DThermalConductivity_DTemperature(
-                                    poro_v[0][*id], sat_v[0][*id], sat2_v[0][*id], temp_v[0][*id]);
-          }
-        } else {
-          std::stringstream m;
-          m << "Thermal conductivity evaluator: unknown region on cells: \"" << region_name << "\"";
-          Errors::Message message(m.str());
-          Exceptions::amanzi_throw(message);
-        }
-      }
-      
+      output = D_TEMP;
     } else {
       ASSERT(false);
     }
+
+    for (int r=0; r!=tcs_.size(); ++r) {
+      EvaluateRegion_(r, output, poro_v, sat_v, sat2_v, temp_v, result_v);
+    }
   }
-    
+
   result->Scale(1.e-6); // convert to MJ
+}
+
 
-  Epetra_MultiVector& result_v = *result->ViewComponent("cell",false);
+// Region membership does not change, so the cells of each region are
+// gathered once rather than on every evaluation.
+void ThermalConductivityThreePhaseEvaluator::InitializeRegionCells_(
+    const AmanziMesh::Mesh& mesh) {
+  region_cells_.resize(tcs_.size());
+  region_contiguous_.resize(tcs_.size());
+  poro_terms_.resize(tcs_.size());
+  poro_terms_porosity_.resize(tcs_.size());
+  for (int r=0; r!=tcs_.size(); ++r) {
+    const std::string& region_name = tcs_[r].first;
+    if (mesh.valid_set_name(region_name, AmanziMesh::CELL)) {
+      mesh.get_set_entities(region_name, AmanziMesh::CELL, AmanziMesh::OWNED,
+                            &region_cells_[r]);
+      std::sort(region_cells_[r].begin(), region_cells_[r].end());
+      const AmanziMesh::Entity_ID_List& cells = region_cells_[r];
+      region_contiguous_[r] = cells.size() == 0 ||
+          cells.back() - cells.front() + 1 == cells.size();
+    } else {
+      std::stringstream m;
+      m << "Thermal conductivity evaluator: unknown region on cells: \"" << region_name << "\"";
+      Errors::Message message(m.str());
+      Exceptions::amanzi_throw(message);
+    }
+  }
 }
 
 
+// Regions are usually contiguous ranges of cells, which are passed to the
+// model in place; others are gathered into work space and scattered back.
+void ThermalConductivityThreePhaseEvaluator::EvaluateRegion_(int r,
+        Output output,
+        const Epetra_MultiVector& poro_v,
+        const Epetra_MultiVector& sat_v,
+        const Epetra_MultiVector& sat2_v,
+        const Epetra_MultiVector& temp_v,
+        Epetra_MultiVector& result_v) {
+  const AmanziMesh::Entity_ID_List& cells = region_cells_[r];
+  int n = cells.size();
+  if (n == 0) return;
+  ThermalConductivityThreePhase& tc = *tcs_[r].second;
+
+  const double *poro, *sat, *sat2, *temp;
+  double* result;
+  if (region_contiguous_[r]) {
+    int c0 = cells.front();
+    poro = &poro_v[0][c0];
+    sat = &sat_v[0][c0];
+    sat2 = &sat2_v[0][c0];
+    temp = &temp_v[0][c0];
+    result = &result_v[0][c0];
+  } else {
+    work_.resize(5*n);
+    for (int i=0; i!=n; ++i) {
+      int c = cells[i];
+      work_[i] = poro_v[0][c];
+      work_[n+i] = sat_v[0][c];
+      work_[2*n+i] = sat2_v[0][c];
+      work_[3*n+i] = temp_v[0][c];
+    }
+    poro = &work_[0];
+    sat = &work_[n];
+    sat2 = &work_[2*n];
+    temp = &work_[3*n];
+    result = &work_[4*n];
+  }
+
+  // recompute the porosity terms only if porosity has changed
+  const double* terms = NULL;
+  int nterms = tc.NumPorosityTerms();
+  if (nterms > 0) {
+    std::vector<double>& cached_poro = poro_terms_porosity_[r];
+    if (cached_poro.size() != n || !std::equal(poro, poro+n, cached_poro.begin())) {
+      cached_poro.assign(poro, poro+n);
+      poro_terms_[r].resize(nterms*n);
+      tc.PorosityTerms(n, poro, &poro_terms_[r][0]);
+    }
+    terms = &poro_terms_[r][0];
+  }
+
+  double* outputs[5] = { NULL, NULL, NULL, NULL, NULL };
+  outputs[output] = result;
+  tc.ThermalConductivities(n, poro, sat, sat2, temp, terms,
+          outputs[VALUE], outputs[D_POROSITY], outputs[D_SAT_LIQ],
+          outputs[D_SAT_ICE], outputs[D_TEMP]);
+
+  if (!region_contiguous_[r]) {
+    for (int i=0; i!=n; ++i) result_v[0][cells[i]] = result[i];
+  }
+}
+
 } //namespace
 } //namespace
-
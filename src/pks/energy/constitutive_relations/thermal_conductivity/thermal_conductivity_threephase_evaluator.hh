@@ -37,8 +37,30 @@ class ThermalConductivityThreePhaseEvaluator :
           Key wrt_key, const Teuchos::Ptr<CompositeVector>& result);
 
  protected:
-  
+  enum Output { VALUE = 0, D_POROSITY, D_SAT_LIQ, D_SAT_ICE, D_TEMP };
+
+  void InitializeRegionCells_(const AmanziMesh::Mesh& mesh);
+
+  // Evaluates one output of region r's model on its cells, in one batched
+  // call, into result.
+  void EvaluateRegion_(int r, Output output,
+                       const Epetra_MultiVector& poro_v,
+                       const Epetra_MultiVector& sat_v,
+                       const Epetra_MultiVector& sat2_v,
+                       const Epetra_MultiVector& temp_v,
+                       Epetra_MultiVector& result_v);
+
   std::vector<RegionModelPair> tcs_;
+  std::vector<AmanziMesh::Entity_ID_List> region_cells_;
+  std::vector<bool> region_contiguous_;
+
+  // Porosity-only terms of each region's model, kept while porosity, often
+  // static, is unchanged from the copy they were computed with.
+  std::vector<std::vector<double> > poro_terms_;
+  std::vector<std::vector<double> > poro_terms_porosity_;
+
+  // gathered inputs and output of regions that are not contiguous
+  std::vector<double> work_;
 
   // Keys for fields
   // dependencies
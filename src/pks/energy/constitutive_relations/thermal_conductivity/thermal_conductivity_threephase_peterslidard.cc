@@ -9,12 +9,17 @@ Author: Ethan Coon
 Linear interpolant of thermal conductivity.
 ------------------------------------------------------------------------- */
 
+#include <algorithm>
 #include <cmath>
 #include "thermal_conductivity_threephase_peterslidard.hh"
 
 namespace Amanzi {
 namespace Energy {
 
+namespace {
+const int BLOCK = 64;
+}
+
 ThermalConductivityThreePhasePetersLidard::ThermalConductivityThreePhasePetersLidard(
       Teuchos::ParameterList& plist) : plist_(plist) {
   InitializeFromPlist_();
@@ -31,6 +36,77 @@ double ThermalConductivityThreePhasePetersLidard::ThermalConductivity(double por
     + (1.0 - kersten_f - kersten_u) * k_dry;
 };
 
+void ThermalConductivityThreePhasePetersLidard::PorosityTerms(int n,
+        const double* poro, double* terms) {
+  double* k_sat_u = terms;
+  double* k_sat_f = terms + n;
+  double* k_dry = terms + 2*n;
+  double* dk_dry = terms + 3*n;
+  for (int c=0; c!=n; ++c) {
+    k_sat_u[c] = k_soil_ * std::exp(poro[c] * log_ratio_u_);
+    k_sat_f[c] = k_soil_ * std::exp(poro[c] * log_ratio_f_);
+
+    double num = d_*(1-poro[c])*k_soil_ + k_gas_*poro[c];
+    double den = d_*(1-poro[c]) + poro[c];
+    k_dry[c] = num / den;
+    dk_dry[c] = ((k_gas_ - d_*k_soil_)*den - num*(1-d_)) / (den*den);
+  }
+}
+
+
+void ThermalConductivityThreePhasePetersLidard::ThermalConductivities(int n,
+        const double* poro, const double* sat_liq, const double* sat_ice,
+        const double* temp, const double* poro_terms,
+        double* k, double* dk_dporo, double* dk_dsat_liq,
+        double* dk_dsat_ice, double* dk_dtemp) {
+  if (dk_dtemp) std::fill(dk_dtemp, dk_dtemp+n, 0.);
+
+  double kersten_u[BLOCK], kersten_f[BLOCK];
+  double dkersten_u[BLOCK], dkersten_f[BLOCK];
+  double local_terms[4*BLOCK];
+  for (int b=0; b<n; b+=BLOCK) {
+    int m = std::min(BLOCK, n-b);
+
+    const double *k_sat_u, *k_sat_f, *k_dry, *dk_dry;
+    if (poro_terms) {
+      k_sat_u = poro_terms + b;
+      k_sat_f = poro_terms + n + b;
+      k_dry = poro_terms + 2*n + b;
+      dk_dry = poro_terms + 3*n + b;
+    } else {
+      PorosityTerms(m, poro + b, local_terms);
+      k_sat_u = local_terms;
+      k_sat_f = local_terms + m;
+      k_dry = local_terms + 2*m;
+      dk_dry = local_terms + 3*m;
+    }
+
+    Kersten_(m, sat_liq + b, eps_, alpha_u_, kersten_u, dk_dsat_liq ? dkersten_u : NULL);
+    Kersten_(m, sat_ice + b, eps_, alpha_f_, kersten_f, dk_dsat_ice ? dkersten_f : NULL);
+
+    if (k) {
+      for (int i=0; i!=m; ++i)
+        k[b+i] = kersten_f[i] * k_sat_f[i] + kersten_u[i] * k_sat_u[i]
+            + (1.0 - kersten_f[i] - kersten_u[i]) * k_dry[i];
+    }
+    if (dk_dporo) {
+      for (int i=0; i!=m; ++i)
+        dk_dporo[b+i] = kersten_f[i] * k_sat_f[i] * log_ratio_f_
+            + kersten_u[i] * k_sat_u[i] * log_ratio_u_
+            + (1.0 - kersten_f[i] - kersten_u[i]) * dk_dry[i];
+    }
+    if (dk_dsat_liq) {
+      for (int i=0; i!=m; ++i)
+        dk_dsat_liq[b+i] = dkersten_u[i] * (k_sat_u[i] - k_dry[i]);
+    }
+    if (dk_dsat_ice) {
+      for (int i=0; i!=m; ++i)
+        dk_dsat_ice[b+i] = dkersten_f[i] * (k_sat_f[i] - k_dry[i]);
+    }
+  }
+}
+
+
 void ThermalConductivityThreePhasePetersLidard::InitializeFromPlist_() {
   d_ = 0.053; // unitless empericial parameter
 
@@ -41,6 +117,9 @@ void ThermalConductivityThreePhasePetersLidard::InitializeFromPlist_() {
   k_ice_ = plist_.get<double>("thermal conductivity of ice [W/(m-K)]");
   k_liquid_ = plist_.get<double>("thermal conductivity of liquid [W/(m-K)]");
   k_gas_ = plist_.get<double>("thermal conductivity of gas [W/(m-K)]");
+
+  log_ratio_u_ = std::log(k_liquid_ / k_soil_);
+  log_ratio_f_ = std::log(k_ice_ / k_soil_);
 };
 
 } // namespace Relations
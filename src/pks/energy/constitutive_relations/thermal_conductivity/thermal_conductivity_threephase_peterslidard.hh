@@ -47,6 +47,17 @@ public:
 
   double ThermalConductivity(double porosity, double sat_liq, double sat_ice, double temp);
 
+  // The saturated and dry conductivities, and the derivative of the dry
+  // conductivity, depend only on porosity.
+  int NumPorosityTerms() const { return 4; }
+  void PorosityTerms(int n, const double* porosity, double* terms);
+
+  void ThermalConductivities(int n, const double* porosity,
+          const double* sat_liq, const double* sat_ice, const double* temp,
+          const double* poro_terms,
+          double* k, double* dk_dporosity, double* dk_dsat_liq,
+          double* dk_dsat_ice, double* dk_dtemp);
+
 private:
   void InitializeFromPlist_();
 
@@ -61,6 +72,10 @@ private:
   double k_gas_;
   double d_;
 
+  // k_sat = k_soil^(1-poro) * k^poro = k_soil * exp(poro * log(k/k_soil))
+  double log_ratio_u_;
+  double log_ratio_f_;
+
 private:
   static Utils::RegisteredFactory<ThermalConductivityThreePhase,
                                   ThermalConductivityThreePhasePetersLidard> factory_;
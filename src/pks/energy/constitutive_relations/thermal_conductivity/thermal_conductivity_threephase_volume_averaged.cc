@@ -9,6 +9,7 @@ Author: Ethan Coon
 Linear interpolant of thermal conductivity.
 ------------------------------------------------------------------------- */
 
+#include <algorithm>
 #include <cmath>
 #include "dbc.hh"
 #include "thermal_conductivity_threephase_volume_averaged.hh"
@@ -28,6 +29,33 @@ double ThermalConductivityThreePhaseVolumeAveraged::ThermalConductivity(double p
       + poro*sat_ice*k_ice_ + poro*(1-sat_liq-sat_ice)*k_gas_;
 };
 
+void ThermalConductivityThreePhaseVolumeAveraged::ThermalConductivities(int n,
+        const double* poro, const double* sat_liq, const double* sat_ice,
+        const double* temp, const double* poro_terms,
+        double* k, double* dk_dporo, double* dk_dsat_liq,
+        double* dk_dsat_ice, double* dk_dtemp) {
+  for (int c=0; c!=n; ++c) ASSERT(std::abs(1-sat_liq[c]-sat_ice[c]) < 1.e-10);
+
+  if (k) {
+    for (int c=0; c!=n; ++c)
+      k[c] = (1-poro[c])*k_soil_ + poro[c]*sat_liq[c]*k_liquid_
+          + poro[c]*sat_ice[c]*k_ice_ + poro[c]*(1-sat_liq[c]-sat_ice[c])*k_gas_;
+  }
+  if (dk_dporo) {
+    for (int c=0; c!=n; ++c)
+      dk_dporo[c] = -k_soil_ + sat_liq[c]*k_liquid_ + sat_ice[c]*k_ice_
+          + (1-sat_liq[c]-sat_ice[c])*k_gas_;
+  }
+  if (dk_dsat_liq) {
+    for (int c=0; c!=n; ++c) dk_dsat_liq[c] = poro[c]*(k_liquid_ - k_gas_);
+  }
+  if (dk_dsat_ice) {
+    for (int c=0; c!=n; ++c) dk_dsat_ice[c] = poro[c]*(k_ice_ - k_gas_);
+  }
+  if (dk_dtemp) std::fill(dk_dtemp, dk_dtemp+n, 0.);
+}
+
+
 void ThermalConductivityThreePhaseVolumeAveraged::InitializeFromPlist_() {
   k_soil_ = plist_.get<double>("thermal conductivity of soil [W/(m-K)]");
   k_ice_ = plist_.get<double>("thermal conductivity of ice [W/(m-K)]");
@@ -40,6 +40,12 @@ public:
 
   double ThermalConductivity(double porosity, double sat_liq, double sat_ice, double temp);
 
+  void ThermalConductivities(int n, const double* porosity,
+          const double* sat_liq, const double* sat_ice, const double* temp,
+          const double* poro_terms,
+          double* k, double* dk_dporosity, double* dk_dsat_liq,
+          double* dk_dsat_ice, double* dk_dtemp);
+
 private:
   void InitializeFromPlist_();
 
@@ -9,12 +9,17 @@ Author: Ethan Coon
 Linear interpolant of thermal conductivity.
 ------------------------------------------------------------------------- */
 
+#include <algorithm>
 #include <cmath>
 #include "thermal_conductivity_threephase_wetdry.hh"
 
 namespace Amanzi {
 namespace Energy {
 
+namespace {
+const int BLOCK = 64;
+}
+
 ThermalConductivityThreePhaseWetDry::ThermalConductivityThreePhaseWetDry(
       Teuchos::ParameterList& plist) : plist_(plist) {
   InitializeFromPlist_();
@@ -72,6 +77,54 @@ ThermalConductivityThreePhaseWetDry::DThermalConductivity_DTemperature(double po
 }
 
 
+// The ice conductivity depends on temperature, so nothing is precomputed from
+// porosity alone.  (Ki/Kl)^poro is formed as exp(poro * log(Ki/Kl)), with
+// log(Ki) = log(831.51) - 1.0552 log(T).
+void ThermalConductivityThreePhaseWetDry::ThermalConductivities(int n,
+        const double* poro, const double* sat_liq, const double* sat_ice,
+        const double* temp, const double* poro_terms,
+        double* k, double* dk_dporo, double* dk_dsat_liq,
+        double* dk_dsat_ice, double* dk_dtemp) {
+  const double log_Ki0_Kl = std::log(831.51 / 0.5611);
+
+  double kersten_u[BLOCK], kersten_f[BLOCK];
+  double dkersten_u[BLOCK], dkersten_f[BLOCK];
+  double log_ratio[BLOCK], k_sat_f[BLOCK];
+  for (int b=0; b<n; b+=BLOCK) {
+    int m = std::min(BLOCK, n-b);
+
+    for (int i=0; i!=m; ++i) {
+      log_ratio[i] = log_Ki0_Kl - 1.0552 * std::log(temp[b+i]);
+      k_sat_f[i] = k_sat_u_ * std::exp(poro[b+i] * log_ratio[i]);
+    }
+    Kersten_(m, sat_liq + b, eps_, alpha_u_, kersten_u, dk_dsat_liq ? dkersten_u : NULL);
+    Kersten_(m, sat_ice + b, eps_, alpha_f_, kersten_f, dk_dsat_ice ? dkersten_f : NULL);
+
+    if (k) {
+      for (int i=0; i!=m; ++i)
+        k[b+i] = kersten_f[i] * k_sat_f[i] + kersten_u[i] * k_sat_u_
+            + (1.0 - kersten_f[i] - kersten_u[i]) * k_dry_;
+    }
+    if (dk_dporo) {
+      for (int i=0; i!=m; ++i)
+        dk_dporo[b+i] = kersten_f[i] * k_sat_f[i] * log_ratio[i];
+    }
+    if (dk_dsat_liq) {
+      for (int i=0; i!=m; ++i)
+        dk_dsat_liq[b+i] = dkersten_u[i] * (k_sat_u_ - k_dry_);
+    }
+    if (dk_dsat_ice) {
+      for (int i=0; i!=m; ++i)
+        dk_dsat_ice[b+i] = dkersten_f[i] * (k_sat_f[i] - k_dry_);
+    }
+    if (dk_dtemp) {
+      for (int i=0; i!=m; ++i)
+        dk_dtemp[b+i] = -1.0552 * kersten_f[i] * k_sat_f[i] * poro[b+i] / temp[b+i];
+    }
+  }
+}
+
+
 void ThermalConductivityThreePhaseWetDry::InitializeFromPlist_() {
   eps_ = plist_.get<double>("epsilon [-]", 1.e-10);
   alpha_u_ = plist_.get<double>("unsaturated alpha unfrozen [-]");
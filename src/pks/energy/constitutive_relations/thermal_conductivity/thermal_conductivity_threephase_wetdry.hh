@@ -50,6 +50,12 @@ public:
   double DThermalConductivity_DSaturationIce(double porosity, double sat_liq, double sat_ice, double temp);
   double DThermalConductivity_DTemperature(double porosity, double sat_liq, double sat_ice, double temp);
 
+  void ThermalConductivities(int n, const double* porosity,
+          const double* sat_liq, const double* sat_ice, const double* temp,
+          const double* poro_terms,
+          double* k, double* dk_dporosity, double* dk_dsat_liq,
+          double* dk_dsat_ice, double* dk_dtemp);
+
 private:
   void InitializeFromPlist_();
 
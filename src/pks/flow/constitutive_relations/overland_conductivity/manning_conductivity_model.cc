@@ -18,6 +18,16 @@ ManningConductivityModel::ManningConductivityModel(Teuchos::ParameterList& plist
   slope_regularization_ = plist_.get<double>("slope regularization epsilon", 1.e-8);
   manning_exp_ = plist_.get<double>("Manning exponent");
   //beta_exp_ = plist_.get<double>("beta exponent");
+
+  if (std::abs(manning_exp_ - 2./3.) < 1.e-12) {
+    pow_type_ = POW_TWO_THIRDS;
+  } else if (std::abs(manning_exp_ - 0.5) < 1.e-12) {
+    pow_type_ = POW_ONE_HALF;
+  } else if (std::abs(manning_exp_ - 1.) < 1.e-12) {
+    pow_type_ = POW_ONE;
+  } else {
+    pow_type_ = POW_GENERAL;
+  }
 }
 
 double ManningConductivityModel::Conductivity(double depth, double slope, double coef) {
@@ -46,6 +56,49 @@ double ManningConductivityModel::DConductivityDDepth(double depth, double slope,
   return std::pow(std::max(depth,0.), exponent - 1.) * exponent / scaling;
 }
 
+void ManningConductivityModel::ConductivityAndDerivative(int n, const double* depth,
+        const double* inv_scaling, double* cond, double* dcond_ddepth) const {
+  // K = d^(m+1) / scaling, dK/dd = (m+1) d^m / scaling, both zero for d <= 0
+  double exponent = manning_exp_ + 1.0;
+  switch (pow_type_) {
+    case POW_TWO_THIRDS:
+      for (int i=0; i!=n; ++i) {
+        double d = std::max(depth[i], 0.);
+        double d_m = std::cbrt(d);
+        d_m *= d_m;
+        cond[i] = d * d_m * inv_scaling[i];
+        dcond_ddepth[i] = exponent * d_m * inv_scaling[i];
+      }
+      break;
+    case POW_ONE_HALF:
+      for (int i=0; i!=n; ++i) {
+        double d = std::max(depth[i], 0.);
+        double d_m = std::sqrt(d);
+        cond[i] = d * d_m * inv_scaling[i];
+        dcond_ddepth[i] = exponent * d_m * inv_scaling[i];
+      }
+      break;
+    case POW_ONE:
+      for (int i=0; i!=n; ++i) {
+        double d = std::max(depth[i], 0.);
+        cond[i] = d * d * inv_scaling[i];
+        dcond_ddepth[i] = exponent * d * inv_scaling[i];
+      }
+      break;
+    default:
+      for (int i=0; i!=n; ++i) {
+        if (depth[i] <= 0.) {
+          cond[i] = 0.;
+          dcond_ddepth[i] = 0.;
+        } else {
+          double d_m = std::pow(depth[i], manning_exp_);
+          cond[i] = depth[i] * d_m * inv_scaling[i];
+          dcond_ddepth[i] = exponent * d_m * inv_scaling[i];
+        }
+      }
+  }
+}
+
 double ManningConductivityModel::DConductivityDDepth(double depth, double slope, double coef, double pd_depth, double frac_cond, double beta) {  
   if (pd_depth <= 0.) return 0.;
   //Errors::Message message("Manning Conductivity Model: Derivaritve not implemented for the Subgrid Model."); 
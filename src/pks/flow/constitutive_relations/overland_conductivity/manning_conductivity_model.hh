@@ -10,6 +10,9 @@
 #ifndef AMANZI_FLOWRELATIONS_MANNING_CONDUCTIVITY_MODEL_
 #define AMANZI_FLOWRELATIONS_MANNING_CONDUCTIVITY_MODEL_
 
+#include <algorithm>
+#include <cmath>
+
 #include "Teuchos_ParameterList.hpp"
 #include "overland_conductivity_model.hh"
 
@@ -29,12 +32,26 @@ public:
   virtual double Conductivity(double depth, double slope, double coef, double pd_depth, double frac_cond, double beta);  
   virtual double DConductivityDDepth(double depth, double slope, double coef, double pd_depth, double frac, double beta);
 
+  // The depth-independent part of the conductivity, coef * sqrt(slope).
+  double Scaling(double slope, double coef) const {
+    return coef * std::sqrt(std::max(slope, slope_regularization_));
+  }
+
+  // Conductivity and its derivative with respect to depth for n cells, given
+  // the inverse of each cell's Scaling().  Exponents of 2/3 (the default),
+  // 1/2 and 1 use cbrt/sqrt/multiplication in place of pow.
+  void ConductivityAndDerivative(int n, const double* depth, const double* inv_scaling,
+          double* cond, double* dcond_ddepth) const;
+
 protected:
+  enum PowType { POW_GENERAL, POW_TWO_THIRDS, POW_ONE_HALF, POW_ONE };
+
   Teuchos::ParameterList plist_;
 
   double slope_regularization_;
   double manning_exp_, beta_exp_;
   double manning_coef_;
+  PowType pow_type_;
 
 };
 
@@ -70,7 +70,9 @@ OverlandConductivityEvaluator::OverlandConductivityEvaluator(Teuchos::ParameterL
   } else {
     ASSERT(0);
   }
-    
+
+  if (!sg_model_)
+    manning_ = Teuchos::rcp_dynamic_cast<ManningConductivityModel>(model_);
 }
 
 
@@ -88,7 +90,8 @@ OverlandConductivityEvaluator::OverlandConductivityEvaluator(const OverlandCondu
     vpd_key_(other.vpd_key_),
     frac_cond_key_(other.frac_cond_key_),
     sg_model_(other.sg_model_),
-    drag_exp_key_(other.drag_exp_key_){}
+    drag_exp_key_(other.drag_exp_key_),
+    manning_(other.manning_) {}
 
 
 Teuchos::RCP<FieldEvaluator>
@@ -101,6 +104,11 @@ OverlandConductivityEvaluator::Clone() const {
 void OverlandConductivityEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
         const Teuchos::Ptr<CompositeVector>& result) {
 
+  if (manning_ != Teuchos::null) {
+    EvaluateManning_(S, false, result);
+    return;
+  }
+
   Teuchos::RCP<const CompositeVector> depth = S->GetFieldData(depth_key_);
   Teuchos::RCP<const CompositeVector> slope = S->GetFieldData(slope_key_);
   Teuchos::RCP<const CompositeVector> coef = S->GetFieldData(coef_key_);
@@ -183,6 +191,11 @@ void OverlandConductivityEvaluator::EvaluateFieldPartialDerivative_(
     Errors::Message message("Overland Conductivity Evaluator: Evaluate partial derivaritve not implemented for the Subgrid Model."); 
     Exceptions::amanzi_throw(message);
   }
+  if (manning_ != Teuchos::null && wrt_key == depth_key_) {
+    EvaluateManning_(S, true, result);
+    return;
+  }
+
   Teuchos::RCP<const CompositeVector> depth = S->GetFieldData(depth_key_);
   Teuchos::RCP<const CompositeVector> slope = S->GetFieldData(slope_key_);
   Teuchos::RCP<const CompositeVector> coef = S->GetFieldData(coef_key_);
@@ -244,6 +257,84 @@ void OverlandConductivityEvaluator::EvaluateFieldPartialDerivative_(
 }
 
 
+// Recomputes the cached 1/(coef * sqrt(slope)) only if slope or the Manning
+// coefficient changed since it was last computed.
+void OverlandConductivityEvaluator::UpdateInverseScaling_(const Teuchos::Ptr<State>& S) {
+  Key request = my_key_ + " scaling";
+  bool changed = S->GetFieldEvaluator(slope_key_)->HasFieldChanged(S, request);
+  changed |= S->GetFieldEvaluator(coef_key_)->HasFieldChanged(S, request);
+  if (!changed && !inv_scaling_.empty()) return;
+
+  Teuchos::RCP<const CompositeVector> slope = S->GetFieldData(slope_key_);
+  Teuchos::RCP<const CompositeVector> coef = S->GetFieldData(coef_key_);
+  for (CompositeVector::name_iterator comp=slope->begin();
+       comp!=slope->end(); ++comp) {
+    const Epetra_MultiVector& slope_v = *slope->ViewComponent(*comp,false);
+    const Epetra_MultiVector& coef_v = *coef->ViewComponent(*comp,false);
+
+    std::vector<double>& inv_scaling = inv_scaling_[*comp];
+    int ncomp = slope_v.MyLength();
+    inv_scaling.resize(ncomp);
+    for (int i=0; i!=ncomp; ++i) {
+      inv_scaling[i] = 1. / manning_->Scaling(slope_v[0][i], coef_v[0][i]);
+    }
+  }
+}
+
+
+// Evaluates the conductivity, or its derivative with respect to depth, with
+// Manning's model.  Each evaluation of the conductivity also computes its
+// derivative in the same sweep and caches it; the derivative is copied out of
+// that cache once the value is known to be current.
+void OverlandConductivityEvaluator::EvaluateManning_(const Teuchos::Ptr<State>& S,
+        bool derivative, const Teuchos::Ptr<CompositeVector>& result) {
+  if (derivative) {
+    // Make sure the value, and therefore the cached derivative, is current.
+    // This only evaluates if a dependency has changed.
+    HasFieldChanged(S, my_key_+" manning derivative");
+  } else {
+    UpdateInverseScaling_(S);
+  }
+
+  Teuchos::RCP<const CompositeVector> depth = S->GetFieldData(depth_key_);
+
+  for (CompositeVector::name_iterator comp=result->begin();
+       comp!=result->end(); ++comp) {
+    Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
+    int ncomp = result->size(*comp, false);
+    if (ncomp == 0) continue;
+
+    std::vector<double>& dcond = dcond_[*comp];
+    if (derivative) {
+      ASSERT(dcond.size() == ncomp);
+      for (int i=0; i!=ncomp; ++i) result_v[0][i] = dcond[i];
+      if (dt_) {
+        for (int i=0; i!=ncomp; ++i) result_v[0][i] *= factor_;
+      }
+    } else {
+      const Epetra_MultiVector& depth_v = *depth->ViewComponent(*comp,false);
+      const std::vector<double>& inv_scaling = inv_scaling_[*comp];
+      ASSERT(inv_scaling.size() == ncomp);
+
+      const double* d = depth_v[0];
+      if (dt_) {
+        depth_work_.resize(ncomp);
+        for (int i=0; i!=ncomp; ++i) depth_work_[i] = factor_ * depth_v[0][i];
+        d = &depth_work_[0];
+      }
+
+      dcond.resize(ncomp);
+      manning_->ConductivityAndDerivative(ncomp, d, &inv_scaling[0], result_v[0], &dcond[0]);
+    }
+
+    if (dens_) {
+      const Epetra_MultiVector& dens_v = *S->GetFieldData(dens_key_)->ViewComponent(*comp,false);
+      for (int i=0; i!=ncomp; ++i) result_v[0][i] *= dens_v[0][i];
+    }
+  }
+}
+
+
 } //namespace
 } //namespace
 
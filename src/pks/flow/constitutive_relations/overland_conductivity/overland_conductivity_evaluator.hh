@@ -9,6 +9,9 @@
 #ifndef AMANZI_FLOWRELATIONS_OVERLAND_CONDUCTIVITY_EVALUATOR_
 #define AMANZI_FLOWRELATIONS_OVERLAND_CONDUCTIVITY_EVALUATOR_
 
+#include <map>
+#include <vector>
+
 #include "factory.hh"
 #include "secondary_variable_field_evaluator.hh"
 
@@ -16,6 +19,7 @@ namespace Amanzi {
 namespace Flow {
 
 class OverlandConductivityModel;
+class ManningConductivityModel;
 
 class OverlandConductivityEvaluator : public SecondaryVariableFieldEvaluator {
 
@@ -32,9 +36,22 @@ class OverlandConductivityEvaluator : public SecondaryVariableFieldEvaluator {
 
   Teuchos::RCP<OverlandConductivityModel> get_Model() { return model_; }
 
+protected:
+  void UpdateInverseScaling_(const Teuchos::Ptr<State>& S);
+  void EvaluateManning_(const Teuchos::Ptr<State>& S, bool derivative,
+                        const Teuchos::Ptr<CompositeVector>& result);
+
 private:
   Teuchos::RCP<OverlandConductivityModel> model_;
 
+  // Manning's model without the subgrid model is evaluated in batch, with
+  // 1/(coef * sqrt(slope)) cached per component until slope or coef change,
+  // and dK/d(depth) cached per component from the last value evaluation
+  Teuchos::RCP<ManningConductivityModel> manning_;
+  std::map<std::string, std::vector<double> > inv_scaling_;
+  std::map<std::string, std::vector<double> > dcond_;
+  std::vector<double> depth_work_;
+
   Key depth_key_;
   Key slope_key_;
   Key coef_key_;
@@ -0,0 +1,39 @@
+#include <string>
+#include "UnitTest++.h"
+
+#include "Teuchos_ParameterList.hpp"
+
+#include "wrm_partition.hh"
+#include "wrm_factory_reg.hh"
+#include "wrm_permafrost_factory_reg.hh"
+#include "wrm_van_genuchten_reg.hh"
+
+// the WRM list of a column: one van Genuchten soil type in region
+Teuchos::ParameterList ColumnWRMList(const std::string& region, double alpha) {
+  Teuchos::ParameterList plist;
+  Teuchos::ParameterList& soil = plist.sublist("soil");
+  soil.set<std::string>("region", region);
+  soil.set<std::string>("WRM Type", "van Genuchten");
+  soil.set<double>("van Genuchten alpha", alpha);
+  soil.set<double>("van Genuchten m", 0.5);
+  soil.set<double>("residual saturation", 0.1);
+  return plist;
+}
+
+TEST(WRM_PARTITION_SHARES_MODELS_ACROSS_REGIONS) {
+  using namespace Amanzi::Flow;
+
+  // the same soil type in two columns is the same model
+  Teuchos::ParameterList col0 = ColumnWRMList("column_0 soil", 1.e-4);
+  Teuchos::ParameterList col1 = ColumnWRMList("column_1 soil", 1.e-4);
+  Teuchos::RCP<WRMPartition> wrms0 = createWRMPartition(col0);
+  Teuchos::RCP<WRMPartition> wrms1 = createWRMPartition(col1);
+  CHECK_EQUAL(1, (int) wrms0->second.size());
+  CHECK_EQUAL(1, (int) wrms1->second.size());
+  CHECK(wrms0->second[0].get() == wrms1->second[0].get());
+
+  // a different soil type is not
+  Teuchos::ParameterList col2 = ColumnWRMList("column_0 soil", 2.e-4);
+  Teuchos::RCP<WRMPartition> wrms2 = createWRMPartition(col2);
+  CHECK(wrms0->second[0].get() != wrms2->second[0].get());
+}
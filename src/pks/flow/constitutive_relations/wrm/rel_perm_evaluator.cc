@@ -32,6 +32,7 @@ RelPermEvaluator::RelPermEvaluator(Teuchos::ParameterList& plist,
 RelPermEvaluator::RelPermEvaluator(const RelPermEvaluator& other) :
     SecondaryVariableFieldEvaluator(other),
     wrms_(other.wrms_),
+    region_cells_(other.region_cells_),
     sat_key_(other.sat_key_),
     dens_key_(other.dens_key_),
     visc_key_(other.visc_key_),
@@ -154,6 +155,11 @@ void RelPermEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
     wrms_->first->Initialize(result->Mesh(), -1);
     wrms_->first->Verify();
   }
+  if (region_cells_.size() == 0) {
+    getPartitionCellLists(wrms_->first, wrms_->second.size(),
+                          result->ViewComponent("cell",false)->MyLength(),
+                          region_cells_);
+  }
 
   // Evaluate k_rel.
   // -- Evaluate the model to calculate krel on cells.
@@ -162,9 +168,11 @@ void RelPermEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
   Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
 
   int ncells = res_c.MyLength();
-  for (unsigned int c=0; c!=ncells; ++c) {
-    int index = (*wrms_->first)[c];
-    res_c[0][c] = std::max(wrms_->second[index]->k_relative(sat_c[0][c]), min_val_);
+  for (int r=0; r!=region_cells_.size(); ++r) {
+    WRM& wrm = *wrms_->second[r];
+    for (auto c : region_cells_[r]) {
+      res_c[0][c] = std::max(wrm.k_relative(sat_c[0][c]), min_val_);
+    }
   }
 
   // -- Potentially evaluate the model on boundary faces as well.
@@ -253,6 +261,11 @@ void RelPermEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>
     wrms_->first->Initialize(result->Mesh(), -1);
     wrms_->first->Verify();
   }
+  if (region_cells_.size() == 0) {
+    getPartitionCellLists(wrms_->first, wrms_->second.size(),
+                          result->ViewComponent("cell",false)->MyLength(),
+                          region_cells_);
+  }
 
   if (wrt_key == sat_key_) {
     // dkr / dsl = rho/mu * dkr/dpc * dpc/dsl
@@ -264,10 +277,12 @@ void RelPermEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>
     Epetra_MultiVector& res_c = *result->ViewComponent("cell",false);
 
     int ncells = res_c.MyLength();
-    for (unsigned int c=0; c!=ncells; ++c) {
-      int index = (*wrms_->first)[c];
-      res_c[0][c] = wrms_->second[index]->d_k_relative(sat_c[0][c]);
-      ASSERT(res_c[0][c] >= 0.);
+    for (int r=0; r!=region_cells_.size(); ++r) {
+      WRM& wrm = *wrms_->second[r];
+      for (auto c : region_cells_[r]) {
+        res_c[0][c] = wrm.d_k_relative(sat_c[0][c]);
+        ASSERT(res_c[0][c] >= 0.);
+      }
     }
 
     // -- Potentially evaluate the model on boundary faces as well.
@@ -46,6 +46,7 @@ class RelPermEvaluator : public SecondaryVariableFieldEvaluator {
   void InitializeFromPlist_();
 
   Teuchos::RCP<WRMPartition> wrms_;
+  PartitionCellLists region_cells_;
   Key sat_key_;
   Key dens_key_;
   Key visc_key_;
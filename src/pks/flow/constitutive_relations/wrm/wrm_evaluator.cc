@@ -33,9 +33,10 @@ WRMEvaluator::WRMEvaluator(Teuchos::ParameterList& plist,
 
 WRMEvaluator::WRMEvaluator(const WRMEvaluator& other) :
     SecondaryVariablesFieldEvaluator(other),
+    wrms_(other.wrms_),
+    region_cells_(other.region_cells_),
     calc_other_sat_(other.calc_other_sat_),
-    cap_pres_key_(other.cap_pres_key_),
-    wrms_(other.wrms_) {}
+    cap_pres_key_(other.cap_pres_key_) {}
 
 
 Teuchos::RCP<FieldEvaluator> WRMEvaluator::Clone() const {
@@ -80,15 +81,22 @@ void WRMEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
     wrms_->first->Initialize(results[0]->Mesh(), -1);
     wrms_->first->Verify();
   }
+  if (region_cells_.size() == 0) {
+    getPartitionCellLists(wrms_->first, wrms_->second.size(),
+                          results[0]->ViewComponent("cell",false)->MyLength(),
+                          region_cells_);
+  }
 
   Epetra_MultiVector& sat_c = *results[0]->ViewComponent("cell",false);
   const Epetra_MultiVector& pres_c = *S->GetFieldData(cap_pres_key_)
       ->ViewComponent("cell",false);
 
-  // calculate cell values
-  AmanziMesh::Entity_ID ncells = sat_c.MyLength();
-  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-    sat_c[0][c] = wrms_->second[(*wrms_->first)[c]]->saturation(pres_c[0][c]);
+  // calculate cell values, region by region
+  for (int r=0; r!=region_cells_.size(); ++r) {
+    WRM& wrm = *wrms_->second[r];
+    for (auto c : region_cells_[r]) {
+      sat_c[0][c] = wrm.saturation(pres_c[0][c]);
+    }
   }
 
   // Potentially do face values as well.
@@ -145,6 +153,11 @@ void WRMEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
     wrms_->first->Initialize(results[0]->Mesh(), -1);
     wrms_->first->Verify();
   }
+  if (region_cells_.size() == 0) {
+    getPartitionCellLists(wrms_->first, wrms_->second.size(),
+                          results[0]->ViewComponent("cell",false)->MyLength(),
+                          region_cells_);
+  }
 
   ASSERT(wrt_key == cap_pres_key_);
 
@@ -152,10 +165,12 @@ void WRMEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
   const Epetra_MultiVector& pres_c = *S->GetFieldData(cap_pres_key_)
       ->ViewComponent("cell",false);
 
-  // calculate cell values
-  AmanziMesh::Entity_ID ncells = sat_c.MyLength();
-  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-    sat_c[0][c] = wrms_->second[(*wrms_->first)[c]]->d_saturation(pres_c[0][c]);
+  // calculate cell values, region by region
+  for (int r=0; r!=region_cells_.size(); ++r) {
+    WRM& wrm = *wrms_->second[r];
+    for (auto c : region_cells_[r]) {
+      sat_c[0][c] = wrm.d_saturation(pres_c[0][c]);
+    }
   }
 
   // Potentially do face values as well.
@@ -42,6 +42,7 @@ class WRMEvaluator : public SecondaryVariablesFieldEvaluator {
 
  protected:
   Teuchos::RCP<WRMPartition> wrms_;
+  PartitionCellLists region_cells_;
   bool calc_other_sat_;
   Key cap_pres_key_;
 
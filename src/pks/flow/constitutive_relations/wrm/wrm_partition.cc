@@ -14,10 +14,36 @@
 namespace Amanzi {
 namespace Flow {
 
+// WRMs are immutable once constructed, so a model is shared by every
+// partition with the same model parameters, wherever it applies.  For column
+// ensembles, where each column's evaluator gets its own list, with its own
+// region, this means one WRM per soil type instead of one per soil type per
+// column.
+static Teuchos::RCP<WRM>
+getSharedWRM_(const Teuchos::ParameterList& wrm_plist) {
+  typedef std::vector<std::pair<Teuchos::ParameterList, Teuchos::RCP<WRM> > > WRMCache;
+  static WRMCache cache;
+
+  // the region is where the model applies, not part of the model
+  Teuchos::ParameterList model_plist(wrm_plist);
+  model_plist.remove("region", false);
+
+  for (WRMCache::const_iterator entry=cache.begin(); entry!=cache.end(); ++entry) {
+    if (Teuchos::haveSameValues(entry->first, model_plist)) return entry->second;
+  }
+
+  // the factory may add defaults to the list, so keep the original as the key
+  Teuchos::ParameterList model_plist_copy(model_plist);
+  WRMFactory fac;
+  Teuchos::RCP<WRM> wrm = fac.createWRM(model_plist_copy);
+  cache.push_back(std::make_pair(model_plist, wrm));
+  return wrm;
+}
+
+
 // Non-member factory
 Teuchos::RCP<WRMPartition>
 createWRMPartition(Teuchos::ParameterList& plist) {
-  WRMFactory fac;
   std::vector<Teuchos::RCP<WRM> > wrm_list;
   std::vector<std::string> region_list;
 
@@ -25,9 +51,9 @@ createWRMPartition(Teuchos::ParameterList& plist) {
        lcv!=plist.end(); ++lcv) {
     std::string name = lcv->first;
     if (plist.isSublist(name)) {
-      Teuchos::ParameterList sublist = plist.sublist(name);
+      Teuchos::ParameterList& sublist = plist.sublist(name);
       region_list.push_back(sublist.get<std::string>("region"));
-      wrm_list.push_back(fac.createWRM(sublist));
+      wrm_list.push_back(getSharedWRM_(sublist));
     } else {
       ASSERT(0);
     }
@@ -57,5 +83,21 @@ createWRMPermafrostModelPartition(Teuchos::ParameterList& plist,
   return Teuchos::rcp(new WRMPermafrostModelPartition(wrms->first, pm_list));
 }
 
+
+void
+getPartitionCellLists(const Teuchos::RCP<Functions::MeshPartition>& part,
+                      int nregions, int ncells, PartitionCellLists& cell_lists) {
+  ASSERT(part->initialized());
+  cell_lists.clear();
+  cell_lists.resize(nregions);
+  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
+    int r = (*part)[c];
+    if (r >= 0) {
+      ASSERT(r < nregions);
+      cell_lists[r].push_back(c);
+    }
+  }
+}
+
 } // namespace
 } // namespace
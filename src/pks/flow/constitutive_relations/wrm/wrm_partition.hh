@@ -21,6 +21,11 @@ typedef std::pair<Teuchos::RCP<Functions::MeshPartition>, WRMList> WRMPartition;
 typedef std::vector<Teuchos::RCP<WRMPermafrostModel> > WRMPermafrostModelList;
 typedef std::pair<Teuchos::RCP<Functions::MeshPartition>, WRMPermafrostModelList> WRMPermafrostModelPartition;
 
+// Cells of each region of a partition, as contiguous, increasing lists, so
+// that evaluators can loop region by region and resolve the model once per
+// region instead of once per cell.
+typedef std::vector<AmanziMesh::Entity_ID_List> PartitionCellLists;
+
 // Non-member factory
 Teuchos::RCP<WRMPartition>
 createWRMPartition(Teuchos::ParameterList& plist);
@@ -29,6 +34,12 @@ Teuchos::RCP<WRMPermafrostModelPartition>
 createWRMPermafrostModelPartition(Teuchos::ParameterList& plist,
         Teuchos::RCP<WRMPartition>& wrms);
 
+// Sorts the first ncells cells of an initialized partition into one list per
+// region.  Cells in no region are skipped.
+void
+getPartitionCellLists(const Teuchos::RCP<Functions::MeshPartition>& part,
+                      int nregions, int ncells, PartitionCellLists& cell_lists);
+
 } // namespace
 } // namespace
 
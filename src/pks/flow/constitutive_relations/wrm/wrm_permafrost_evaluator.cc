@@ -69,7 +69,8 @@ WRMPermafrostEvaluator::WRMPermafrostEvaluator(const WRMPermafrostEvaluator& oth
     SecondaryVariablesFieldEvaluator(other),
     pc_liq_key_(other.pc_liq_key_),
     pc_ice_key_(other.pc_ice_key_),
-    permafrost_models_(other.permafrost_models_) {}
+    permafrost_models_(other.permafrost_models_),
+    region_cells_(other.region_cells_) {}
 
 
 /* --------------------------------------------------------------------------------
@@ -156,6 +157,11 @@ void WRMPermafrostEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
     permafrost_models_->first->Initialize(results[0]->Mesh(), -1);
     permafrost_models_->first->Verify();
   }
+  if (region_cells_.size() == 0) {
+    getPartitionCellLists(permafrost_models_->first, permafrost_models_->second.size(),
+                          results[0]->ViewComponent("cell",false)->MyLength(),
+                          region_cells_);
+  }
 
   // Cell values
   Epetra_MultiVector& satg_c = *results[0]->ViewComponent("cell",false);
@@ -168,13 +174,14 @@ void WRMPermafrostEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
       ->ViewComponent("cell",false);
 
   double sats[3];
-  int ncells = satg_c.MyLength();
-  for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-    int i = (*permafrost_models_->first)[c];
-    permafrost_models_->second[i]->saturations(pc_liq_c[0][c], pc_ice_c[0][c], sats);
-    satg_c[0][c] = sats[0];
-    satl_c[0][c] = sats[1];
-    sati_c[0][c] = sats[2];
+  for (int r=0; r!=region_cells_.size(); ++r) {
+    WRMPermafrostModel& model = *permafrost_models_->second[r];
+    for (auto c : region_cells_[r]) {
+      model.saturations(pc_liq_c[0][c], pc_ice_c[0][c], sats);
+      satg_c[0][c] = sats[0];
+      satl_c[0][c] = sats[1];
+      sati_c[0][c] = sats[2];
+    }
   }
 
   // Potentially do face values as well, though only for saturation_liquid?
@@ -220,6 +227,11 @@ WRMPermafrostEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State
     permafrost_models_->first->Initialize(results[0]->Mesh(), -1);
     permafrost_models_->first->Verify();
   }
+  if (region_cells_.size() == 0) {
+    getPartitionCellLists(permafrost_models_->first, permafrost_models_->second.size(),
+                          results[0]->ViewComponent("cell",false)->MyLength(),
+                          region_cells_);
+  }
 
   // Cell values
   Epetra_MultiVector& satg_c = *results[0]->ViewComponent("cell",false);
@@ -233,27 +245,25 @@ WRMPermafrostEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State
 
   double dsats[3];
   if (wrt_key == pc_liq_key_) {
-    int ncells = satg_c.MyLength();
-    for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-      int i = (*permafrost_models_->first)[c];
-      permafrost_models_->second[i]->dsaturations_dpc_liq(
-          pc_liq_c[0][c], pc_ice_c[0][c], dsats);
-
-      satg_c[0][c] = dsats[0];
-      satl_c[0][c] = dsats[1];
-      sati_c[0][c] = dsats[2];
+    for (int r=0; r!=region_cells_.size(); ++r) {
+      WRMPermafrostModel& model = *permafrost_models_->second[r];
+      for (auto c : region_cells_[r]) {
+        model.dsaturations_dpc_liq(pc_liq_c[0][c], pc_ice_c[0][c], dsats);
+        satg_c[0][c] = dsats[0];
+        satl_c[0][c] = dsats[1];
+        sati_c[0][c] = dsats[2];
+      }
     }
 
   } else if (wrt_key == pc_ice_key_) {
-    int ncells = satg_c.MyLength();
-    for (AmanziMesh::Entity_ID c=0; c!=ncells; ++c) {
-      int i = (*permafrost_models_->first)[c];
-      permafrost_models_->second[i]->dsaturations_dpc_ice(
-          pc_liq_c[0][c], pc_ice_c[0][c], dsats);
-
-      satg_c[0][c] = dsats[0];
-      satl_c[0][c] = dsats[1];
-      sati_c[0][c] = dsats[2];
+    for (int r=0; r!=region_cells_.size(); ++r) {
+      WRMPermafrostModel& model = *permafrost_models_->second[r];
+      for (auto c : region_cells_[r]) {
+        model.dsaturations_dpc_ice(pc_liq_c[0][c], pc_ice_c[0][c], dsats);
+        satg_c[0][c] = dsats[0];
+        satl_c[0][c] = dsats[1];
+        sati_c[0][c] = dsats[2];
+      }
     }
   } else {
     ASSERT(0);
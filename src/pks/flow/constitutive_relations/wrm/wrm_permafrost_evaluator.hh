@@ -49,6 +49,7 @@ class WRMPermafrostEvaluator : public SecondaryVariablesFieldEvaluator {
 
   Teuchos::RCP<WRMPermafrostModelPartition> permafrost_models_;
   Teuchos::RCP<WRMPartition> wrms_;
+  PartitionCellLists region_cells_;
 
  private:
   static Utils::RegisteredFactory<FieldEvaluator,WRMPermafrostEvaluator> factory_;
@@ -188,8 +188,8 @@ protected:
   // boundary condition members
   virtual void UpdateBoundaryConditions_(const Teuchos::Ptr<State>& S, bool kr=true);
 
-  // -- builds tensor K, along with faced-based Krel if needed by the rel-perm method
-  virtual void SetAbsolutePermeabilityTensor_(const Teuchos::Ptr<State>& S);
+  // -- builds tensor K, returning true if it was rebuilt (permeability changed)
+  virtual bool SetAbsolutePermeabilityTensor_(const Teuchos::Ptr<State>& S);
   virtual bool UpdatePermeabilityData_(const Teuchos::Ptr<State>& S);
   virtual bool UpdatePermeabilityDerivativeData_(const Teuchos::Ptr<State>& S);
 
@@ -315,6 +315,13 @@ protected:
   Teuchos::RCP<Functions::BoundaryFunction> bc_seepage_infilt_;
   Teuchos::RCP<Functions::BoundaryFunction> bc_infiltration_;
 
+  // -- change tracking: BCs are only rebuilt when time or kr changes, unless
+  //    they depend upon the state (seepage, surface coupling, freezing)
+  AmanziMesh::Entity_ID_List boundary_faces_;
+  double bc_update_time_;
+  bool bc_update_kr_;
+  int bcs_state_dependent_; // -1 until determined, then 0 or 1
+
   // delegates
   bool modify_predictor_bc_flux_;
   bool modify_predictor_first_bc_flux_;
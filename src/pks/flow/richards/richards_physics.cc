@@ -131,10 +131,15 @@ void Richards::AddSourcesToPrecon_(const Teuchos::Ptr<State>& S, double h) {
 
 // -------------------------------------------------------------
 // Convert abs perm vector to tensor.
+//
+//   Returns true if the tensor was rebuilt, which happens only when the
+//   permeability has changed since this PK last asked.
 // -------------------------------------------------------------
-void Richards::SetAbsolutePermeabilityTensor_(const Teuchos::Ptr<State>& S) {
+bool Richards::SetAbsolutePermeabilityTensor_(const Teuchos::Ptr<State>& S) {
   // currently assumes isotropic perm, should be updated
-  S->GetFieldEvaluator(perm_key_)->HasFieldChanged(S.ptr(), name_);
+  bool update = S->GetFieldEvaluator(perm_key_)->HasFieldChanged(S.ptr(), name_);
+  if (!update) return false;
+
   const Epetra_MultiVector& perm = *S->GetFieldData(perm_key_)
       ->ViewComponent("cell",false);
   unsigned int ncells = perm.MyLength();
@@ -162,6 +167,7 @@ void Richards::SetAbsolutePermeabilityTensor_(const Teuchos::Ptr<State>& S) {
     // ERROR -- unknown perm type
     ASSERT(0);
   }
+  return true;
 };
 
 
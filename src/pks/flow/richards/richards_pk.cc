@@ -7,6 +7,8 @@ Authors: Neil Carlson (version 1)
          Konstantin Lipnikov (version 2) (lipnikov@lanl.gov)
          Ethan Coon (ATS version) (ecoon@lanl.gov)
 ------------------------------------------------------------------------- */
+#include <limits>
+
 #include "boost/math/special_functions/fpclassify.hpp"
 
 #include "boost/algorithm/string/predicate.hpp"
@@ -130,6 +132,9 @@ void Richards::SetupRichardsFlow_(const Teuchos::Ptr<State>& S) {
   int nfaces = mesh_->num_entities(AmanziMesh::FACE, AmanziMesh::USED);
   bc_markers_.resize(nfaces, Operators::OPERATOR_BC_NONE);
   bc_values_.resize(nfaces, 0.0);
+  bc_update_time_ = std::numeric_limits<double>::quiet_NaN();
+  bc_update_kr_ = true;
+  bcs_state_dependent_ = -1;
   std::vector<double> mixed;
   bc_ = Teuchos::rcp(new Operators::BCs(Operators::OPERATOR_BC_TYPE_FACE, bc_markers_, bc_values_, mixed));
 
@@ -667,6 +672,15 @@ bool Richards::UpdatePermeabilityData_(const Teuchos::Ptr<State>& S) {
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
     *vo_->os() << "  Updating permeability?";
 
+  // absolute permeability -- only if it has changed, in which case the
+  // operators must recompute transmissibilities/mass matrices
+  bool update_K = SetAbsolutePermeabilityTensor_(S);
+  if (update_K) {
+    matrix_diff_->SetTensorCoefficient(K_);
+    preconditioner_diff_->SetTensorCoefficient(K_);
+    face_matrix_diff_->SetTensorCoefficient(K_);
+  }
+
   Teuchos::RCP<CompositeVector> uw_rel_perm = S->GetFieldData(uw_coef_key_, name_);
   Teuchos::RCP<const CompositeVector> rel_perm = S->GetFieldData(coef_key_);
   bool update_perm = S->GetFieldEvaluator(coef_key_)
@@ -741,7 +755,7 @@ bool Richards::UpdatePermeabilityData_(const Teuchos::Ptr<State>& S) {
   if (vo_->os_OK(Teuchos::VERB_EXTREME)) {
     *vo_->os() << " " << update_perm << std::endl;
   }
-  return update_perm;
+  return update_perm || update_K;
 };
 
 
@@ -782,6 +796,37 @@ bool Richards::UpdatePermeabilityDerivativeData_(const Teuchos::Ptr<State>& S) {
 // -----------------------------------------------------------------------------
 void Richards::UpdateBoundaryConditions_(const Teuchos::Ptr<State>& S, bool kr) {
   Teuchos::OSTab tab = vo_->getOSTab();
+
+  // On first call, find the owned boundary faces and determine whether any
+  // BC depends upon the state.  This is collective, so it is done once and
+  // the result is the same on all ranks.
+  if (bcs_state_dependent_ < 0) {
+    int nfaces_owned = mesh_->num_entities(AmanziMesh::FACE, AmanziMesh::OWNED);
+    AmanziMesh::Entity_ID_List cells;
+    for (int f=0; f!=nfaces_owned; ++f) {
+      mesh_->face_get_cells(f, AmanziMesh::USED, &cells);
+      if (cells.size() == 1) boundary_faces_.push_back(f);
+    }
+
+    int n_seepage_l = bc_seepage_->size() + bc_seepage_infilt_->size();
+    int n_seepage = 0;
+    mesh_->get_comm()->SumAll(&n_seepage_l, &n_seepage, 1);
+    bcs_state_dependent_ = (n_seepage > 0 || infiltrate_only_if_unfrozen_ ||
+                            coupled_to_surface_via_head_ ||
+                            coupled_to_surface_via_flux_) ? 1 : 0;
+  }
+
+  // Purely time-dependent BCs need not be rebuilt if the time has not
+  // changed.  Note kr == false scales by rel perm, so is state dependent.
+  if (!bcs_state_dependent_ && kr && bc_update_kr_ &&
+      S->time() == bc_update_time_) {
+    if (vo_->os_OK(Teuchos::VERB_EXTREME))
+      *vo_->os() << "  BCs unchanged." << std::endl;
+    return;
+  }
+  bc_update_time_ = S->time();
+  bc_update_kr_ = kr;
+
   if (vo_->os_OK(Teuchos::VERB_EXTREME))
     *vo_->os() << "  Updating BCs." << std::endl;
 
@@ -1046,32 +1091,13 @@ void Richards::UpdateBoundaryConditions_(const Teuchos::Ptr<State>& S, bool kr)
   }
 
   // mark all remaining boundary conditions as zero flux conditions
-  AmanziMesh::Entity_ID_List cells;
-
   int n_default = 0;
-
-  int nfaces_owned = mesh_->num_entities(AmanziMesh::FACE, AmanziMesh::OWNED);
-  for (int f = 0; f < nfaces_owned; f++) {
-    if (bc_markers_[f] == Operators::OPERATOR_BC_NONE) {
-      mesh_->face_get_cells(f, AmanziMesh::USED, &cells);
-      int ncells = cells.size();
-
-      if (ncells == 1) {
-        n_default++;
-        bc_markers_[f] = Operators::OPERATOR_BC_NEUMANN;
-        bc_values_[f] = 0.0;
-
-        // BEGIN DEBUG CRUFT        
-        /*
-        AmanziGeometry::Point normal = mesh_->face_normal(f);
-        normal /= AmanziGeometry::norm(normal);
-        if (std::abs(normal[2]) > 0.0001) {
-          std::cout << "bottom face: " << f << std::endl;
-        }
-        */
-
-        // ENDDEBUG CRUFT        
-      }
+  for (AmanziMesh::Entity_ID_List::const_iterator f=boundary_faces_.begin();
+       f!=boundary_faces_.end(); ++f) {
+    if (bc_markers_[*f] == Operators::OPERATOR_BC_NONE) {
+      n_default++;
+      bc_markers_[*f] = Operators::OPERATOR_BC_NEUMANN;
+      bc_values_[*f] = 0.0;
     }
   }
   bc_names.push_back("default (zero flux)");
@@ -0,0 +1,56 @@
+/* -*-  mode: c++; indent-tabs-mode: nil -*- */
+//! Advances a column across a sync step in substeps of its own size.
+
+/*
+  ATS is released under the three-clause BSD License. 
+  The terms of use and "as is" disclaimer for this license are 
+  provided in the top-level COPYRIGHT file.
+*/
+
+#ifndef PKS_MPC_COLUMN_SUBCYCLING_HH_
+#define PKS_MPC_COLUMN_SUBCYCLING_HH_
+
+#include <algorithm>
+
+namespace Amanzi {
+
+// Advance a column from t_old to t_new, the sync step, in steps of the
+// column's own size.  A successful substep is accepted as the start of the
+// next; a failed one is rejected, rolling the column back to the start of the
+// substep, and retried with a smaller step.  Returns true, with the column
+// rolled back to its last accepted substep, once the step falls below
+// min_rel_dt times the sync step.
+//
+// Column provides double get_dt(), bool AdvanceStep(t0, t1), true on
+// failure, and void AcceptStep() and RejectStep().
+template<class Column>
+bool AdvanceSubcycled(Column& col, double t_old, double t_new, double min_rel_dt) {
+  double sync_dt = t_new - t_old;
+  double t = t_old;
+  double dt = col.get_dt();
+
+  while (t_new - t > 0.1 * min_rel_dt * sync_dt) {
+    // do not overstep the sync time, and do not leave a sliver behind it
+    if (t + dt >= t_new)
+      dt = t_new - t;
+    else if (t + 2*dt > t_new)
+      dt = 0.5 * (t_new - t);
+
+    if (!col.AdvanceStep(t, t + dt)) {
+      col.AcceptStep();
+      t += dt;
+      dt = col.get_dt();
+    } else {
+      col.RejectStep();
+
+      // the column may have cut its own dt, but make sure the retry is smaller
+      dt = std::min<double>(col.get_dt(), 0.5 * dt);
+      if (dt < min_rel_dt * sync_dt) return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+#endif
@@ -92,6 +92,10 @@ public:
                           const Teuchos::RCP<State>& S_inter,
                           const Teuchos::RCP<State>& S_next);
 
+  // the coordinated PKs, e.g. for reporting on the whole PK tree
+  typedef std::vector<Teuchos::RCP<PK_t> > SubPKList;
+  const SubPKList& get_subpks() const { return sub_pks_; }
+
 
  protected:
   // enables inheriting MPCs to do their own sub-pk construction
@@ -99,7 +103,6 @@ public:
 
  protected:
   
-  typedef std::vector<Teuchos::RCP<PK_t> > SubPKList;
   Teuchos::RCP<Teuchos::ParameterList> global_list_;
   Teuchos::ParameterList pk_tree_;
   Teuchos::RCP<Teuchos::ParameterList> pks_list_;
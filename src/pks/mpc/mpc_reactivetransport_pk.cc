@@ -25,7 +25,6 @@ ReactiveTransport_PK_ATS::ReactiveTransport_PK_ATS(Teuchos::ParameterList& pk_tr
   Amanzi::PK_MPCAdditive<PK>(pk_tree, global_list, S, soln)
  { 
 
-  storage_created = false;
   chem_step_succeeded = true;
 
   tranport_pk_ = Teuchos::rcp_dynamic_cast<Transport::Transport_PK_ATS>(sub_pks_[1]);
@@ -50,13 +49,6 @@ ReactiveTransport_PK_ATS::ReactiveTransport_PK_ATS(Teuchos::ParameterList& pk_tr
 // -----------------------------------------------------------------------------
 void ReactiveTransport_PK_ATS::Initialize(const Teuchos::Ptr<State>& S) {
   Amanzi::PK_MPCAdditive<PK>::Initialize(S);
-
-  if (S->HasField("total_component_concentration")) {
-    total_component_concentration_stor = 
-       Teuchos::rcp(new Epetra_MultiVector(*S->GetFieldData("total_component_concentration")
-                                             ->ViewComponent("cell", true)));
-    storage_created = true;
-  }
 }
 
 
@@ -115,22 +107,22 @@ bool ReactiveTransport_PK_ATS::AdvanceStep(double t_old, double t_new, bool rein
   bool pk_fail = tranport_pk_->AdvanceStep(t_old, t_new, reinit);
 
   // Right now transport step is always succeeded.
-  if (!pk_fail) {
-    *total_component_concentration_stor = *tranport_pk_->total_component_concentration()->ViewComponent("cell", true);
-  } else {
+  if (pk_fail) {
     Errors::Message message("MPC: Transport PK returned an unexpected error.");
     Exceptions::amanzi_throw(message);
   }
 
-  // Second, we do a chemistry step.
+  // Second, we do a chemistry step, in place on the transport result.
+  Teuchos::RCP<Epetra_MultiVector> tcc =
+      tranport_pk_->total_component_concentration()->ViewComponent("cell", true);
   try {
-    chemistry_pk_->set_aqueous_components(total_component_concentration_stor);
+    chemistry_pk_->set_aqueous_components(tcc);
 
     pk_fail = chemistry_pk_->AdvanceStep(t_old, t_new, reinit);
     chem_step_succeeded = true;
  
     *S_->GetFieldData("total_component_concentration", "state")
-       ->ViewComponent("cell", true) = *chemistry_pk_->aqueous_components();
+       ->ViewComponent("cell", true) = *tcc;
   }
   catch (const Errors::Message& chem_error) {
     fail = true;
@@ -9,6 +9,9 @@
   Authors: Daniil Svyatskiy
 
   Process kernel for coupling of Transport_PK and Chemistry_PK.
+
+  Chemistry works in place on the transport PK's result, so the only copy of
+  the species array per step is the final one into State.
 */
 
 
@@ -54,15 +57,11 @@ class ReactiveTransport_PK_ATS : public PK_MPCAdditive<PK> {
   std::string name() { return "reactive transport"; } 
 
  private:
-  // storage for the component concentration intermediate values
-  Teuchos::RCP<Epetra_MultiVector> total_component_concentration_stor;
-
   Teuchos::RCP<Transport::Transport_PK_ATS> tranport_pk_;
   Teuchos::RCP<AmanziChemistry::Chemistry_PK> chemistry_pk_;
   // int master_, slave_;
 
   bool chem_step_succeeded;
-  bool storage_created;
   double dTtran_, dTchem_;
 
   // factory registration
@@ -0,0 +1,125 @@
+/*
+  Testing of column subcycling and the rollback of failed columns.
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "UnitTest++.h"
+
+#include "column_subcycling.hh"
+
+using namespace Amanzi;
+
+// A column integrating du/dt = -k u by backward Euler whose nonlinear solve
+// "fails" on any step larger than max_dt, leaving garbage in its next state,
+// like a column whose solver diverged.
+struct MockColumn {
+  MockColumn(double u0, double dt, double max_dt) :
+      u_inter(u0), u_next(u0), k(2.), dt_(dt), max_dt_(max_dt), nrejected(0) {}
+
+  double get_dt() { return dt_; }
+
+  bool AdvanceStep(double t_old, double t_new) {
+    double dt = t_new - t_old;
+    if (dt > max_dt_) {
+      u_next = -1.e10;
+      dt_ = 0.5 * dt;
+      return true;
+    }
+    u_next = u_inter / (1. + k*dt);
+    steps.push_back(dt);
+    return false;
+  }
+
+  void AcceptStep() { u_inter = u_next; }
+  void RejectStep() { u_next = u_inter; nrejected++; }
+
+  // the solution over the accepted steps, in the order they were taken
+  double Expected(double u0) const {
+    double u = u0;
+    for (int i=0; i!=(int) steps.size(); ++i) u /= 1. + k*steps[i];
+    return u;
+  }
+
+  double u_inter, u_next, k;
+  double dt_, max_dt_;
+  int nrejected;
+  std::vector<double> steps;
+};
+
+
+SUITE(COLUMN_SUBCYCLING) {
+
+  // A column that converges on the sync step takes it in one step.
+  TEST(CONVERGED_COLUMN_TAKES_THE_SYNC_STEP) {
+    MockColumn col(1., 10., 10.);
+    CHECK(!AdvanceSubcycled(col, 0., 1., 1.e-5));
+    CHECK_EQUAL(1, (int) col.steps.size());
+    CHECK_EQUAL(0, col.nrejected);
+    CHECK_CLOSE(1./3., col.u_next, 1.e-14);
+  }
+
+  // The isolated failure path of WeakMPCSemiCoupled: the column fails the
+  // sync step, is rolled back to the start of the step, and is subcycled to
+  // the sync time.
+  TEST(FAILED_COLUMN_IS_ROLLED_BACK_AND_SUBCYCLED) {
+    double u0 = 1.;
+    MockColumn col(u0, 1., 0.3);
+    CHECK(col.AdvanceStep(0., 1.));
+    CHECK(col.u_next != u0);
+
+    col.RejectStep();
+    CHECK_EQUAL(u0, col.u_next);
+
+    CHECK(!AdvanceSubcycled(col, 0., 1., 1.e-5));
+    CHECK(col.steps.size() > 1);
+
+    // the substeps reach the sync time exactly, and none is a sliver
+    double t = 0.;
+    for (int i=0; i!=(int) col.steps.size(); ++i) {
+      CHECK(col.steps[i] <= 0.3);
+      CHECK(col.steps[i] > 0.1);
+      t += col.steps[i];
+    }
+    CHECK_CLOSE(1., t, 1.e-14);
+
+    // garbage from the failed attempts never entered the solution
+    CHECK_CLOSE(col.Expected(u0), col.u_next, 1.e-14);
+    CHECK_EQUAL(col.u_next, col.u_inter);
+  }
+
+  // A column that cannot take any step fails once its step is below the
+  // minimum, rolled back to the start of the step.
+  TEST(COLUMN_THAT_NEVER_CONVERGES_FAILS) {
+    double u0 = 1.;
+    MockColumn col(u0, 1., 0.);
+    CHECK(AdvanceSubcycled(col, 0., 1., 1.e-5));
+    CHECK_EQUAL(0, (int) col.steps.size());
+    CHECK(col.nrejected > 0);
+    CHECK_EQUAL(u0, col.u_next);
+    CHECK_EQUAL(u0, col.u_inter);
+  }
+
+  // A column that fails part way keeps its accepted substeps in the
+  // intermediate state, and its next state is rolled back to them.
+  TEST(COLUMN_FAILING_PART_WAY_KEEPS_ACCEPTED_SUBSTEPS) {
+    double u0 = 1.;
+    MockColumn col(u0, 0.25, 0.25);
+    struct FailsAfterHalf : MockColumn {
+      FailsAfterHalf(const MockColumn& col) : MockColumn(col) {}
+      bool AdvanceStep(double t_old, double t_new) {
+        if (t_old >= 0.5) {
+          u_next = -1.e10;
+          return true;
+        }
+        return MockColumn::AdvanceStep(t_old, t_new);
+      }
+    } failing(col);
+
+    CHECK(AdvanceSubcycled(failing, 0., 1., 1.e-5));
+    CHECK_EQUAL(2, (int) failing.steps.size());
+    CHECK_CLOSE(failing.Expected(u0), failing.u_inter, 1.e-14);
+    CHECK_EQUAL(failing.u_inter, failing.u_next);
+  }
+}
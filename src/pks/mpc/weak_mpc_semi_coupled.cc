@@ -3,6 +3,7 @@
 //#include "pk_physical_bdf_base.hh"
 #include "mpc_surface_subsurface_helpers.hh"
 #include "strong_mpc.hh"
+#include "column_subcycling.hh"
 
 #include "weak_mpc_semi_coupled.hh"
 #include "weak_mpc_semi_coupled_helper.hh"
@@ -15,12 +16,59 @@ namespace Amanzi {
   unsigned WeakMPCSemiCoupled::flag_star_surf = 0;
 
 
+// -----------------------------------------------------------------------------
+// The i-th column, as advanced by AdvanceSubcycled().  An accepted substep is
+// copied into S_inter_ as the start of the next; a rejected one resets the
+// column's S_next_ from S_inter_.
+// -----------------------------------------------------------------------------
+class WeakMPCSemiCoupled::SubcycledColumn_ {
+ public:
+  SubcycledColumn_(WeakMPCSemiCoupled& mpc, int i, bool reinit) :
+      mpc_(mpc),
+      i_(i),
+      reinit_(reinit),
+      pk_(mpc.sub_pks_[i+1]) {
+    id_ = mpc_.S_->GetMesh("surface")->cell_map(false).GID(i);
+  }
+
+  double get_dt() { return pk_->get_dt(); }
+
+  bool AdvanceStep(double t_old, double t_new) {
+    mpc_.S_inter_->set_time(t_old);
+    mpc_.S_next_->set_time(t_new);
+    bool fail = pk_->AdvanceStep(t_old, t_new, reinit_);
+    fail |= !pk_->ValidStep();
+    return fail;
+  }
+
+  void AcceptStep() {
+    UpdateIntermediateStateParameters(mpc_.S_next_, mpc_.S_inter_, id_);
+    mpc_.ColumnChangedSolution_(i_, mpc_.S_inter_);
+  }
+
+  void RejectStep() {
+    UpdateNextStateParameters(mpc_.S_next_, mpc_.S_inter_, id_);
+    mpc_.ColumnChangedSolution_(i_, mpc_.S_next_);
+  }
+
+ private:
+  WeakMPCSemiCoupled& mpc_;
+  int i_, id_;
+  bool reinit_;
+  Teuchos::RCP<PK> pk_;
+};
+
+
+
 WeakMPCSemiCoupled::WeakMPCSemiCoupled(Teuchos::ParameterList& pk_tree,
         const Teuchos::RCP<Teuchos::ParameterList>& global_plist,
         const Teuchos::RCP<State>& S,
         const Teuchos::RCP<TreeVector>& solution)
     : PK(pk_tree, global_plist, S, solution),
       MPC<PK>(pk_tree, global_plist, S, solution),
+      subcycle_key_(false),
+      min_subcycle_dt_(1.e-5),
+      isolate_failures_(false),
       sg_model_(false)
 {
   // grab the list of subpks
@@ -46,6 +94,7 @@ WeakMPCSemiCoupled::WeakMPCSemiCoupled(Teuchos::ParameterList& pk_tree,
     subpks.push_back(Keys::getKey(domain_name_stream.str(), std::get<2>(col_triple)));
   }
   numPKs_ = subpks.size();
+  sub_pks_.reserve(numPKs_);
 
   PKFactory pk_factory;
 
@@ -74,11 +123,16 @@ WeakMPCSemiCoupled::WeakMPCSemiCoupled(Teuchos::ParameterList& pk_tree,
 
 
 // must communicate dts since columns are serial
+// -- when subcycling, columns take their own steps and the star system sets dt
 double WeakMPCSemiCoupled::get_dt() {
   double dt = 1.0e99;
-  for (MPC<PK>::SubPKList::iterator pk = sub_pks_.begin();
-       pk != sub_pks_.end(); ++pk) {
-    dt = std::min<double>(dt,(*pk)->get_dt());
+  if (subcycle_key_) {
+    dt = sub_pks_[0]->get_dt();
+  } else {
+    for (MPC<PK>::SubPKList::iterator pk = sub_pks_.begin();
+         pk != sub_pks_.end(); ++pk) {
+      dt = std::min<double>(dt,(*pk)->get_dt());
+    }
   }
   
   double dt_local = dt;
@@ -91,6 +145,12 @@ double WeakMPCSemiCoupled::get_dt() {
 // Set timestep for sub PKs 
 // -----------------------------------------------------------------------------
 void WeakMPCSemiCoupled::set_dt( double dt) {
+  // subcycled columns keep their own step sizes
+  if (subcycle_key_) {
+    sub_pks_[0]->set_dt(dt);
+    return;
+  }
+
   for (MPC<PK>::SubPKList::iterator pk = sub_pks_.begin();
        pk != sub_pks_.end(); ++pk) {
     (*pk)->set_dt(dt);
@@ -100,6 +160,20 @@ void WeakMPCSemiCoupled::set_dt( double dt) {
 
 
 
+// -----------------------------------------------------------------------------
+// Commit the accepted step.  Subcycled and retried columns are committed here
+// too, over the whole step, and never during their substeps: a substep commit
+// would stay in the column's time integrator history if the global step then
+// failed.
+// -----------------------------------------------------------------------------
+void WeakMPCSemiCoupled::CommitStep(double t_old, double t_new,
+        const Teuchos::RCP<State>& S) {
+  for (int i=0; i<numPKs_; i++) {
+    sub_pks_[i]->CommitStep(t_old, t_new, S);
+  }
+}
+
+
 // -----------------------------------------------------------------------------
 // Set up each PK
 // -----------------------------------------------------------------------------
@@ -110,6 +184,12 @@ WeakMPCSemiCoupled::Setup(const Teuchos::Ptr<State>& S) {
   
   coupling_key_ = plist_->get<std::string>("coupling key"," ");
   subcycle_key_ = plist_->get<bool>("subcycle",false);
+  // smallest column step, relative to the star system's step, before a
+  // subcycled column is considered failed
+  min_subcycle_dt_ = plist_->get<double>("minimum subcycled relative dt", 1.e-5);
+  // if true, a column that fails is rolled back alone and subcycled to the
+  // sync time instead of failing the whole step
+  isolate_failures_ = plist_->get<bool>("isolate column failures", false);
 
   // by default sg_model_ is false
   if (S->FEList().isSublist("surface_star-depression_depth"))
@@ -260,148 +340,50 @@ WeakMPCSemiCoupled::CoupledSurfSubsurfColumns(double t_old, double t_new, bool r
   }
 
   int nfailed = 0;
-  int count=0;
   double t0 = S_inter_->time();
   double t1 = S_next_->time();
 
-  auto sub_pk = sub_pks_.begin();
-  ++sub_pk;
-  for (auto pk = sub_pk; pk!=sub_pks_.end(); ++pk){
+  int nretried = 0;
+  retried_.assign(numPKs_-1, false);
 
+  for (int i=0; i<numPKs_-1; i++){
+    bool c_fail = false;
     if(!subcycle_key_){  
-      bool c_fail = (*pk)->AdvanceStep(t_old, t_new, reinit);
-      if (c_fail) nfailed++;
-    }
-    else
-      {
-      std::stringstream name, name_ss;
-      int id = S_->GetMesh("surface")->cell_map(false).GID(count);
-      name << "surface_column_" << id;
-      name_ss << "column_" << id;
-      
-      double loc_dt =0;//revisit dt;      
-          
-      bool done = false;
-      double t = 0;
-      bool cyc_flag  = false;
-      //      S_inter_->set_time(t0+t);
-      //S_next_->set_time(t0 + t + loc_dt);
-      //lets put dt=0 for a while---revisit
-      double dt =0;
-      while(!done){
-	bool fail_pk = false; //----revisit= (*pk)->advance(loc_dt);
-	//fail_pk |= !(*pk)->valid_step();
-		
-	if(!fail_pk){
-
-	  //--revisit (*pk)->commit_state(loc_dt, S_next_);
-	  t = t + loc_dt;
-	  double loc_dt_old = loc_dt;
-
-	  double loc_dt_new = (*pk)->get_dt();
-	  if (dt - (t+loc_dt_new) < 1.)
-	    loc_dt_new = dt -t;
-	  else if ( t + loc_dt_new < dt && (t+2*loc_dt_new > dt ) )
-	    loc_dt_new = 0.5*(dt - t);
-
-	  loc_dt = std::min<double>(loc_dt_new, dt - t);
-	  
-	  if (loc_dt <= 1.e-10){
-	    done = true;
-	    if (cyc_flag)
-	      S_inter_->set_time(t0);
-	    }
-	  else{
+      c_fail = sub_pks_[i+1]->AdvanceStep(t_old, t_new, reinit);
+      if (isolate_failures_) c_fail |= !sub_pks_[i+1]->ValidStep();
 
-	    UpdateIntermediateStateParameters(S_next_, S_inter_,id);
-
-	   Teuchos::RCP<PrimaryVariableFieldEvaluator> pfe1 = 
-	     Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>
-	     (S_inter_->GetFieldEvaluator(Keys::getKey(name.str(),"mass_source_temperature")));
-	   
-	   pfe1->SetFieldAsChanged(S_inter_.ptr());
-
-	   Teuchos::RCP<PrimaryVariableFieldEvaluator> pfe2 = 
-	     Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>
-	     (S_inter_->GetFieldEvaluator(Keys::getKey(name.str(),"conducted_energy_source")));
-	   
-	   pfe2->SetFieldAsChanged(S_inter_.ptr());
-
-	   Teuchos::RCP<PrimaryVariableFieldEvaluator> pfe3 = 
-	     Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>
-	     (S_inter_->GetFieldEvaluator(Keys::getKey(name.str(),"mass_source")));
-	   
-	   pfe3->SetFieldAsChanged(S_inter_.ptr());
-
-	   Teuchos::RCP<PrimaryVariableFieldEvaluator> pfe4 = 
-	     Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>
-	     (S_inter_->GetFieldEvaluator(Keys::getKey(name_ss.str(),"mass_source")));
-	   
-	   pfe4->SetFieldAsChanged(S_inter_.ptr());
-	  
-	   Teuchos::RCP<PK_PhysicalBDF_Default> pk_domain =
-	     Teuchos::rcp_dynamic_cast<PK_PhysicalBDF_Default>(sub_pks_[count+1]);
-	   ASSERT(pk_domain.get()); // make sure the pk_domain is not empty
-	   pk_domain->ChangedSolution(S_inter_.ptr());
-	   
-	   S_inter_->set_time(t0+t);
-	   S_next_->set_time( t0 + t + loc_dt);
-	   
-	  }
-	  
-	}
-	else{
-	  cyc_flag = true;
-	  
-	  UpdateNextStateParameters(S_next_, S_inter_, id);
-
-	   Teuchos::RCP<PrimaryVariableFieldEvaluator> pfe1 = 
-	     Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>
-	     (S_next_->GetFieldEvaluator(Keys::getKey(name.str(),"mass_source_temperature")));
-	   
-	   pfe1->SetFieldAsChanged(S_next_.ptr());
-
-	   Teuchos::RCP<PrimaryVariableFieldEvaluator> pfe2 = 
-	     Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>
-	     (S_next_->GetFieldEvaluator(Keys::getKey(name.str(),"conducted_energy_source")));
-	   
-	   pfe2->SetFieldAsChanged(S_next_.ptr());
-
-	   Teuchos::RCP<PrimaryVariableFieldEvaluator> pfe3 = 
-	     Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>
-	     (S_next_->GetFieldEvaluator(Keys::getKey(name.str(),"mass_source")));
-	   
-	   pfe3->SetFieldAsChanged(S_next_.ptr());
-
-	   Teuchos::RCP<PrimaryVariableFieldEvaluator> pfe4 = 
-	     Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>
-	     (S_next_->GetFieldEvaluator(Keys::getKey(name_ss.str(),"mass_source")));
-	   
-	   pfe4->SetFieldAsChanged(S_next_.ptr());
-
-
-	   Teuchos::RCP<PK_PhysicalBDF_Default> pk_domain =
-	     Teuchos::rcp_dynamic_cast<PK_PhysicalBDF_Default>(sub_pks_[count+1]);
-	   ASSERT(pk_domain.get()); // make sure the pk_domain is not empty
-	   pk_domain->ChangedSolution(S_next_.ptr());
-	   
-	   loc_dt = (*pk)->get_dt();
-	   S_inter_->set_time(t0+t);
-	   // revisit S_next_->set_time(t0 + t + loc_dt);
-	}
+      if (c_fail && isolate_failures_){
+        // Roll back only this column, whose start of step is still in
+        // S_inter_, and subcycle it to the sync time.
+        SubcycledColumn_(*this, i, reinit).RejectStep();
 
+        retried_[i] = true;
+        nretried++;
+        c_fail = AdvanceColumnSubcycled_(i, t_old, t_new, reinit);
       }
-      count++;	
     }
-    
-   
+    else{
+      c_fail = AdvanceColumnSubcycled_(i, t_old, t_new, reinit);
+    }
+    if (c_fail) nfailed++;
   }
-  
+
+  S_inter_->set_time(t0);
+  S_next_->set_time(t1);
 
   MPI_Barrier(MPI_COMM_WORLD);  
 
-  int nfailed_local = nfailed;
-  S_->GetMesh("surface")->get_comm()->SumAll(&nfailed_local, &nfailed, 1);
+  int nfailed_local[2] = { nfailed, nretried };
+  int nfailed_global[2];
+  S_->GetMesh("surface")->get_comm()->SumAll(nfailed_local, nfailed_global, 2);
+  nfailed = nfailed_global[0];
+  nretried = nfailed_global[1];
+
+  if (nretried > 0 && vo_->os_OK(Teuchos::VERB_HIGH)) {
+    Teuchos::OSTab tab = vo_->getOSTab();
+    *vo_->os() << nretried << " columns failed and were subcycled, "
+               << nfailed << " of them failed again" << std::endl;
+  }
  
  
   if (nfailed ==0){ 
@@ -502,13 +484,18 @@ WeakMPCSemiCoupled::CoupledSurfSubsurfColumns(double t_old, double t_new, bool r
     Teuchos::rcp_dynamic_cast<PK_BDF_Default>(sub_pks_[0]);
   ASSERT(pk_surf.get());
   pk_surf->ChangedSolution();
-  MPC<PK>::SubPKList::iterator pk1 = sub_pks_.begin();
-
-   if(subcycle_key_)
-     (*pk1)->CommitStep(t_old, t_new,S_next_);
-
   }
   if (nfailed > 0){
+    // Subcycled columns have overwritten their intermediate state with the
+    // end of their last substep; the step is retried from S_.
+    if (subcycle_key_ || isolate_failures_){
+      for (int i=0; i<numPKs_-1; i++){
+        if (!subcycle_key_ && !retried_[i]) continue;
+        int id = S_->GetMesh("surface")->cell_map(false).GID(i);
+        UpdateIntermediateStateParameters(S_, S_inter_, id);
+        ColumnChangedSolution_(i, S_inter_);
+      }
+    }
     flag_star = 1;
     return true;
   }
@@ -517,6 +504,49 @@ WeakMPCSemiCoupled::CoupledSurfSubsurfColumns(double t_old, double t_new, bool r
     return false;
   }
 }
+
+
+// -----------------------------------------------------------------------------
+// Advance the i-th column from t_old to t_new, the star system's step, in
+// steps of the column's own size.  Fails if the step falls below the minimum
+// subcycled dt.  Substeps are not committed, so the column's time integrator
+// only records the sync times; the column is committed in CommitStep() once
+// the global step is accepted.
+// -----------------------------------------------------------------------------
+bool
+WeakMPCSemiCoupled::AdvanceColumnSubcycled_(int i, double t_old, double t_new, bool reinit){
+  SubcycledColumn_ col(*this, i, reinit);
+  return AdvanceSubcycled(col, t_old, t_new, min_subcycle_dt_);
+}
+
+
+// -----------------------------------------------------------------------------
+// Mark the i-th column's primary variables and coupling sources as changed in
+// S, after they have been copied from another state.
+// -----------------------------------------------------------------------------
+void
+WeakMPCSemiCoupled::ColumnChangedSolution_(int i, const Teuchos::RCP<State>& S){
+  std::stringstream name, name_ss;
+  int id = S_->GetMesh("surface")->cell_map(false).GID(i);
+  name << "surface_column_" << id;
+  name_ss << "column_" << id;
+
+  Key sources[4] = { Keys::getKey(name.str(),"mass_source_temperature"),
+                     Keys::getKey(name.str(),"conducted_energy_source"),
+                     Keys::getKey(name.str(),"mass_source"),
+                     Keys::getKey(name_ss.str(),"mass_source") };
+  for (int k=0; k!=4; ++k){
+    Teuchos::RCP<PrimaryVariableFieldEvaluator> pfe =
+      Teuchos::rcp_dynamic_cast<PrimaryVariableFieldEvaluator>(S->GetFieldEvaluator(sources[k]));
+    ASSERT(pfe.get());
+    pfe->SetFieldAsChanged(S.ptr());
+  }
+
+  Teuchos::RCP<PK_BDF_Default> pk_domain =
+    Teuchos::rcp_dynamic_cast<PK_BDF_Default>(sub_pks_[i+1]);
+  ASSERT(pk_domain.get()); // make sure the pk_domain is not empty
+  pk_domain->ChangedSolution(S.ptr());
+}
   
 
 bool 
@@ -21,6 +21,7 @@ class WeakMPCSemiCoupled : public MPC<PK> {
   virtual void set_dt(double dt);
 
   virtual bool AdvanceStep(double t_old, double t_new, bool reinit); //virtual bool advance (double dt);
+  virtual void CommitStep(double t_old, double t_new, const Teuchos::RCP<State>& S);
   virtual void Setup(const Teuchos::Ptr<State>& S);
 
 
@@ -32,6 +33,11 @@ class WeakMPCSemiCoupled : public MPC<PK> {
   double FindVolumetricHead(double d, double delta_max, double delta_ex);
   double VolumetricHead(double x, double a, double b, double d);
 
+
+ protected:
+  class SubcycledColumn_;
+  bool AdvanceColumnSubcycled_(int i, double t_old, double t_new, bool reinit);
+  void ColumnChangedSolution_(int i, const Teuchos::RCP<State>& S);
   
 private :
   static RegisteredPKFactory<WeakMPCSemiCoupled> reg_;
@@ -39,6 +45,9 @@ private :
   static unsigned flag_star, flag_star_surf;
   Key coupling_key_ ;
   bool subcycle_key_ ;
+  double min_subcycle_dt_;
+  bool isolate_failures_;
+  std::vector<bool> retried_;
   
 
   bool sg_model_;
@@ -4,10 +4,15 @@ namespace Amanzi{
 
 void
 UpdateIntermediateStateParameters(Teuchos::RCP<Amanzi::State>& S_next_, Teuchos::RCP<Amanzi::State>& S_inter_, int id){
+  UpdateIntermediateStateParameters(Teuchos::RCP<const Amanzi::State>(S_next_), S_inter_, id);
+}
+
+void
+UpdateIntermediateStateParameters(const Teuchos::RCP<const Amanzi::State>& S_next_, Teuchos::RCP<Amanzi::State>& S_inter_, int id){
 
   std::stringstream name, name_ss;
      
-  name << "column_" << id <<"_surface";
+  name << "surface_column_" << id;
   name_ss << "column_" << id;
       
 	  *S_inter_->GetFieldData(Keys::getKey(name_ss.str(),"pressure"), S_inter_->GetField(Keys::getKey(name_ss.str(),"pressure"))->owner()) = 
@@ -90,7 +95,7 @@ void
 UpdateNextStateParameters(Teuchos::RCP<Amanzi::State>& S_next_, Teuchos::RCP<Amanzi::State>& S_inter_, int id){
   std::stringstream name, name_ss;
       
-      name << "column_" << id <<"_surface";
+      name << "surface_column_" << id;
       name_ss << "column_" << id;
       
   
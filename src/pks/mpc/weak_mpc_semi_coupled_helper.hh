@@ -8,6 +8,10 @@ namespace Amanzi{
 void
 UpdateIntermediateStateParameters(Teuchos::RCP<Amanzi::State>& S_next_, Teuchos::RCP<Amanzi::State>& S_inter_, int id);
 
+// copies from a read-only state, e.g. the start of the step
+void
+UpdateIntermediateStateParameters(const Teuchos::RCP<const Amanzi::State>& S_next_, Teuchos::RCP<Amanzi::State>& S_inter_, int id);
+
 void
 UpdateNextStateParameters(Teuchos::RCP<Amanzi::State>& S_next_, Teuchos::RCP<Amanzi::State>& S_inter_, int id);
 
@@ -127,6 +127,12 @@ class PK_BDF_Default : public PK_BDF {
   virtual void ChangedSolution() = 0;
   virtual void ChangedSolution(const Teuchos::Ptr<State>& S) = 0;
 
+  // Nonlinear iterations taken by this PK's time integrator, successful or
+  // not, for performance reporting.  Zero for a strongly coupled PK.
+  int NonlinearIterations() const {
+    return time_stepper_ == Teuchos::null ? 0 : time_stepper_->number_nonlinear_steps();
+  }
+
  
  protected: // data
   // preconditioner assembly control
@@ -31,6 +31,8 @@
  *
  * ------------------------------------------------------------------------- */
 
+#include <vector>
+#include <algorithm>
 
 #include "surface_top_cells_evaluator.hh"
 
@@ -82,6 +84,9 @@ SurfaceBalanceSEB::SurfaceBalanceSEB(Teuchos::ParameterList& pk_tree,
   // albedo transition depth
   albedo_trans_ = plist_->get<double>("albedo transition depth", 0.02);
 
+  // number of cells over which the snow temperature solve is batched
+  batch_size_ = plist_->get<int>("SEB batch size", 256);
+
 }
 
 
@@ -293,19 +298,12 @@ bool SurfaceBalanceSEB::AdvanceStep(double t_old, double t_new, bool reinit) {
       *S_next_->GetFieldData("snow_temperature", name_)->ViewComponent("cell", false);
 
   // Create the SEB data structure
-  SurfaceEnergyBalance::LocalData data;
-  data.st_energy.dt = dt;
-  data.st_energy.AlbedoTrans = albedo_trans_;
-
-  SurfaceEnergyBalance::LocalData data_bare;
-  data_bare.st_energy.dt = dt;
-  data_bare.st_energy.AlbedoTrans = albedo_trans_;
-
-   data.vp_ground.relative_humidity=1;
-   data_bare.vp_ground.relative_humidity=1;
+  SurfaceEnergyBalance::LocalData data_proto;
+  data_proto.st_energy.dt = dt;
+  data_proto.st_energy.AlbedoTrans = albedo_trans_;
+  data_proto.vp_ground.relative_humidity=1;
 
-
-   data.st_energy.Zo=0.005;
+   data_proto.st_energy.Zo=0.005;
    if (air_temp[0][0] > 270){// Little ditty I wrote for the roughness lenght ~ AA 1/10/14
       double Zsmooth = 0.005;
       double Zrough = 0.04;
@@ -313,134 +311,138 @@ bool SurfaceBalanceSEB::AdvanceStep(double t_old, double t_new, bool reinit) {
       if (air_temp[0][0]>=280){
        Zfraction = 0;
        }
-     data.st_energy.Zo=(Zsmooth*Zfraction) + (Zrough*(1-Zfraction));
+     data_proto.st_energy.Zo=(Zsmooth*Zfraction) + (Zrough*(1-Zfraction));
     }
 
-  // loop over all cells and call CalculateSEB_
+  // loop over blocks of cells, batching the SEB (and therefore the snow
+  // temperature solve) over all cells in the block
+  std::vector<SurfaceEnergyBalance::LocalData> data;
+  std::vector<SurfaceEnergyBalance::LocalData> data_bare;
+  std::vector<int> bare_lane;
+  std::vector<double> theta;
+
   int ncells = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
-  for (int c=0; c!=ncells; ++c) {
-    // ATS Calcualted Data
-    double density_air = 1.275;       // Density of Air ------------------- [kg/m^3]
-    data.st_energy.water_depth = ponded_depth[0][c];
-    data.st_energy.water_fraction = unfrozen_fraction[0][c];
-    data.st_energy.temp_ground = surf_temp[0][c];
-    data.vp_ground.temp = surf_temp[0][c];
-    // Convert mol fraction to vapor pressure [moleFraction/atmosphericPressure]
-    data.vp_ground.actual_vaporpressure = soil_vapor_mol_fraction[0][c] * data.st_energy.Apa;
-    data.st_energy.porrowaLe = surf_porosity[0][c] * density_air * data.st_energy.Le;
-    // MET station data
-    data.st_energy.temp_air = air_temp[0][c];
-    data.st_energy.QswIn = incoming_shortwave[0][c];
-    data.st_energy.Us = std::max(wind_speed[0][c], min_wind_speed_);
-    data.st_energy.Pr = precip_rain[0][c] * dt; // SEB expects total precip, not rate
-    data.st_energy.Ps = precip_snow[0][c] * dt; // SEB expects total precip, not rate
-    data.vp_air.temp = air_temp[0][c];
-    data.vp_air.relative_humidity = relative_humidity[0][c];
-    // STORED INFO FOR SnowEnergyBalanc Model
-    data.st_energy.ht_snow = snow_depth[0][c];
-    data.st_energy.density_snow = snow_density[0][c];
-    data.st_energy.age_snow = days_of_nosnow[0][c];
-
-    // Snow-ground Smoothing
-    // -- zero out if just small
-    if (data.st_energy.ht_snow < no_snow_trans_)
-      data.st_energy.ht_snow = 0.;
-
-    if ((data.st_energy.ht_snow > snow_ground_trans_) ||
-        (data.st_energy.ht_snow <= 0)) {
-      SurfaceEnergyBalance::SnowEnergyBalance(data);
-    } else { // Transition between Snow and bare ground
-      double theta=0.0;
-
-      // Fraction of snow covered ground
-      //      theta = pow ((data.st_energy.ht_snow / snow_ground_trans_),2);
-      theta = data.st_energy.ht_snow / snow_ground_trans_;
-
-      // Calculate as if ht_snow is the min value.
-      data.st_energy.ht_snow = snow_ground_trans_;
-      SurfaceEnergyBalance::SnowEnergyBalance(data);
-
-      // Calculate as if bare ground
+  for (int c_begin=0; c_begin < ncells; c_begin += batch_size_) {
+    int c_end = std::min(c_begin + batch_size_, ncells);
+    data.assign(c_end - c_begin, data_proto);
+    data_bare.clear();
+    bare_lane.assign(c_end - c_begin, -1);
+    theta.assign(c_end - c_begin, 1.);
+
+    for (int c=c_begin; c!=c_end; ++c) {
+      SurfaceEnergyBalance::LocalData& data_c = data[c - c_begin];
+
       // ATS Calcualted Data
-      data_bare.st_energy.water_depth = ponded_depth[0][c];
-      data_bare.st_energy.water_fraction = unfrozen_fraction[0][c];
-      data_bare.st_energy.temp_ground = surf_temp[0][c];
-      data_bare.vp_ground.temp = surf_temp[0][c];
-      //Convert Mol fraction to vapor pressure [molFraction/atmosphericPressure]
-      data_bare.vp_ground.actual_vaporpressure = soil_vapor_mol_fraction[0][c] * data_bare.st_energy.Apa; 
-
-      data_bare.st_energy.porrowaLe = surf_porosity[0][c] * density_air * data_bare.st_energy.Le;
+      double density_air = 1.275;       // Density of Air ------------------- [kg/m^3]
+      data_c.st_energy.water_depth = ponded_depth[0][c];
+      data_c.st_energy.water_fraction = unfrozen_fraction[0][c];
+      data_c.st_energy.temp_ground = surf_temp[0][c];
+      data_c.vp_ground.temp = surf_temp[0][c];
+      // Convert mol fraction to vapor pressure [moleFraction/atmosphericPressure]
+      data_c.vp_ground.actual_vaporpressure = soil_vapor_mol_fraction[0][c] * data_c.st_energy.Apa;
+      data_c.st_energy.porrowaLe = surf_porosity[0][c] * density_air * data_c.st_energy.Le;
       // MET station data
-      data_bare.st_energy.temp_air = air_temp[0][c];
-      data_bare.st_energy.QswIn = incoming_shortwave[0][c];
-      data_bare.st_energy.Us = std::max(wind_speed[0][c], min_wind_speed_);
-      data_bare.st_energy.Pr = precip_rain[0][c] * dt; // SEB expects total precip, not rate
-      data_bare.st_energy.Ps = precip_snow[0][c] * dt; // SEB expects total precip, not rate
-      data_bare.vp_air.temp = air_temp[0][c];
-      data_bare.vp_air.relative_humidity = relative_humidity[0][c];
+      data_c.st_energy.temp_air = air_temp[0][c];
+      data_c.st_energy.QswIn = incoming_shortwave[0][c];
+      data_c.st_energy.Us = std::max(wind_speed[0][c], min_wind_speed_);
+      data_c.st_energy.Pr = precip_rain[0][c] * dt; // SEB expects total precip, not rate
+      data_c.st_energy.Ps = precip_snow[0][c] * dt; // SEB expects total precip, not rate
+      data_c.vp_air.temp = air_temp[0][c];
+      data_c.vp_air.relative_humidity = relative_humidity[0][c];
       // STORED INFO FOR SnowEnergyBalanc Model
-      data_bare.st_energy.ht_snow = snow_depth[0][c];
-      data_bare.st_energy.density_snow = snow_density[0][c];
-      data_bare.st_energy.age_snow = days_of_nosnow[0][c];
-      data_bare.st_energy.ht_snow = 0.;
-      SurfaceEnergyBalance::SnowEnergyBalance(data_bare);
-
-      // Calculating Data for ATS
-      data.st_energy.fQc = data.st_energy.fQc * theta + data_bare.st_energy.fQc * (1.-theta);
-      data.st_energy.Mr = data.st_energy.Mr * theta + data_bare.st_energy.Mr * (1.-theta);
-      data.st_energy.Trw = data.st_energy.Trw * theta + data_bare.st_energy.Trw * (1.-theta);
-
-      // slightly different averaging
-      double avg_dens = 0.;
-      double avg_age = 0.;
-      double ht = 0.;
-      if (data_bare.st_energy.ht_snow > 0) {
-        avg_dens += data_bare.st_energy.density_snow * data_bare.st_energy.ht_snow;
-        avg_age += data_bare.st_energy.age_snow * data_bare.st_energy.ht_snow;
-        ht += data_bare.st_energy.ht_snow;
-      }
-      if (data.st_energy.ht_snow > 0) {
-        avg_dens += data.st_energy.density_snow * data.st_energy.ht_snow;
-        avg_age += data.st_energy.age_snow * data.st_energy.ht_snow;
-        ht += data.st_energy.ht_snow;
-      }
-      if (ht > 0.) {
-        data.st_energy.density_snow = avg_dens / ht;
-        data.st_energy.age_snow = avg_age / ht;
-      } else {
-        data.st_energy.density_snow = data.st_energy.density_frost;
-        data.st_energy.age_snow = 0.;
+      data_c.st_energy.ht_snow = snow_depth[0][c];
+      data_c.st_energy.density_snow = snow_density[0][c];
+      data_c.st_energy.age_snow = days_of_nosnow[0][c];
+
+      // Snow-ground Smoothing
+      // -- zero out if just small
+      if (data_c.st_energy.ht_snow < no_snow_trans_)
+        data_c.st_energy.ht_snow = 0.;
+
+      if ((data_c.st_energy.ht_snow <= snow_ground_trans_) &&
+          (data_c.st_energy.ht_snow > 0)) { // Transition between Snow and bare ground
+        // Fraction of snow covered ground
+        //      theta = pow ((data.st_energy.ht_snow / snow_ground_trans_),2);
+        theta[c - c_begin] = data_c.st_energy.ht_snow / snow_ground_trans_;
+
+        // Calculate as if bare ground
+        bare_lane[c - c_begin] = data_bare.size();
+        data_bare.push_back(data_c);
+        data_bare.back().st_energy.ht_snow = 0.;
+
+        // Calculate as if ht_snow is the min value.
+        data_c.st_energy.ht_snow = snow_ground_trans_;
       }
-
-      data.st_energy.ht_snow = data.st_energy.ht_snow * theta + data_bare.st_energy.ht_snow * (1.-theta);
     }
 
-    // STUFF ATS WANTS
-    //    surf_energy_flux[0][c] = data.st_energy.fQc;
-    surface_water_flux[0][c] = data.st_energy.Mr;
-    surf_water_temp[0][c] = data.st_energy.Trw;
-
-    // STUFF SnowEnergyBalance NEEDS STORED FOR NEXT TIME STEP
-    snow_depth[0][c] = data.st_energy.ht_snow;
-    snow_density[0][c] = data.st_energy.density_snow;
-    days_of_nosnow[0][c] = data.st_energy.age_snow;
-    snow_temp[0][c] = data.st_energy.temp_snow;
-    
-    if (vo_->os_OK(Teuchos::VERB_HIGH)) {
-      int rank = mesh_->get_comm()->MyPID();
-      Teuchos::RCP<VerboseObject> dcvo = db_->GetVerboseObject(c, rank);
-      if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_HIGH)) {
-        *dcvo->os() << "Surface Cell " << c << " SEB:" << std::endl
-                    << "  Snow depth, snowtemp = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl
-                    << "  Melt heat = " << data.st_energy.Qm << std::endl
-                    << "  ShortWave = " << data.st_energy.fQswIn << std::endl
-                    << "  LongWave IN = " << data.st_energy.fQlwIn << std::endl
-                    << "  LongWave OUT = " << data.st_energy.fQlwOut << std::endl
-                    << "  Latent heat = " << data.st_energy.fQe << std::endl
-                    << "  Sensible heat = " << data.st_energy.fQh << std::endl
-                    << "GROUND HEAT Qex = " << data.st_energy.fQc << std::endl
-                    << "  Ice condensation rate = " << data.st_energy.MIr << std::endl
-                    << "WATER SOURCE Mr = " << data.st_energy.Mr << std::endl;
+    // Run the Snow Energy Balance Model on the block
+    SurfaceEnergyBalance::SnowEnergyBalance(data);
+    SurfaceEnergyBalance::SnowEnergyBalance(data_bare);
+
+    for (int c=c_begin; c!=c_end; ++c) {
+      SurfaceEnergyBalance::LocalData& data_c = data[c - c_begin];
+
+      if (bare_lane[c - c_begin] >= 0) { // Transition between Snow and bare ground
+        SurfaceEnergyBalance::LocalData& data_bare_c = data_bare[bare_lane[c - c_begin]];
+        double theta_c = theta[c - c_begin];
+
+        // Calculating Data for ATS
+        data_c.st_energy.fQc = data_c.st_energy.fQc * theta_c + data_bare_c.st_energy.fQc * (1.-theta_c);
+        data_c.st_energy.Mr = data_c.st_energy.Mr * theta_c + data_bare_c.st_energy.Mr * (1.-theta_c);
+        data_c.st_energy.Trw = data_c.st_energy.Trw * theta_c + data_bare_c.st_energy.Trw * (1.-theta_c);
+
+        // slightly different averaging
+        double avg_dens = 0.;
+        double avg_age = 0.;
+        double ht = 0.;
+        if (data_bare_c.st_energy.ht_snow > 0) {
+          avg_dens += data_bare_c.st_energy.density_snow * data_bare_c.st_energy.ht_snow;
+          avg_age += data_bare_c.st_energy.age_snow * data_bare_c.st_energy.ht_snow;
+          ht += data_bare_c.st_energy.ht_snow;
+        }
+        if (data_c.st_energy.ht_snow > 0) {
+          avg_dens += data_c.st_energy.density_snow * data_c.st_energy.ht_snow;
+          avg_age += data_c.st_energy.age_snow * data_c.st_energy.ht_snow;
+          ht += data_c.st_energy.ht_snow;
+        }
+        if (ht > 0.) {
+          data_c.st_energy.density_snow = avg_dens / ht;
+          data_c.st_energy.age_snow = avg_age / ht;
+        } else {
+          data_c.st_energy.density_snow = data_c.st_energy.density_frost;
+          data_c.st_energy.age_snow = 0.;
+        }
+
+        data_c.st_energy.ht_snow = data_c.st_energy.ht_snow * theta_c + data_bare_c.st_energy.ht_snow * (1.-theta_c);
+      }
+
+      // STUFF ATS WANTS
+      //    surf_energy_flux[0][c] = data.st_energy.fQc;
+      surface_water_flux[0][c] = data_c.st_energy.Mr;
+      surf_water_temp[0][c] = data_c.st_energy.Trw;
+
+      // STUFF SnowEnergyBalance NEEDS STORED FOR NEXT TIME STEP
+      snow_depth[0][c] = data_c.st_energy.ht_snow;
+      snow_density[0][c] = data_c.st_energy.density_snow;
+      days_of_nosnow[0][c] = data_c.st_energy.age_snow;
+      snow_temp[0][c] = data_c.st_energy.temp_snow;
+
+      if (vo_->os_OK(Teuchos::VERB_HIGH)) {
+        int rank = mesh_->get_comm()->MyPID();
+        Teuchos::RCP<VerboseObject> dcvo = db_->GetVerboseObject(c, rank);
+        if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_HIGH)) {
+          *dcvo->os() << "Surface Cell " << c << " SEB:" << std::endl
+                      << "  Snow depth, snowtemp = " << data_c.st_energy.ht_snow << ", " << data_c.st_energy.temp_snow << std::endl
+                      << "  Melt heat = " << data_c.st_energy.Qm << std::endl
+                      << "  ShortWave = " << data_c.st_energy.fQswIn << std::endl
+                      << "  LongWave IN = " << data_c.st_energy.fQlwIn << std::endl
+                      << "  LongWave OUT = " << data_c.st_energy.fQlwOut << std::endl
+                      << "  Latent heat = " << data_c.st_energy.fQe << std::endl
+                      << "  Sensible heat = " << data_c.st_energy.fQh << std::endl
+                      << "GROUND HEAT Qex = " << data_c.st_energy.fQc << std::endl
+                      << "  Ice condensation rate = " << data_c.st_energy.MIr << std::endl
+                      << "WATER SOURCE Mr = " << data_c.st_energy.Mr << std::endl;
+        }
       }
     }
   }
@@ -90,6 +90,7 @@ class SurfaceBalanceSEB : public PK_Physical_Default {
   double albedo_trans_;
   double snow_ground_trans_;
   double no_snow_trans_;
+  int batch_size_;
 
  private:
   // factory registration
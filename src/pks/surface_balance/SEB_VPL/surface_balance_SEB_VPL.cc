@@ -34,6 +34,7 @@
 
 #include "surface_top_cells_evaluator.hh"
 
+#include "debugger_helpers.hh"
 #include "surface_balance_SEB_VPL.hh"
 #include "SnowEnergyBalance_VPL.hh"
 
@@ -366,7 +367,9 @@ void SurfaceBalanceSEBVPL::Initialize(const Teuchos::Ptr<State>& S) {
 
   // loop over all cells and call CalculateSEB_
   int ncells = mesh_->num_entities(AmanziMesh::CELL, AmanziMesh::OWNED);
+  int rank = mesh_->get_comm()->MyPID();
   for (int c=0; c!=ncells; ++c) {
+    Teuchos::RCP<VerboseObject> dcvo = GetDebugCellVerboseObject(vo_, db_, c, rank);
     // ATS Calcualted Data
     double density_air = 1.275;       // Density of Air ------------------- [kg/m^3]
     data.st_energy.water_depth = ponded_depth[0][c]; 
@@ -506,7 +509,8 @@ void SurfaceBalanceSEBVPL::Initialize(const Teuchos::Ptr<State>& S) {
     // This is intended to keep the capillary pressure for internal interations (evaluatur) constant ~AA
    // stored_surface_pressure[0][c] = surface_pressure[0][c];  
     stored_surface_pressure[0][c] = surface_pressure[0][c]; 
-    std::cout<<"SEB:: Surface_pressure: "<<surface_pressure[0][c]<<"  Stored Surface Pressure: "<<stored_surface_pressure[0][c]<<std::endl;
+    if (dcvo != Teuchos::null)
+      *dcvo->os() << "SEB:: Surface_pressure: "<<surface_pressure[0][c]<<"  Stored Surface Pressure: "<<stored_surface_pressure[0][c]<<std::endl;
     stored_SWE[0][c] = data.st_energy.SWE;    
  
     if (vo_->os_OK(Teuchos::VERB_HIGH)) {
@@ -6,6 +6,7 @@
 */
 
 #include "Debugger.hh"
+#include "debugger_helpers.hh"
 #include "surface_balance_evaluator_VPL.hh"
 #include "SnowEnergyBalance_VPL.hh"
 
@@ -133,8 +134,10 @@ SurfaceBalanceEvaluatorVPL::EvaluateField_(const Teuchos::Ptr<State>& S,
      data.st_energy.Zo=(Zsmooth*Zfraction) + (Zrough*(1-Zfraction));
     }
 
+  int rank = result->Mesh()->get_comm()->MyPID();
   int count = Qe.MyLength();
   for (unsigned int c=0; c!=count; ++c) {
+    Teuchos::RCP<VerboseObject> dcvo = GetDebugCellVerboseObject(vo_, db_, c, rank);
     // ATS Calcualted Data
     double density_air = 1.275; // [kg/m^3]
     data.st_energy.water_depth = ponded_depth[0][c];
@@ -170,7 +173,8 @@ SurfaceBalanceEvaluatorVPL::EvaluateField_(const Teuchos::Ptr<State>& S,
     // Extras just for the evaluator
     data.st_energy.temp_snow = snow_temp[0][c];
 
-    std::cout << "Updating SEB: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl;
+    if (dcvo != Teuchos::null)
+      *dcvo->os() << "Updating SEB: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl;
 
     // Snow-ground Smoothing
     if ((data.st_energy.ht_snow > snow_ground_trans_) ||
@@ -178,19 +182,12 @@ SurfaceBalanceEvaluatorVPL::EvaluateField_(const Teuchos::Ptr<State>& S,
       // Run the Snow Energy Balance Model as normal.
       SurfaceEnergyBalance_VPL::UpdateEnergyBalance(data);
 
-      std::cout << "  SEB, non-averaged: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl;
-                if (vo_->os_OK(Teuchos::VERB_HIGH)) {
-                int rank = result->Mesh()->get_comm()->MyPID();
-                Teuchos::RCP<VerboseObject> dcvo = db_->GetVerboseObject(c, rank);
-                if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_HIGH)) {
-                  *dcvo->os() << "Surface Cell " << c << " SEB:" << std::endl
-                              << "  snow height = " << data.st_energy.ht_snow << std::endl
-                              << "  GROUND HEAT Qex = " << data.st_energy.fQc << std::endl;
-                }
-              }
-       std::cout <<"Surface Cell " << c << " SEB:" << std::endl
-                              << "  snow height = " << data.st_energy.ht_snow << std::endl
-                              << "  GROUND HEAT Qex = " << data.st_energy.fQc << std::endl;
+      if (dcvo != Teuchos::null) {
+        *dcvo->os() << "  SEB, non-averaged: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl
+                    << "Surface Cell " << c << " SEB:" << std::endl
+                    << "  snow height = " << data.st_energy.ht_snow << std::endl
+                    << "  GROUND HEAT Qex = " << data.st_energy.fQc << std::endl;
+      }
 
     } else {
       double theta=0.0;
@@ -240,25 +237,15 @@ SurfaceBalanceEvaluatorVPL::EvaluateField_(const Teuchos::Ptr<State>& S,
 //      std::cout << "  SEB, averaged: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl;
 //      std::cout << "  Averaging fQc (theta=" << theta << "): " << data.st_energy.fQc << ", " << data_bare.st_energy.fQc << std::endl;
       // debug
-      if (vo_->os_OK(Teuchos::VERB_HIGH)) {
-         int rank = result->Mesh()->get_comm()->MyPID();
-         Teuchos::RCP<VerboseObject> dcvo = db_->GetVerboseObject(c, rank);
-         if (dcvo != Teuchos::null && dcvo->os_OK(Teuchos::VERB_HIGH)) {
-            *dcvo->os() << "Surface Cell " << c << " SEB:" << std::endl
-                        << "  snow height, theta = " << data.st_energy.ht_snow << ", " << theta << std::endl
-                        << "  ground heat (bare) Qex = " << data_bare.st_energy.fQc << std::endl
-                        << "  ground heat (icy)  Qex = " << data.st_energy.fQc << std::endl
-                        << "  ground heat (AVG)  Qex = " << data.st_energy.fQc * theta + data_bare.st_energy.fQc * (1.-theta) << std::endl;
-            }
-         }
-
-      std::cout <<"Surface Cell " << c << " SEB:" << std::endl
-                << "  snow height, theta = " << data.st_energy.ht_snow << ", " << theta << std::endl
-                << "  ground heat (bare) Qex = " << data_bare.st_energy.fQc << std::endl
-                << "  ground heat (icy)  Qex = " << data.st_energy.fQc << std::endl
-                << "  ground heat (AVG)  Qex = " << data.st_energy.fQc * theta + data_bare.st_energy.fQc * (1.-theta) << std::endl
-                << "  Ground Temp = " << data_bare.st_energy.temp_ground<<"  "<<data_bare.vp_ground.temp << std::endl
-                << "  Surface pressure = " <<data_bare.st_energy.surface_pressure<<"  "<<data.st_energy.surface_pressure<<std::endl;
+      if (dcvo != Teuchos::null) {
+        *dcvo->os() << "Surface Cell " << c << " SEB:" << std::endl
+                    << "  snow height, theta = " << data.st_energy.ht_snow << ", " << theta << std::endl
+                    << "  ground heat (bare) Qex = " << data_bare.st_energy.fQc << std::endl
+                    << "  ground heat (icy)  Qex = " << data.st_energy.fQc << std::endl
+                    << "  ground heat (AVG)  Qex = " << data.st_energy.fQc * theta + data_bare.st_energy.fQc * (1.-theta) << std::endl
+                    << "  Ground Temp = " << data_bare.st_energy.temp_ground<<"  "<<data_bare.vp_ground.temp << std::endl
+                    << "  Surface pressure = " <<data_bare.st_energy.surface_pressure<<"  "<<data.st_energy.surface_pressure<<std::endl;
+      }
 
       data.st_energy.fQc = data.st_energy.fQc * theta + data_bare.st_energy.fQc * (1.-theta);
 
@@ -365,8 +352,10 @@ void SurfaceBalanceEvaluatorVPL::EvaluateFieldPartialDerivative_(
      data.st_energy.Zo=(Zsmooth*Zfraction) + (Zrough*(1-Zfraction));
     }
 
+  int rank = result->Mesh()->get_comm()->MyPID();
   int count = dQe.MyLength();
   for (unsigned int c=0; c!=count; ++c) {
+    Teuchos::RCP<VerboseObject> dcvo = GetDebugCellVerboseObject(vo_, db_, c, rank, Teuchos::VERB_EXTREME);
     // ATS Calcualted Data
     double density_air = 1.275; // [kg/m^3]
     data.st_energy.water_depth = ponded_depth[0][c];
@@ -400,7 +389,8 @@ void SurfaceBalanceEvaluatorVPL::EvaluateFieldPartialDerivative_(
     // Extras just for the evaluator
     data.st_energy.temp_snow = snow_temp[0][c];
 
-    std::cout << "PartialDerivative! Updating SEB: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl;
+    if (dcvo != Teuchos::null)
+      *dcvo->os() << "PartialDerivative! Updating SEB: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl;
 
     // Snow-ground Smoothing
     if ((data.st_energy.ht_snow > snow_ground_trans_) ||
@@ -408,7 +398,8 @@ void SurfaceBalanceEvaluatorVPL::EvaluateFieldPartialDerivative_(
       // Run the Snow Energy Balance Model as normal.
       SurfaceEnergyBalance_VPL::UpdateEnergyBalance(data);
 
-      std::cout << "  SEB, non-averaged: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl;
+      if (dcvo != Teuchos::null)
+        *dcvo->os() << "  SEB, non-averaged: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl;
 
     } else {
       double theta=0.0;
@@ -453,8 +444,10 @@ void SurfaceBalanceEvaluatorVPL::EvaluateFieldPartialDerivative_(
       SurfaceEnergyBalance_VPL::UpdateEnergyBalance(data_bare);
 
       // Calculating Data for ATS
-      std::cout << "  SEB, averaged: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl;
-      std::cout << "  Averaging fQc (theta=" << theta << "): " << data.st_energy.fQc << ", " << data_bare.st_energy.fQc << std::endl;
+      if (dcvo != Teuchos::null) {
+        *dcvo->os() << "  SEB, averaged: ht_snow, tmp_snow = " << data.st_energy.ht_snow << ", " << data.st_energy.temp_snow << std::endl
+                    << "  Averaging fQc (theta=" << theta << "): " << data.st_energy.fQc << ", " << data_bare.st_energy.fQc << std::endl;
+      }
       data.st_energy.fQc = data.st_energy.fQc * theta + data_bare.st_energy.fQc * (1.-theta);
     }
 
@@ -26,6 +26,115 @@
 #include "dbc.hh"
 #endif
 
+namespace SurfaceEnergyBalance {
+namespace {
+
+// Bracket the root of the (decreasing) residual by (lo,hi), such that
+// F(lo) > 0 > F(hi), stepping away from air temperature.  The residual is not
+// monotone everywhere, so the search starts and steps exactly as the former
+// bisection did in order to select the same root.  On input, (Xx,res) is the
+// residual at air temperature; on output it is the last point evaluated,
+// which is one of the two ends of the bracket.
+void BracketSnowTemperature_(LocalData& seb, double& Xx, double& res,
+                             double& lo, double& hi) {
+  double deltaX = 5.;
+  if (res > 0) {
+    lo = Xx;
+    hi = Xx + deltaX;
+    res = EnergyBalanceResidual(seb, hi);
+    while (res > 0) {
+      lo = hi;
+      hi += deltaX;
+      res = EnergyBalanceResidual(seb, hi);
+    }
+    Xx = hi;
+  } else {
+    hi = Xx;
+    lo = Xx - deltaX;
+    res = EnergyBalanceResidual(seb, lo);
+    while (res < 0) {
+      hi = lo;
+      lo -= deltaX;
+      res = EnergyBalanceResidual(seb, lo);
+    }
+    Xx = lo;
+  }
+}
+
+// Safeguarded Newton update: shrink the bracket using the sign of the
+// residual at Xx, then take the Newton step if it stays strictly inside the
+// bracket and bisect otherwise.
+inline double SafeguardedNewtonStep_(double Xx, double res, double dres,
+                                     double& lo, double& hi) {
+  if (res > 0) {
+    lo = Xx;
+  } else {
+    hi = Xx;
+  }
+  double Xn = dres < 0. ? Xx - res / dres : lo;
+  return (Xn > lo && Xn < hi) ? Xn : (lo + hi) / 2;
+}
+
+// Temperature-independent part of the balance: vapor pressure of the air,
+// albedo, incoming radiation, and rain.
+void UpdateTemperatureIndependentTerms_(LocalData& seb) {
+  // Caculate Vapor pressure and dewpoint temperature from Air
+  UpdateVaporPressure(seb.vp_air);
+
+  // Find effective Albedo
+  seb.st_energy.albedo_value = CalcAlbedo(seb.st_energy);
+
+  // Update temperature-independent fluxes, the short- and long-wave incoming
+  // radiation.
+  UpdateIncomingRadiation(seb);
+
+  // Initialize mass change rates
+  seb.st_energy.Mr = seb.st_energy.Pr / seb.st_energy.dt; // precipitation rain
+  seb.st_energy.MIr = 0;
+}
+
+// Everything after the snow temperature is known: melt energy, mass balance,
+// and snow pack update.
+void CompleteSnowEnergyBalance_(LocalData& seb) {
+  if (seb.st_energy.ht_snow > 0) { // If snow
+    // Calculate the energy available for melting, Qm
+    if (seb.st_energy.temp_snow <= 273.15) { // Snow is not melting
+      seb.st_energy.Qm = 0; //  no water leaving snowpack as melt water
+    } else {
+      seb.st_energy.temp_snow = 273.15; // Set snow temperature to zero
+      UpdateEFluxesSnow(seb, seb.st_energy.temp_snow);
+      seb.st_energy.Qm = CalcMeltEnergy(seb); // Recaculate energy balance with melting.
+    }
+
+    // Step 2: Mass Balance
+    // -- melt
+    UpdateMassMelt(seb.st_energy);
+
+    // -- sublimation and condensation rates between ice, melt, and air
+    UpdateMassSublCond(seb.st_energy);
+
+    // Make sure proper mass of snowpack water gets delivered to AT
+    WaterMassCorrection(seb.st_energy);
+
+  } else { // no snow
+    // Energy balance
+    UpdateGroundEnergy(seb);
+
+    // Mass balance
+    UpdateMassEvap(seb.st_energy);
+  }
+
+  // Update snow pack, density
+  UpdateSnow(seb.st_energy);
+  // set water temp
+// Ensures that water moving through the snow will have a near freezing temperature 
+  seb.st_energy.Trw = seb.st_energy.ht_snow > 0. ? 273.15 : seb.st_energy.temp_air;
+}
+
+} // namespace
+} // namespace
+
+
 void SurfaceEnergyBalance::UpdateIncomingRadiation(LocalData& seb) {
   // Calculate incoming short-wave radiation
   seb.st_energy.fQswIn = (1 - seb.st_energy.albedo_value) * seb.st_energy.QswIn;
@@ -47,7 +156,7 @@ void SurfaceEnergyBalance::UpdateIncomingRadiation(LocalData& seb) {
                        / std::pow(std::log(seb.st_energy.Zr / 0.03), 2));
   seb.st_energy.Zo = 0.03;
 }
-std::cout<<"Windspeed, Zo: "<<seb.st_energy.Us<<"  "<<seb.st_energy.Zo<<std::endl;
+// std::cout<<"Windspeed, Zo: "<<seb.st_energy.Us<<"  "<<seb.st_energy.Zo<<std::endl;
 }
 
 void SurfaceEnergyBalance::UpdateIncomingRadiationDerivatives(LocalData& seb) {
@@ -286,67 +395,131 @@ double SurfaceEnergyBalance::EnergyBalanceResidual(LocalData& seb, double Xx) {
 }
 
 
-// Use a bisection method to calculate the temperature of the snow.
+// Derivative of the Surface Energy Balance residual with respect to snow
+// surface temperature.
+double SurfaceEnergyBalance::EnergyBalanceResidualDerivative(LocalData& seb, double Xx) {
+  double Sqig, dSqig;
+  if (seb.st_energy.Us == 0.) {
+    Sqig = 0.;
+    dSqig = 0.;
+  } else {
+    double Ri  = seb.st_energy.gZr * (seb.st_energy.temp_air-Xx)
+                  / (seb.st_energy.temp_air*std::pow(seb.st_energy.Us,2));
+    double dRi = -seb.st_energy.gZr / (seb.st_energy.temp_air*std::pow(seb.st_energy.Us,2));
+    Sqig = 1 / (1 + 10*Ri);
+    dSqig = -std::pow(1+10*Ri,-2) * 10 * dRi;
+  }
+
+  // outgoing long-wave radiation
+  double dQlwOut = -4 * seb.st_energy.SEs*seb.st_energy.stephB*std::pow(Xx,3);
+
+  // sensible heat flux
+  double dQh = seb.st_energy.rowaCp*seb.st_energy.Dhe
+      * (dSqig*(seb.st_energy.temp_air-Xx) - Sqig);
+
+  // latent heat flux, through the saturated vapor pressure of snow (Bolton, 1980)
+  double temp = Xx - 273.15;
+  double sat_vp = 0.6112*std::exp(17.67*temp / (temp+243.5));
+  double dsat_vp = sat_vp * 17.67 * 243.5 / std::pow(temp+243.5, 2);
+  double dQe = seb.st_energy.rowaLs*seb.st_energy.Dhe*0.622 / seb.st_energy.Apa
+      * (dSqig*(seb.vp_air.actual_vaporpressure-sat_vp) - Sqig*dsat_vp);
+
+  // heat conducted to ground
+  double Ks = 2.9e-6 * std::pow(seb.st_energy.density_snow,2);
+  double dQc = Ks / seb.st_energy.ht_snow;
+
+  return seb.st_energy.ht_snow * (dQlwOut + dQh + dQe - dQc);
+}
+
+
+// Use a safeguarded Newton method to calculate the temperature of the snow.
 double SurfaceEnergyBalance::CalcSnowTemperature(LocalData& seb) {
   double tol = 1.e-6;
-  double deltaX = 5;
+  int maxIterations = 200;
 
   double Xx = seb.st_energy.temp_air;
-  double FXx = EnergyBalanceResidual(seb, Xx);
+  double res = EnergyBalanceResidual(seb, Xx);
+  if (std::abs(res) < tol) return Xx;
+
   // NOTE: decreasing function
-  // Bracket the root by (a,b)
-  double a,b,Fa,Fb;
-  if (FXx > 0) {
-    b = Xx;
-    Fb = FXx;
-    a = Xx;
-    Fa = FXx;
-    while (Fa > 0) {
-      b = a;
-      Fb = Fa;
-      a += deltaX;
-      Fa = EnergyBalanceResidual(seb,a);
-    }
-  } else {
-    a = Xx;
-    Fa = FXx;
-    b = Xx;
-    Fb = FXx;
-    while (Fb < 0) {
-      a = b;
-      Fa = Fb;
-      b -= deltaX;
-      Fb = EnergyBalanceResidual(seb,b);
-    }
+  // Bracket the root by (lo,hi)
+  double lo, hi;
+  BracketSnowTemperature_(seb, Xx, res, lo, hi);
+
+  // Newton Iterations Loop: Solve for Ts using Energy balance equation
+  for (int i=0; i<maxIterations; ++i) {
+    if (std::abs(res) < tol || hi - lo < tol) break;
+    double dres = EnergyBalanceResidualDerivative(seb, Xx);
+    Xx = SafeguardedNewtonStep_(Xx, res, dres, lo, hi);
+    res = EnergyBalanceResidual(seb, Xx);
   }
 
 #ifdef ENABLE_DBC
-  ASSERT(Fa*Fb < 0);
+  ASSERT(std::abs(res) <= tol || hi - lo < tol);
 #endif
+  return Xx;
+}
 
+
+// Batched version of CalcSnowTemperature(), solving for the snow temperature
+// of all snow-covered entries of seb together.  Solver state is kept lane-wise
+// and converged lanes are masked out of further iterations.  Results are
+// stored in seb[i].st_energy.temp_snow.
+void SurfaceEnergyBalance::CalcSnowTemperatures(std::vector<LocalData>& seb) {
+  double tol = 1.e-6;
   int maxIterations = 200;
-  double res;
-  int iter;
-  // Bisection Iterations Loop: Solve for Ts using Energy balance equation
-  for (int i=0; i<maxIterations; ++i) {
-    Xx = (a+b)/2;
-    res = EnergyBalanceResidual(seb, Xx);
 
-    if (res>0) {
-      b=Xx;
+  std::vector<int> lanes;
+  lanes.reserve(seb.size());
+  for (unsigned int i=0; i!=seb.size(); ++i) {
+    if (seb[i].st_energy.ht_snow > 0) lanes.push_back(i);
+  }
+
+  int nlanes = lanes.size();
+  std::vector<double> Xx(nlanes), res(nlanes), dres(nlanes), lo(nlanes), hi(nlanes);
+  std::vector<int> active(nlanes, 1);
+  int nactive = nlanes;
+
+  // Initial guess and bracket, lane by lane
+  for (int l=0; l!=nlanes; ++l) {
+    LocalData& seb_l = seb[lanes[l]];
+    Xx[l] = seb_l.st_energy.temp_air;
+    res[l] = EnergyBalanceResidual(seb_l, Xx[l]);
+    if (std::abs(res[l]) < tol) {
+      active[l] = 0;
+      nactive--;
     } else {
-      a=Xx;
+      BracketSnowTemperature_(seb_l, Xx[l], res[l], lo[l], hi[l]);
+    }
+  }
+
+  // Newton Iterations Loop, over the still-active lanes
+  for (int i=0; i<maxIterations && nactive > 0; ++i) {
+    for (int l=0; l!=nlanes; ++l) {
+      if (active[l]) dres[l] = EnergyBalanceResidualDerivative(seb[lanes[l]], Xx[l]);
     }
-    if (std::abs(res)<tol) {
-      break;
+
+    for (int l=0; l!=nlanes; ++l) {
+      if (active[l]) Xx[l] = SafeguardedNewtonStep_(Xx[l], res[l], dres[l], lo[l], hi[l]);
+    }
+
+    for (int l=0; l!=nlanes; ++l) {
+      if (active[l]) {
+        res[l] = EnergyBalanceResidual(seb[lanes[l]], Xx[l]);
+        if (std::abs(res[l]) < tol || hi[l] - lo[l] < tol) {
+          active[l] = 0;
+          nactive--;
+        }
+      }
     }
-    iter=i;
   }
 
+  for (int l=0; l!=nlanes; ++l) {
 #ifdef ENABLE_DBC
-  ASSERT(std::abs(res) <= tol);
+    ASSERT(std::abs(res[l]) <= tol || hi[l] - lo[l] < tol);
 #endif
-  return Xx;
+    seb[lanes[l]].st_energy.temp_snow = Xx[l];
+  }
 }
 
 
@@ -448,60 +621,31 @@ void SurfaceEnergyBalance::UpdateSnow(EnergyBalance& eb) {
 
 // Main snow energy balance function.
 void SurfaceEnergyBalance::SnowEnergyBalance(LocalData& seb) {
-  // Caculate Vapor pressure and dewpoint temperature from Air
-  UpdateVaporPressure(seb.vp_air);
-
-  // Find effective Albedo
-  seb.st_energy.albedo_value = CalcAlbedo(seb.st_energy);
-
-  // Update temperature-independent fluxes, the short- and long-wave incoming
-  // radiation.
-  UpdateIncomingRadiation(seb);
-
-  // Convert snow precipitation length (m) to SWE length
-  //  SWE(seb.st_energy);
-
-  // Initialize mass change rates
-  seb.st_energy.Mr = seb.st_energy.Pr / seb.st_energy.dt; // precipitation rain
-  seb.st_energy.MIr = 0;
+  UpdateTemperatureIndependentTerms_(seb);
 
   if (seb.st_energy.ht_snow > 0) { // If snow
     // Step 1: Energy Balance
     // Calculate the temperature of the snow.
     seb.st_energy.temp_snow = CalcSnowTemperature(seb);
+  }
 
-    // Calculate the energy available for melting, Qm
-    if (seb.st_energy.temp_snow <= 273.15) { // Snow is not melting
-      seb.st_energy.Qm = 0; //  no water leaving snowpack as melt water
-    } else {
-      seb.st_energy.temp_snow = 273.15; // Set snow temperature to zero
-      UpdateEFluxesSnow(seb, seb.st_energy.temp_snow);
-      seb.st_energy.Qm = CalcMeltEnergy(seb); // Recaculate energy balance with melting.
-    }
-
-    // Step 2: Mass Balance
-    // -- melt
-    UpdateMassMelt(seb.st_energy);
+  CompleteSnowEnergyBalance_(seb);
+}
 
-    // -- sublimation and condensation rates between ice, melt, and air
-    UpdateMassSublCond(seb.st_energy);
 
-    // Make sure proper mass of snowpack water gets delivered to AT
-    WaterMassCorrection(seb.st_energy);
+// Main snow energy balance function, batched over many cells.
+void SurfaceEnergyBalance::SnowEnergyBalance(std::vector<LocalData>& seb) {
+  for (std::vector<LocalData>::iterator lcv=seb.begin(); lcv!=seb.end(); ++lcv) {
+    UpdateTemperatureIndependentTerms_(*lcv);
+  }
 
-  } else { // no snow
-    // Energy balance
-    UpdateGroundEnergy(seb);
+  // Step 1: Energy Balance
+  // Calculate the temperature of the snow, for all snow-covered cells.
+  CalcSnowTemperatures(seb);
 
-    // Mass balance
-    UpdateMassEvap(seb.st_energy);
+  for (std::vector<LocalData>::iterator lcv=seb.begin(); lcv!=seb.end(); ++lcv) {
+    CompleteSnowEnergyBalance_(*lcv);
   }
-
-  // Update snow pack, density
-  UpdateSnow(seb.st_energy);
-  // set water temp
-// Ensures that water moving through the snow will have a near freezing temperature 
-  seb.st_energy.Trw = seb.st_energy.ht_snow > 0. ? 273.15 : seb.st_energy.temp_air;
 }
 
 
@@ -20,6 +20,8 @@
 #ifndef SNOW_ENERGY_BALANCE_
 #define SNOW_ENERGY_BALANCE_
 
+#include <vector>
+
 namespace SurfaceEnergyBalance {
 
 struct VaporPressure {
@@ -141,7 +143,9 @@ void UpdateGroundEnergyDerivatives(LocalData& seb);
 void UpdateVaporPressure(VaporPressure& vp);
 double CalcAlbedo(EnergyBalance& eb);
 double EnergyBalanceResidual(LocalData& seb, double Xx);
+double EnergyBalanceResidualDerivative(LocalData& seb, double Xx);
 double CalcSnowTemperature(LocalData& seb);
+void CalcSnowTemperatures(std::vector<LocalData>& seb);
 
 void UpdateMassMelt(EnergyBalance& eb);
 void UpdateMassSublCond(EnergyBalance& eb);
@@ -151,6 +155,7 @@ void UpdateSnow(EnergyBalance& eb);
 
 // Main "public" methods.
 void SnowEnergyBalance(LocalData& seb);
+void SnowEnergyBalance(std::vector<LocalData>& seb);
 void UpdateEnergyBalance(LocalData& seb);
 void UpdateEnergyBalanceDerivative(LocalData& seb);
 
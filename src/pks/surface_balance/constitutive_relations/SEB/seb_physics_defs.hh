@@ -165,6 +165,7 @@ struct EnergyBalance {  // all are [J/ (m^2 s)]
   double fQe;           // latent heat
   double fQc;           // heat conducted to ground surface
   double fQm;           // energy available for melting snow
+  double dfQc_dT;       // derivative of fQc with respect to ground temperature [J/ (m^2 s K)]
   double Dhe;           // special constant for use in e and h, precalculated for efficiency
   double Evap_Resistance;  // Rair + Rsoil See Sakaguchi & Zeng 2009
 
@@ -176,6 +177,7 @@ struct EnergyBalance {  // all are [J/ (m^2 s)]
       fQe(MY_LOCAL_NAN),
       fQc(MY_LOCAL_NAN),
       fQm(MY_LOCAL_NAN),
+      dfQc_dT(MY_LOCAL_NAN),
       Dhe(MY_LOCAL_NAN),
       Evap_Resistance(MY_LOCAL_NAN) {}
 
@@ -120,12 +120,7 @@ void UpdateEnergyBalance(const SEB& seb, const ThermoProperties& vp_surf, Energy
 
   // Calculate heat conducted to ground, if snow
   if (seb.in.snow_old.ht > 0.) {
-    double Ks = 2.9e-6 * std::pow(seb.in.snow_old.density,2);
-    double snow_hoar_density = 0;
-    if(seb.in.snow_old.density>150){
-      snow_hoar_density = 1/((0.90/seb.in.snow_old.density)+(0.10/150));
-      Ks = 2.9e-6 * std::pow(snow_hoar_density,2);
-    }
+    double Ks = CalcSnowConductivity(seb.in.snow_old.density);
     eb.fQc = Ks * (vp_surf.temp - seb.in.vp_ground.temp) / seb.in.snow_old.ht;
   }
 
@@ -141,6 +136,69 @@ void UpdateEnergyBalance(const SEB& seb, const ThermoProperties& vp_surf, Energy
 }
 
 
+// Derivative of the surface-temperature-dependent fluxes (outgoing
+// long-wave, sensible and latent heat) with respect to surface temperature.
+// Relative humidity and evaporative resistance are held fixed.
+double CalcEnergyFluxesDerivative(const SEB& seb, const ThermoProperties& vp_surf,
+        const EnergyBalance& eb) {
+  const ThermoProperties& vp_air = seb.in.met.vp_air;
+
+  // outgoing long-wave radiation
+  double dQlwOut = -4 * seb.in.surf.emissivity*seb.params.stephB*std::pow(vp_surf.temp,3);
+
+  // stability function
+  double Sqig, dSqig;
+  double air_temp = seb.in.met.vp_air.temp;
+  double Ri  = seb.params.gravity * seb.params.Zr * (air_temp - vp_surf.temp)
+      / (air_temp * std::pow(seb.in.met.Us,2));
+  double dRi = -seb.params.gravity * seb.params.Zr / (air_temp * std::pow(seb.in.met.Us,2));
+  if (Ri >= 0.) {
+    Sqig = 1 / (1 + 10*Ri);
+    dSqig = -10 * dRi / std::pow(1 + 10*Ri, 2);
+  } else {
+    Sqig = (1-10*Ri);
+    dSqig = -10 * dRi;
+  }
+
+  // sensible heat flux
+  double dQh = seb.params.density_air * seb.params.Cp * eb.Dhe
+      * (dSqig * (vp_air.temp - vp_surf.temp) - Sqig);
+
+  // latent heat flux, through the saturated vapor pressure (Bolton, 1980)
+  double LatenHeatOf = seb.in.snow_old.ht > 0. ? seb.params.Ls : seb.params.Le;
+  double tempC = vp_surf.temp - 273.15;
+  double dvp_surf = vp_surf.relative_humidity * vp_surf.saturated_vaporpressure
+      * 17.67 * 243.5 / std::pow(tempC + 243.5, 2);
+  double dQe = vp_surf.porosity * seb.params.density_air * LatenHeatOf * (1/eb.Evap_Resistance) * 0.622
+      * (dSqig * (vp_air.actual_vaporpressure - vp_surf.actual_vaporpressure) - Sqig * dvp_surf)
+      / seb.params.Apa;
+
+  return dQlwOut + dQh + dQe;
+}
+
+
+// Derivative of the conducted energy, fQc, with respect to ground
+// temperature, evaluated at the state left by CalculateSurfaceBalance().
+void UpdateEnergyBalanceDerivative(SEB& seb) {
+  EnergyBalance& eb = seb.out.eb;
+  if (seb.in.snow_old.ht > 0.) {
+    double Ks_ht = CalcSnowConductivity(seb.in.snow_old.density) / seb.in.snow_old.ht;
+    if (eb.fQm > 0.) {
+      // snow temperature is held at 0 C, only conduction depends on ground temperature
+      eb.dfQc_dT = -Ks_ht;
+    } else {
+      // snow temperature satisfies the balance fQm(T_snow, T_ground) = 0, so
+      // dT_snow/dT_ground = Ks_ht / (Ks_ht - dflux)
+      double dflux = CalcEnergyFluxesDerivative(seb, seb.in.vp_snow, eb);
+      eb.dfQc_dT = Ks_ht * dflux / (Ks_ht - dflux);
+    }
+  } else {
+    // no snow, conduction is the balance
+    eb.dfQc_dT = CalcEnergyFluxesDerivative(seb, seb.in.vp_ground, eb);
+  }
+}
+
+
 void UpdateMassBalance(const SEB& seb, MassBalance& mb, EnergyBalance& eb, SnowProperties& snow_new, bool debug, const Teuchos::RCP<VerboseObject>& vo) {
   // this dt is the max timestep that may be taken to conserve snow mass
   mb.dt = seb.in.dt;
@@ -310,7 +368,9 @@ void UpdateMassBalance(const SEB& seb, MassBalance& mb, EnergyBalance& eb, SnowP
 }
 
 
-// Snow temperature calculation.
+// Snow temperature calculation, one cell at a time.  This is not batched like
+// SurfaceEnergyBalance::CalcSnowTemperatures(); CalculateSurfaceBalance() is
+// still called per cell by the implicit surface balance PK.
 double DetermineSnowTemperature(const SEB& seb, ThermoProperties& vp_snow,
         EnergyBalance& eb, std::string method) {
   SnowTemperatureFunctor_ func(&seb, &vp_snow, &eb);
@@ -445,6 +505,15 @@ double CalcAlbedoSnow(double density_snow) {
   return AlSnow;
 }
 
+double CalcSnowConductivity(double density_snow) {
+  double Ks = 2.9e-6 * std::pow(density_snow,2);
+  if (density_snow > 150) {
+    double snow_hoar_density = 1/((0.90/density_snow)+(0.10/150));
+    Ks = 2.9e-6 * std::pow(snow_hoar_density,2);
+  }
+  return Ks;
+}
+
 double CalcRoughnessFactor(double air_temp) {
   double Zsmooth = 0.005;
   double Zrough = 0.04;
@@ -20,6 +20,9 @@ void UpdateIncomingRadiation(const SEB& seb, EnergyBalance& eb, bool debug=false
 void UpdateEvapResistance(const SEB& seb, EnergyBalance& eb, bool debug=false, const Teuchos::RCP<VerboseObject>& vo=Teuchos::null);
 void UpdateEnergyBalance(const SEB& seb, const ThermoProperties& vp_surf,
                          EnergyBalance& eb, bool debug=false, const Teuchos::RCP<VerboseObject>& vo=Teuchos::null);
+double CalcEnergyFluxesDerivative(const SEB& seb, const ThermoProperties& vp_surf,
+        const EnergyBalance& eb);
+void UpdateEnergyBalanceDerivative(SEB& seb);
 
 double DetermineSnowTemperature(const SEB& seb, ThermoProperties& vp_snow,
         EnergyBalance& eb, std::string method="toms");
@@ -29,6 +32,7 @@ void CalculateSurfaceBalance(SEB& seb, bool debug=false, const Teuchos::RCP<Verb
 
 // Random helper functions
 double CalcAlbedoSnow(double density_snow);
+double CalcSnowConductivity(double density_snow);
 double CalcRoughnessFactor(double air_temp);
 
 // Calculation of a snow temperature requires a root-finding operation, for
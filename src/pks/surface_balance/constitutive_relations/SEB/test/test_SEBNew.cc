@@ -46,6 +46,10 @@ struct TestSEB {
     seb.in.met.Pr = snow_ht > 0. ? 0. : 1.e-8;
     seb.in.met.vp_air.temp = 274.15;
     seb.in.met.vp_air.relative_humidity = 0.8;
+    seb.in.met.vp_air.UpdateVaporPressure();
+    double e_air = std::pow(10*seb.in.met.vp_air.actual_vaporpressure, seb.in.met.vp_air.temp / 2016.);
+    e_air = 1.08 * (1 - std::exp(-e_air));
+    seb.in.met.QlwIn = e_air * seb.params.stephB * std::pow(seb.in.met.vp_air.temp,4);
 
     // smoothed/interpolated surface properties
     SurfaceParams surf_pars;
@@ -380,6 +384,35 @@ SUITE(NEW_SEB) {
   }
 #endif
 
+
+#if DO_ALL
+  TEST(TEST_ENERGY_FLUX_DERIVATIVE) {
+    // analytic derivative of conducted energy wrt ground temperature vs FD
+    double eps = 1.e-4;
+    double snow_hts[3] = { 0., 0.01, 0.3 };
+    for (int j=0; j!=3; ++j) {
+      for (int i=0; i!=20; ++i) {
+        double T = 263.15 + i;
+        TestSEB seb(0.5, T, 30000., snow_hts[j], 65.);
+        CalculateSurfaceBalance(seb.seb);
+        UpdateEnergyBalanceDerivative(seb.seb);
+        CHECK(!std::isnan(seb.seb.out.eb.dfQc_dT));
+
+        SEB seb_p(seb.seb);
+        seb_p.in.vp_ground.temp += eps;
+        CalculateSurfaceBalance(seb_p);
+        SEB seb_m(seb.seb);
+        seb_m.in.vp_ground.temp -= eps;
+        CalculateSurfaceBalance(seb_m);
+
+        double dfQc_dT_fd = (seb_p.out.eb.fQc - seb_m.out.eb.fQc) / (2*eps);
+        CHECK_CLOSE(dfQc_dT_fd, seb.seb.out.eb.dfQc_dT,
+                    1.e-4 * std::max(std::abs(dfQc_dT_fd), 1.));
+      }
+    }
+  }
+#endif
+
 }
 
 
@@ -0,0 +1,115 @@
+#include "UnitTest++.h"
+#include "TestReporterStdout.h"
+
+#include <cmath>
+#include <vector>
+
+#include "SnowEnergyBalance.hh"
+
+using namespace SurfaceEnergyBalance;
+
+struct TestSnowCell {
+  LocalData data;
+
+  TestSnowCell(double air_temp, double QswIn, double snow_ht) {
+    data.st_energy.dt = 3600.;
+    data.st_energy.AlbedoTrans = 0.02;
+    data.st_energy.Zo = 0.005;
+
+    // ground properties
+    data.st_energy.water_depth = 0.;
+    data.st_energy.water_fraction = 0.;
+    data.st_energy.temp_ground = 270.15;
+    data.vp_ground.temp = 270.15;
+    data.vp_ground.actual_vaporpressure = 0.3;
+    data.st_energy.porrowaLe = 0.5 * 1.275 * data.st_energy.Le;
+
+    // met data
+    data.st_energy.temp_air = air_temp;
+    data.st_energy.QswIn = QswIn;
+    data.st_energy.Us = 2.;
+    data.st_energy.Pr = 0.;
+    data.st_energy.Ps = 0.;
+    data.vp_air.temp = air_temp;
+    data.vp_air.relative_humidity = 0.8;
+
+    // snow properties
+    data.st_energy.ht_snow = snow_ht;
+    data.st_energy.density_snow = 200.;
+    data.st_energy.age_snow = 2.;
+  }
+};
+
+
+SUITE(SEB_BATCH) {
+
+  TEST(RESIDUAL_DERIVATIVE) {
+    TestSnowCell cell(265.15, 100., 0.3);
+    LocalData& data = cell.data;
+    UpdateVaporPressure(data.vp_air);
+    data.st_energy.albedo_value = CalcAlbedo(data.st_energy);
+    UpdateIncomingRadiation(data);
+
+    double eps = 1.e-5;
+    for (double T=255.15; T<273.15; T+=2.) {
+      double dres = EnergyBalanceResidualDerivative(data, T);
+      double dres_fd = (EnergyBalanceResidual(data, T+eps)
+                        - EnergyBalanceResidual(data, T-eps)) / (2*eps);
+      CHECK_CLOSE(dres_fd, dres, 1.e-5 * std::abs(dres_fd));
+    }
+  }
+
+  // Per-cell results of SnowEnergyBalance() before the Newton solve and
+  // batching: { temp_snow, fQc, Mr, ht_snow }, with the snow temperature found
+  // by bisection to a residual of 1.e-6.  Snow-free cells have no snow
+  // temperature.
+  static const double reference[20][4] = {
+    { 0, -1801.1623415288607, -1.0744697370935561e-07, 0 },
+    { 253.73012294769285, -38.094114761352543, 0, 0.080720916037016269 },
+    { 253.13372459411619, -19.738879470825196, 0, 0.16146031464026264 },
+    { 253.68001165390012, -12.736790987650553, 0, 0.24218852254350348 },
+    { 254.62532320022581, -9.0043125438690179, 0, 0.32291426726544809 },
+    { 0, -878.15155815048308, -6.6668691096245883e-08, 0 },
+    { 256.94241394996641, -5.1069332726796466, 0, 0.48436251563957672 },
+    { 258.17866888046262, -3.9676411710466657, 0, 0.56508548284344795 },
+    { 259.4291112065315, -3.1090577501058578, 0, 0.64580774514166805 },
+    { 260.68086155652998, -2.4409334654278227, 0, 0.72652929888480566 },
+    { 0, -216.5428646802095, -3.1875392021240653e-08, 0 },
+    { 263.16171874999998, -1.4738920454545454, 0, 0.88797020773261182 },
+    { 264.38412573337553, -1.1147356915473936, 0, 0.96868788232429792 },
+    { 265.59248420000074, -0.81334128123063298, 0, 1.049402821710185 },
+    { 266.78631001114843, -0.55741148386682782, 0, 1.1301164562432398 },
+    { 0, 186.90504572523372, -7.3147933121462679e-09, 0 },
+    { 269.13063978552816, -0.14780723109841346, 0, 1.2915397239563393 },
+    { 270.28192844390867, 0.018004352345186121, 0, 1.3722493286512654 },
+    { 271.42006123960016, 0.16369678199291229, 0, 1.452957571471994 },
+    { 272.54569762349126, 0.2925272887631466, 0, 1.5336644526633829 }
+  };
+
+  TEST(BATCHED_MATCHES_SCALAR) {
+    std::vector<LocalData> batch;
+    for (int i=0; i!=20; ++i) {
+      double snow_ht = (i % 5 == 0) ? 0. : 0.05 * i;
+      TestSnowCell cell(255.15 + i, 20. * i, snow_ht);
+      // a previous snow temperature must not change which root is found
+      if (i % 2) cell.data.st_energy.temp_snow = 265.15;
+      batch.push_back(cell.data);
+    }
+    std::vector<LocalData> scalar(batch);
+
+    SnowEnergyBalance(batch);
+    for (int i=0; i!=20; ++i) {
+      SnowEnergyBalance(scalar[i]);
+      CHECK_CLOSE(scalar[i].st_energy.temp_snow, batch[i].st_energy.temp_snow, 1.e-8);
+      CHECK_CLOSE(scalar[i].st_energy.fQc, batch[i].st_energy.fQc, 1.e-8);
+      CHECK_CLOSE(scalar[i].st_energy.Mr, batch[i].st_energy.Mr, 1.e-12);
+      CHECK_CLOSE(scalar[i].st_energy.ht_snow, batch[i].st_energy.ht_snow, 1.e-12);
+
+      if (i % 5) CHECK_CLOSE(reference[i][0], batch[i].st_energy.temp_snow, 1.e-5);
+      CHECK_CLOSE(reference[i][1], batch[i].st_energy.fQc, 1.e-5);
+      CHECK_CLOSE(reference[i][2], batch[i].st_energy.Mr, 1.e-12);
+      CHECK_CLOSE(reference[i][3], batch[i].st_energy.ht_snow, 1.e-10);
+    }
+  }
+
+}
@@ -331,7 +331,6 @@ SurfaceBalanceImplicit::Functional(double t_old, double t_new, Teuchos::RCP<Tree
                             Teuchos::RCP<TreeVector> u_new, Teuchos::RCP<TreeVector> g) {
   Teuchos::OSTab tab = vo_->getOSTab();
   double dt = t_new - t_old;
-  double T_eps = 1.e-10;
 
   bool debug = false;
   Teuchos::RCP<VerboseObject> dcvo = Teuchos::null;
@@ -583,13 +582,10 @@ SurfaceBalanceImplicit::Functional(double t_old, double t_new, Teuchos::RCP<Tree
       qE_lw_out[0][c] = seb.out.eb.fQlwOut;
 
       if (eval_derivatives_) {
-        // evaluate FD derivative of energy flux wrt surface temperature
-        SEBPhysics::SEB seb2(seb);
-        seb.params.Zr = wind_speed_ref_ht_;
-        seb2.in.vp_ground.temp += T_eps;
+        // evaluate analytic derivative of energy flux wrt surface temperature
         // for now ignore the effect on unfrozen fraction, and therefore on albedo and emissivity
-        SEBPhysics::CalculateSurfaceBalance(seb2);
-        (*dsurf_energy_flux_dT)[0][c] = 1.e-6 * (seb2.out.eb.fQc - seb.out.eb.fQc) / T_eps; // MJ
+        SEBPhysics::UpdateEnergyBalanceDerivative(seb);
+        (*dsurf_energy_flux_dT)[0][c] = 1.e-6 * seb.out.eb.dfQc_dT; // MJ
       }
 
     } else {
@@ -738,19 +734,11 @@ SurfaceBalanceImplicit::Functional(double t_old, double t_new, Teuchos::RCP<Tree
 
       // Evaluate derivatives, if requested
       if (eval_derivatives_) {
-        // evaluate FD derivative of energy flux wrt surface temperature
-        SEBPhysics::SEB seb2(seb);
-        seb2.params.Zr = wind_speed_ref_ht_;
-        SEBPhysics::SEB seb2_bare(seb_bare);
-        seb2_bare.params.Zr = wind_speed_ref_ht_;
-        seb2.in.vp_ground.temp += T_eps;
-        seb2_bare.in.vp_ground.temp += T_eps;
+        // evaluate analytic derivative of energy flux wrt surface temperature
         // for now ignore the effect on unfrozen fraction, and therefore on albedo and emissivity
-        SEBPhysics::CalculateSurfaceBalance(seb2);
-        SEBPhysics::CalculateSurfaceBalance(seb2_bare);
-        double eflux2 = 1.e-6 * (theta * seb2.out.eb.fQc + (1-theta) * seb2_bare.out.eb.fQc);
-        
-        (*dsurf_energy_flux_dT)[0][c] = (eflux2 - surf_energy_flux[0][c]) / T_eps; // MJ
+        SEBPhysics::UpdateEnergyBalanceDerivative(seb);
+        SEBPhysics::UpdateEnergyBalanceDerivative(seb_bare);
+        (*dsurf_energy_flux_dT)[0][c] = 1.e-6 * (theta * seb.out.eb.dfQc_dT + (1-theta) * seb_bare.out.eb.dfQc_dT); // MJ
       }
     }
   }  // END CELL LOOP ###############################
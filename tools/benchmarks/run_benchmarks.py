@@ -0,0 +1,153 @@
+#!/usr/bin/env python
+"""Runs ATS benchmarks and collects the results as JSON.
+
+Problem benchmarks are full ATS runs, given as NAME=INPUT.xml[@NPROCS].  Each
+input is copied, next to the original so that relative paths still resolve,
+with the coordinator's "benchmark summary file" set, and run in the input's
+directory.  No problem inputs are provided here; any ATS input may be used,
+e.g. a single column or an ensemble of columns through a weak MPC semi
+coupled, and the same NAME should be used for the same input across runs so
+that results can be compared.
+
+Micro-benchmarks are run from the ats_benchmarks executable, built with
+-DBUILD_BENCHMARKS=ON.
+
+Usage:
+  run_benchmarks.py column=column.xml columns=columns.xml@4 \\
+      --micro=ats_benchmarks -o results.json
+  run_benchmarks.py --compare=baseline.json -o results.json
+"""
+from __future__ import print_function
+
+import sys, os
+import argparse
+import datetime
+import json
+import socket
+import subprocess
+import xml.etree.ElementTree as ET
+
+
+def set_summary_file(infile, outfile, summary):
+    """Writes a copy of infile to outfile, with the benchmark summary file set."""
+    tree = ET.parse(infile)
+    driver = None
+    for plist in tree.getroot().findall("ParameterList"):
+        if plist.get("name") == "cycle driver":
+            driver = plist
+    if driver is None:
+        raise RuntimeError("Input file %s has no \"cycle driver\" list." % infile)
+
+    for param in driver.findall("Parameter"):
+        if param.get("name") == "benchmark summary file":
+            driver.remove(param)
+    ET.SubElement(driver, "Parameter", {"name":"benchmark summary file",
+                                        "type":"string", "value":summary})
+    tree.write(outfile)
+
+
+def run_problem(name, infile, nprocs, ats, mpiexec):
+    """Runs one problem benchmark, returning its record."""
+    rundir = os.path.dirname(os.path.abspath(infile))
+    runfile = os.path.join(rundir, "benchmark_%s.xml" % name)
+    summary = "benchmark_%s.json" % name
+    set_summary_file(infile, runfile, summary)
+
+    cmd = [ats, "--xml_file=%s" % runfile]
+    if nprocs > 1:
+        cmd = [mpiexec, "-n", str(nprocs)] + cmd
+    with open(os.path.join(rundir, "benchmark_%s.log" % name), "w") as log:
+        ierr = subprocess.call(cmd, cwd=rundir, stdout=log, stderr=subprocess.STDOUT)
+
+    record = {"name":name, "kind":"problem", "input":infile, "processes":nprocs,
+              "returncode":ierr}
+    try:
+        with open(os.path.join(rundir, summary)) as fid:
+            record["metrics"] = json.load(fid)
+    except IOError:
+        record["metrics"] = {}
+    return record
+
+
+def run_micro(exe, size):
+    """Runs the micro-benchmarks, returning their records."""
+    out = subprocess.check_output([exe, "--size=%d" % size])
+    return json.loads(out.decode())
+
+
+def git_revision():
+    try:
+        here = os.path.dirname(os.path.abspath(__file__))
+        return subprocess.check_output(["git", "rev-parse", "HEAD"], cwd=here).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def compare(baseline, current):
+    """Prints the ratio current/baseline of every timing, memory, and iteration metric."""
+    base = dict((r["name"], r) for r in baseline["results"])
+    fmt = "%-32s %-48s %14s %14s %8s"
+    print(fmt % ("benchmark", "metric", "baseline", "current", "ratio"))
+    for rec in current["results"]:
+        if rec["name"] not in base: continue
+        old = base[rec["name"]]["metrics"]
+        for key, val in sorted(rec["metrics"].items()):
+            if key not in old: continue
+            if not ("time" in key or "memory" in key or "iterations" in key or "cycles" in key): continue
+            ratio = "%8.3f" % (val / old[key]) if old[key] else "-"
+            print(fmt % (rec["name"], key, "%.6g" % old[key], "%.6g" % val, ratio))
+
+
+def problem_type(arg):
+    try:
+        name, infile = arg.split("=", 1)
+    except ValueError:
+        raise argparse.ArgumentTypeError("Problems are given as NAME=INPUT.xml[@NPROCS]")
+    nprocs = 1
+    if "@" in infile:
+        infile, nprocs = infile.rsplit("@", 1)
+        nprocs = int(nprocs)
+    return name, infile, nprocs
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("problems", nargs="*", type=problem_type,
+                        help="Problem benchmarks, as NAME=INPUT.xml[@NPROCS].")
+    parser.add_argument("--ats", default="ats", help="ATS executable.")
+    parser.add_argument("--mpiexec", default="mpiexec", help="MPI launcher.")
+    parser.add_argument("--micro", default=None,
+                        help="ats_benchmarks executable; micro-benchmarks are run if given.")
+    parser.add_argument("--micro-size", type=int, default=100000,
+                        help="Cells in the micro-benchmark problems.")
+    parser.add_argument("-o", "--output", default="benchmarks.json",
+                        help="Results file.")
+    parser.add_argument("--compare", default=None,
+                        help="Baseline results file to compare against; with no problems or micro-benchmarks, compares the results file instead of running.")
+    args = parser.parse_args()
+
+    if args.compare is not None and len(args.problems) == 0 and args.micro is None:
+        with open(args.compare) as fid:
+            baseline = json.load(fid)
+        with open(args.output) as fid:
+            current = json.load(fid)
+        compare(baseline, current)
+        sys.exit(0)
+
+    results = {"git revision":git_revision(),
+               "host":socket.gethostname(),
+               "date":datetime.datetime.now().isoformat(),
+               "results":[]}
+    for name, infile, nprocs in args.problems:
+        print("Running problem benchmark: %s (%d processes)" % (name, nprocs))
+        results["results"].append(run_problem(name, infile, nprocs, args.ats, args.mpiexec))
+    if args.micro is not None:
+        print("Running micro-benchmarks")
+        results["results"].extend(run_micro(args.micro, args.micro_size))
+
+    with open(args.output, "w") as fid:
+        json.dump(results, fid, indent=2, sort_keys=True)
+
+    if args.compare is not None:
+        with open(args.compare) as fid:
+            compare(json.load(fid), results)
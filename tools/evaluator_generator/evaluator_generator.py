@@ -1,4 +1,5 @@
 import sys,os
+import sympy
 from sympy.printing import ccode
 
 _template_directory = os.path.dirname(os.path.abspath(__file__))
@@ -20,7 +21,7 @@ def render(tname, d):
     
 class EvalGen(object):
     def __init__(self, name, namespace, descriptor, my_key=None, expression=None,
-                 doc=None, **kwargs):
+                 doc=None, fused=False, **kwargs):
         self.d = {}
         self.setName(name, **kwargs)
         self.setNamespace(namespace, **kwargs)
@@ -36,6 +37,7 @@ class EvalGen(object):
         self.par_names = []
         self.par_defaults = []
         self.expression = expression
+        self.fused = fused
         if doc is not None:
             self.d['docDict'] = doc
         else:
@@ -142,32 +144,151 @@ class EvalGen(object):
                                  dict(myMethod="D%sD%s"%(self.d['myKeyMethod'],''.join([word[0].upper()+word[1:] for word in arg.split("_")])),
                                       myMethodDeclarationArgs=self.d['myMethodDeclarationArgs'])) for arg in self.args])
 
-    def renderModelMethodImplementation(self):
+    def renderModelMethodImplementation(self, tname='model_methodImplementation.cc'):
         if self.expression is not None:
             implementation = ccode(self.expression)
         else:
             implementation = "ASSERT(False)"
-        return render('model_methodImplementation.cc', dict(evalClassName=self.d['evalClassName'],
+        return render(tname, dict(evalClassName=self.d['evalClassName'],
                                                             myMethod=self.d['myKeyMethod'],
                                                             myMethodDeclarationArgs=self.d['myMethodDeclarationArgs'],
                                                             myMethodImplementation=implementation))
 
-    def renderModelDerivImplementations(self):
+    def renderModelDerivImplementations(self, tname='model_methodImplementation.cc'):
         impls = []
 
         for arg,var in zip(self.args,self.vars):
             if self.expression is not None:
-                print "differentiation of", self.expression, "with respect to", var
+                print("differentiation of", self.expression, "with respect to", var)
                 implementation = ccode(self.expression.diff(var))
             else:
                 implementation = "ASSERT(False)"
-            impls.append(render('model_methodImplementation.cc',
+            impls.append(render(tname,
                                 dict(evalClassName=self.d['evalClassName'],
                                      myMethod="D%sD%s"%(self.d['myKeyMethod'],''.join([word[0].upper()+word[1:] for word in arg.split("_")])),
                                      myMethodDeclarationArgs=self.d['myMethodDeclarationArgs'],
                                      myMethodImplementation=implementation)))
         return '\n\n'.join(impls)
     
+    def wrtMethod(self, arg):
+        return ''.join([word[0].upper()+word[1:] for word in arg.split("_")])
+
+    def renderKernelArgs(self):
+        return ", ".join(["%s_v[0]"%var for var in self.vars])
+
+    def renderDerivKernelArgs(self):
+        return ", ".join(["dresult_d%s_v[0]"%var for var in self.vars])
+
+    def renderKernelDeclarationArgs(self, outputs):
+        inputs = ["const double* __restrict__ %s_v"%var for var in self.vars]
+        return ", ".join(inputs + ["double* __restrict__ %s"%out for out in outputs])
+
+    def renderKernelCall(self, method):
+        return "%s(%s)"%(method, ", ".join(["%s_v[i]"%var for var in self.vars]))
+
+    def renderFusedKernelBody(self):
+        outputs = ["result"] + ["dresult_d%s"%var for var in self.vars]
+        if self.expression is None:
+            methods = [self.d['myKeyMethod']] + ["D%sD%s"%(self.d['myKeyMethod'], self.wrtMethod(arg))
+                                                 for arg in self.args]
+            return '\n'.join(["    %s[i] = %s;"%(out, self.renderKernelCall(method))
+                              for out, method in zip(outputs, methods)])
+
+        # value and all derivatives, sharing common subexpressions
+        exprs = [self.expression] + [self.expression.diff(var) for var in self.vars]
+        replacements, reduced = sympy.cse(exprs, symbols=sympy.numbered_symbols("cse"))
+        used = set()
+        for expr in exprs:
+            used |= set(str(sym) for sym in expr.free_symbols)
+        lines = ["    const double %s = %s_v[i];"%(var, var) for var in self.vars if var in used]
+        lines.extend(["    const double %s = %s;"%(sym, ccode(expr)) for sym, expr in replacements])
+        lines.extend(["    %s[i] = %s;"%(out, ccode(expr)) for out, expr in zip(outputs, reduced)])
+        return '\n'.join(lines)
+
+    def renderModelKernelDeclarations(self):
+        kernels = [(self.d['myKeyMethod']+"Kernel", ["result"]),
+                   (self.d['myKeyMethod']+"AndDerivativesKernel",
+                    ["result"] + ["dresult_d%s"%var for var in self.vars])]
+        kernels.extend([("D%sD%sKernel"%(self.d['myKeyMethod'], self.wrtMethod(arg)), ["result"])
+                        for arg in self.args])
+        return '\n'.join([render('model_kernelDeclaration.hh',
+                                 dict(myMethod=method,
+                                      kernelDeclarationArgs=self.renderKernelDeclarationArgs(outputs)))
+                          for method, outputs in kernels])
+
+    def renderModelKernelImplementations(self):
+        impls = []
+        def implement(method, outputs, body):
+            impls.append(render('model_kernelImplementation.hh',
+                                dict(evalClassName=self.d['evalClassName'],
+                                     myMethod=method,
+                                     kernelDeclarationArgs=self.renderKernelDeclarationArgs(outputs),
+                                     kernelBody=body)))
+
+        implement(self.d['myKeyMethod']+"Kernel", ["result"],
+                  "    result[i] = %s;"%self.renderKernelCall(self.d['myKeyMethod']))
+        implement(self.d['myKeyMethod']+"AndDerivativesKernel",
+                  ["result"] + ["dresult_d%s"%var for var in self.vars],
+                  self.renderFusedKernelBody())
+        for arg in self.args:
+            method = "D%sD%s"%(self.d['myKeyMethod'], self.wrtMethod(arg))
+            implement(method+"Kernel", ["result"],
+                      "    result[i] = %s;"%self.renderKernelCall(method))
+        return '\n\n'.join(impls)
+
+    def renderEvaluateDerivsKernel(self):
+        wrt_list = []
+        for i, (arg, var) in enumerate(zip(self.args, self.vars)):
+            d = dict(arg=arg, var=var)
+            d['keyEpetraVectorList'] = self.renderKeyEpetraVectorIndented()
+            d['myKeyMethod'] = self.d['myKeyMethod']
+            d['wrtMethod'] = self.wrtMethod(arg)
+            d['kernelArgs'] = self.renderKernelArgs()
+            if i == 0:
+                d['if_elseif'] = render('evaluator_ifWRT.cc', d)
+            else:
+                d['if_elseif'] = render('evaluator_elseifWRT.cc', d)
+            wrt_list.append(render('evaluator_evaluateDerivsKernel.cc', d))
+
+        wrt_list.append('\n'.join(["  } else {",
+                                   "    ASSERT(0);",
+                                   "  }"]))
+        return "\n\n".join(wrt_list)
+
+    def renderDerivCopy(self):
+        copies = []
+        for i, var in enumerate(self.vars):
+            if i == 0:
+                copies.append("    if (wrt_key == %s_key_) {"%var)
+            else:
+                copies.append("    } else if (wrt_key == %s_key_) {"%var)
+            copies.append("      *result = *dresult_d%s_;"%var)
+        copies.extend(["    } else {",
+                       "      ASSERT(0);",
+                       "    }"])
+        return '\n'.join(copies)
+
+    def genFused(self):
+        # fused value and derivative kernels on raw arrays, with an inline model
+        assert len(self.args) > 0, "fused evaluators require at least one dependency"
+        self.d['kernelArgs'] = self.renderKernelArgs()
+        self.d['derivKernelArgs'] = self.renderDerivKernelArgs()
+        self.d['keyEpetraVectorList'] = self.renderKeyEpetraVector()
+        self.d['firstDeriv'] = "dresult_d%s_"%self.vars[0]
+        self.d['derivDeclarationList'] = '\n'.join([render('evaluator_derivDeclaration.hh', dict(var=var))
+                                                    for var in self.vars])
+        self.d['derivAllocateList'] = '\n'.join([render('evaluator_derivAllocate.cc', dict(var=var))
+                                                 for var in self.vars])
+        self.d['derivEpetraVectorList'] = '\n'.join([render('evaluator_derivEpetraVector.cc', dict(var=var))
+                                                     for var in self.vars])
+        self.d['derivCopyList'] = self.renderDerivCopy()
+        self.d['evaluateDerivs'] = self.renderEvaluateDerivsKernel()
+
+        self.d['modelKernelDeclarationList'] = self.renderModelKernelDeclarations()
+        self.d['modelKernelImplementationList'] = self.renderModelKernelImplementations()
+        self.d['modelMethodImplementation'] = self.renderModelMethodImplementation('model_methodImplementationInline.hh')
+        self.d['modelDerivImplementationList'] = self.renderModelDerivImplementations('model_methodImplementationInline.hh')
+
     def renderModelParamDeclarations(self):
         return '\n'.join(['  %s %s;'%p for p in self.pars])
 
@@ -201,6 +322,9 @@ class EvalGen(object):
         self.d['modelDerivImplementationList'] = self.renderModelDerivImplementations()
         self.d['modelInitializeParamsList'] = self.renderModelParamInitializations()
 
+        if self.fused:
+            self.genFused()
+
 def generate_evaluator(name, namespace, descriptor, my_key, dependencies, parameters, **kwargs):
     """Generates an evaluator whose class is [name]Evaluator and model is [name]Model.
 
@@ -231,6 +355,13 @@ def generate_evaluator(name, namespace, descriptor, my_key, dependencies, parame
 
       directory: directory where output files are created
 
+      fused: if True, the evaluator computes the value and all derivatives in
+             one pass (optionally, through "fused derivative evaluation") and
+             caches the derivatives, and the model provides raw-array kernels
+             and inline point methods, so that kernel loops may be vectorized.
+             Given an expression, the fused kernel shares common
+             subexpressions of the value and its derivatives.
+
     Outputs:
       writes files: [name]_evaluator.hh
                     [name]_evaluator.cc
@@ -257,8 +388,11 @@ def generate_evaluator(name, namespace, descriptor, my_key, dependencies, parame
 
     files = ["evaluator.hh", "evaluator.cc", "evaluator_reg.hh", "model.hh", "model.cc"]
     for outfile in files:
+        template = outfile
+        if eg.fused and outfile != "evaluator_reg.hh":
+            template = outfile.replace(".", "_fused.")
         with open(os.path.join(directory, "%s_%s"%(name,outfile)), 'w') as fid:
-            fid.write(render(outfile, eg.d))
+            fid.write(render(template, eg.d))
 
 
       
@@ -0,0 +1 @@
+    dresult_d{var}_ = Teuchos::rcp(new CompositeVector(*result));
@@ -0,0 +1 @@
+  Teuchos::RCP<CompositeVector> dresult_d{var}_;
@@ -0,0 +1 @@
+      Epetra_MultiVector& dresult_d{var}_v = *dresult_d{var}_->ViewComponent(*comp,false);
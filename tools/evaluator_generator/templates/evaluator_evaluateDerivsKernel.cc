@@ -0,0 +1,9 @@
+{if_elseif}
+    for (CompositeVector::name_iterator comp=result->begin();
+         comp!=result->end(); ++comp) {{
+{keyEpetraVectorList}
+      Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
+
+      int ncomp = result->size(*comp, false);
+      model_->D{myKeyMethod}D{wrtMethod}Kernel(ncomp, {kernelArgs}, result_v[0]);
+    }}
@@ -0,0 +1,102 @@
+/*
+  The {evalNameString} evaluator is an algebraic evaluator of a given model.
+{docDict}  
+  Generated via evaluator_generator.
+*/
+
+#include "{evalName}_evaluator.hh"
+#include "{evalName}_model.hh"
+
+namespace Amanzi {{
+namespace {namespace} {{
+namespace Relations {{
+
+// Constructor from ParameterList
+{evalClassName}Evaluator::{evalClassName}Evaluator(Teuchos::ParameterList& plist) :
+    SecondaryVariableFieldEvaluator(plist)
+{{
+  Teuchos::ParameterList& sublist = plist_.sublist("{evalName} parameters");
+  model_ = Teuchos::rcp(new {evalClassName}Model(sublist));
+  fused_ = plist_.get<bool>("fused derivative evaluation", true);
+  InitializeFromPlist_();
+}}
+
+
+// Copy constructor
+{evalClassName}Evaluator::{evalClassName}Evaluator(const {evalClassName}Evaluator& other) :
+    SecondaryVariableFieldEvaluator(other),
+{keyCopyConstructorList}    
+    model_(other.model_),
+    fused_(other.fused_) {{}}
+
+
+// Virtual copy constructor
+Teuchos::RCP<FieldEvaluator>
+{evalClassName}Evaluator::Clone() const
+{{
+  return Teuchos::rcp(new {evalClassName}Evaluator(*this));
+}}
+
+
+// Initialize by setting up dependencies
+void
+{evalClassName}Evaluator::InitializeFromPlist_()
+{{
+  // Set up my dependencies
+  // - defaults to prefixed via domain
+  Key domain_name = Keys::getDomainPrefix(my_key_);
+
+  // - pull Keys from plist
+{keyInitializeList}
+}}
+
+
+void
+{evalClassName}Evaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
+        const Teuchos::Ptr<CompositeVector>& result)
+{{
+{keyCompositeVectorList}
+
+  if (fused_ && {firstDeriv} == Teuchos::null) {{
+{derivAllocateList}
+  }}
+
+  for (CompositeVector::name_iterator comp=result->begin();
+       comp!=result->end(); ++comp) {{
+{keyEpetraVectorList}
+    Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
+
+    int ncomp = result->size(*comp, false);
+    if (fused_) {{
+{derivEpetraVectorList}
+      model_->{myKeyMethod}AndDerivativesKernel(ncomp, {kernelArgs}, result_v[0],
+              {derivKernelArgs});
+    }} else {{
+      model_->{myKeyMethod}Kernel(ncomp, {kernelArgs}, result_v[0]);
+    }}
+  }}
+}}
+
+
+void
+{evalClassName}Evaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+        Key wrt_key, const Teuchos::Ptr<CompositeVector>& result)
+{{
+  if (fused_) {{
+    // Make sure the value, and therefore the cached derivatives, are
+    // current.  This only evaluates if a dependency has changed.
+    HasFieldChanged(S, my_key_+" fused derivatives");
+
+{derivCopyList}
+    return;
+  }}
+
+{keyCompositeVectorList}
+
+{evaluateDerivs}
+}}
+
+
+}} //namespace
+}} //namespace
+}} //namespace
@@ -0,0 +1,58 @@
+/*
+  The {evalNameString} model is an algebraic model with dependencies.
+
+  Point methods and kernels are defined inline, so that the kernel loops,
+  which work on raw arrays, inline the model and may be vectorized.
+
+  Generated via evaluator_generator with:
+{docDict}
+    
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#ifndef AMANZI_{namespaceCaps}_{evalNameCaps}_MODEL_HH_
+#define AMANZI_{namespaceCaps}_{evalNameCaps}_MODEL_HH_
+
+#include <cmath>
+#include "Teuchos_ParameterList.hpp"
+#include "dbc.hh"
+
+namespace Amanzi {{
+namespace {namespace} {{
+namespace Relations {{
+
+class {evalClassName}Model {{
+
+ public:
+  explicit
+  {evalClassName}Model(Teuchos::ParameterList& plist);
+
+{modelMethodDeclaration}
+
+{modelDerivDeclarationList}
+
+  // kernels over n entries
+{modelKernelDeclarationList}
+  
+ protected:
+  void InitializeFromPlist_(Teuchos::ParameterList& plist);
+
+ protected:
+
+{paramDeclarationList}
+
+}};
+
+
+// main method
+{modelMethodImplementation}
+
+{modelDerivImplementationList}
+
+{modelKernelImplementationList}
+
+}} //namespace
+}} //namespace
+}} //namespace
+
+#endif
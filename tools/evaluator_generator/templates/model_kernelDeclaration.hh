@@ -0,0 +1 @@
+  void {myMethod}(int n, {kernelDeclarationArgs}) const;
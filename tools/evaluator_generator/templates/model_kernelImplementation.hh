@@ -0,0 +1,8 @@
+inline void
+{evalClassName}Model::{myMethod}(int n, {kernelDeclarationArgs}) const
+{{
+#pragma omp simd
+  for (int i=0; i<n; ++i) {{
+{kernelBody}
+  }}
+}}
@@ -0,0 +1,5 @@
+inline double
+{evalClassName}Model::{myMethod}({myMethodDeclarationArgs}) const
+{{
+  return {myMethodImplementation};
+}}
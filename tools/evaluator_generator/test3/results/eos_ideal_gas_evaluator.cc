@@ -0,0 +1,146 @@
+/*
+  The ideal gas equation of state evaluator is an algebraic evaluator of a given model.
+  
+  Generated via evaluator_generator.
+*/
+
+#include "eos_ideal_gas_evaluator.hh"
+#include "eos_ideal_gas_model.hh"
+
+namespace Amanzi {
+namespace General {
+namespace Relations {
+
+// Constructor from ParameterList
+EosIdealGasEvaluator::EosIdealGasEvaluator(Teuchos::ParameterList& plist) :
+    SecondaryVariableFieldEvaluator(plist)
+{
+  Teuchos::ParameterList& sublist = plist_.sublist("eos_ideal_gas parameters");
+  model_ = Teuchos::rcp(new EosIdealGasModel(sublist));
+  fused_ = plist_.get<bool>("fused derivative evaluation", true);
+  InitializeFromPlist_();
+}
+
+
+// Copy constructor
+EosIdealGasEvaluator::EosIdealGasEvaluator(const EosIdealGasEvaluator& other) :
+    SecondaryVariableFieldEvaluator(other),
+    temp_key_(other.temp_key_),
+    pres_key_(other.pres_key_),    
+    model_(other.model_),
+    fused_(other.fused_) {}
+
+
+// Virtual copy constructor
+Teuchos::RCP<FieldEvaluator>
+EosIdealGasEvaluator::Clone() const
+{
+  return Teuchos::rcp(new EosIdealGasEvaluator(*this));
+}
+
+
+// Initialize by setting up dependencies
+void
+EosIdealGasEvaluator::InitializeFromPlist_()
+{
+  // Set up my dependencies
+  // - defaults to prefixed via domain
+  Key domain_name = Keys::getDomainPrefix(my_key_);
+
+  // - pull Keys from plist
+  // dependency: temperature
+  temp_key_ = plist_.get<std::string>("temperature key",
+          domain_name+"temperature");
+  dependencies_.insert(temp_key_);
+
+  // dependency: pressure
+  pres_key_ = plist_.get<std::string>("pressure key",
+          domain_name+"pressure");
+  dependencies_.insert(pres_key_);
+}
+
+
+void
+EosIdealGasEvaluator::EvaluateField_(const Teuchos::Ptr<State>& S,
+        const Teuchos::Ptr<CompositeVector>& result)
+{
+Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
+Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);
+
+  if (fused_ && dresult_dtemp_ == Teuchos::null) {
+    dresult_dtemp_ = Teuchos::rcp(new CompositeVector(*result));
+    dresult_dpres_ = Teuchos::rcp(new CompositeVector(*result));
+  }
+
+  for (CompositeVector::name_iterator comp=result->begin();
+       comp!=result->end(); ++comp) {
+    const Epetra_MultiVector& temp_v = *temp->ViewComponent(*comp, false);
+    const Epetra_MultiVector& pres_v = *pres->ViewComponent(*comp, false);
+    Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
+
+    int ncomp = result->size(*comp, false);
+    if (fused_) {
+      Epetra_MultiVector& dresult_dtemp_v = *dresult_dtemp_->ViewComponent(*comp,false);
+      Epetra_MultiVector& dresult_dpres_v = *dresult_dpres_->ViewComponent(*comp,false);
+      model_->DensityAndDerivativesKernel(ncomp, temp_v[0], pres_v[0], result_v[0],
+              dresult_dtemp_v[0], dresult_dpres_v[0]);
+    } else {
+      model_->DensityKernel(ncomp, temp_v[0], pres_v[0], result_v[0]);
+    }
+  }
+}
+
+
+void
+EosIdealGasEvaluator::EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+        Key wrt_key, const Teuchos::Ptr<CompositeVector>& result)
+{
+  if (fused_) {
+    // Make sure the value, and therefore the cached derivatives, are
+    // current.  This only evaluates if a dependency has changed.
+    HasFieldChanged(S, my_key_+" fused derivatives");
+
+    if (wrt_key == temp_key_) {
+      *result = *dresult_dtemp_;
+    } else if (wrt_key == pres_key_) {
+      *result = *dresult_dpres_;
+    } else {
+      ASSERT(0);
+    }
+    return;
+  }
+
+Teuchos::RCP<const CompositeVector> temp = S->GetFieldData(temp_key_);
+Teuchos::RCP<const CompositeVector> pres = S->GetFieldData(pres_key_);
+
+  if (wrt_key == temp_key_) {
+    for (CompositeVector::name_iterator comp=result->begin();
+         comp!=result->end(); ++comp) {
+      const Epetra_MultiVector& temp_v = *temp->ViewComponent(*comp, false);
+      const Epetra_MultiVector& pres_v = *pres->ViewComponent(*comp, false);
+      Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
+
+      int ncomp = result->size(*comp, false);
+      model_->DDensityDTemperatureKernel(ncomp, temp_v[0], pres_v[0], result_v[0]);
+    }
+
+  } else if (wrt_key == pres_key_) {
+    for (CompositeVector::name_iterator comp=result->begin();
+         comp!=result->end(); ++comp) {
+      const Epetra_MultiVector& temp_v = *temp->ViewComponent(*comp, false);
+      const Epetra_MultiVector& pres_v = *pres->ViewComponent(*comp, false);
+      Epetra_MultiVector& result_v = *result->ViewComponent(*comp,false);
+
+      int ncomp = result->size(*comp, false);
+      model_->DDensityDPressureKernel(ncomp, temp_v[0], pres_v[0], result_v[0]);
+    }
+
+  } else {
+    ASSERT(0);
+  }
+}
+
+
+} //namespace
+} //namespace
+} //namespace
\ No newline at end of file
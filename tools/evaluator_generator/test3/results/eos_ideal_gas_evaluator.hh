@@ -0,0 +1,65 @@
+/*
+  The ideal gas equation of state evaluator is an algebraic evaluator of a given model.
+
+  With "fused derivative evaluation" (the default), each evaluation computes
+  the value and its derivatives with respect to all dependencies in one pass;
+  the derivatives are cached and copied out when they are requested.  This
+  costs one extra vector per dependency.
+
+  Generated via evaluator_generator with:
+
+    
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#ifndef AMANZI_GENERAL_EOS_IDEAL_GAS_EVALUATOR_HH_
+#define AMANZI_GENERAL_EOS_IDEAL_GAS_EVALUATOR_HH_
+
+#include "factory.hh"
+#include "secondary_variable_field_evaluator.hh"
+
+namespace Amanzi {
+namespace General {
+namespace Relations {
+
+class EosIdealGasModel;
+
+class EosIdealGasEvaluator : public SecondaryVariableFieldEvaluator {
+
+ public:
+  explicit
+  EosIdealGasEvaluator(Teuchos::ParameterList& plist);
+  EosIdealGasEvaluator(const EosIdealGasEvaluator& other);
+
+  virtual Teuchos::RCP<FieldEvaluator> Clone() const;
+
+  // Required methods from SecondaryVariableFieldEvaluator
+  virtual void EvaluateField_(const Teuchos::Ptr<State>& S,
+          const Teuchos::Ptr<CompositeVector>& result);
+  virtual void EvaluateFieldPartialDerivative_(const Teuchos::Ptr<State>& S,
+          Key wrt_key, const Teuchos::Ptr<CompositeVector>& result);
+
+  Teuchos::RCP<EosIdealGasModel> get_model() { return model_; }
+
+ protected:
+  void InitializeFromPlist_();
+
+  Key temp_key_;
+  Key pres_key_;
+
+  Teuchos::RCP<EosIdealGasModel> model_;
+
+  bool fused_;
+  Teuchos::RCP<CompositeVector> dresult_dtemp_;
+  Teuchos::RCP<CompositeVector> dresult_dpres_;
+
+ private:
+  static Utils::RegisteredFactory<FieldEvaluator,EosIdealGasEvaluator> reg_;
+
+};
+
+} //namespace
+} //namespace
+} //namespace
+
+#endif
\ No newline at end of file
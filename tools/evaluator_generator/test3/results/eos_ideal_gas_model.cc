@@ -0,0 +1,36 @@
+/*
+  The ideal gas equation of state model is an algebraic model with dependencies.
+
+  Generated via evaluator_generator with:
+
+    
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#include "Teuchos_ParameterList.hpp"
+#include "dbc.hh"
+#include "eos_ideal_gas_model.hh"
+
+namespace Amanzi {
+namespace General {
+namespace Relations {
+
+// Constructor from ParameterList
+EosIdealGasModel::EosIdealGasModel(Teuchos::ParameterList& plist)
+{
+  InitializeFromPlist_(plist);
+}
+
+
+// Initialize parameters
+void
+EosIdealGasModel::InitializeFromPlist_(Teuchos::ParameterList& plist)
+{
+  cv_ = plist.get<double>("heat capacity");
+  T0_ = plist.get<double>("reference temperature [K]");
+}
+
+} //namespace
+} //namespace
+} //namespace
+  
\ No newline at end of file
@@ -0,0 +1,114 @@
+/*
+  The ideal gas equation of state model is an algebraic model with dependencies.
+
+  Point methods and kernels are defined inline, so that the kernel loops,
+  which work on raw arrays, inline the model and may be vectorized.
+
+  Generated via evaluator_generator with:
+
+    
+  Authors: Ethan Coon (ecoon@lanl.gov)
+*/
+
+#ifndef AMANZI_GENERAL_EOS_IDEAL_GAS_MODEL_HH_
+#define AMANZI_GENERAL_EOS_IDEAL_GAS_MODEL_HH_
+
+#include <cmath>
+#include "Teuchos_ParameterList.hpp"
+#include "dbc.hh"
+
+namespace Amanzi {
+namespace General {
+namespace Relations {
+
+class EosIdealGasModel {
+
+ public:
+  explicit
+  EosIdealGasModel(Teuchos::ParameterList& plist);
+
+  double Density(double temp, double pres) const;
+
+  double DDensityDTemperature(double temp, double pres) const;
+  double DDensityDPressure(double temp, double pres) const;
+
+  // kernels over n entries
+  void DensityKernel(int n, const double* __restrict__ temp_v, const double* __restrict__ pres_v, double* __restrict__ result) const;
+  void DensityAndDerivativesKernel(int n, const double* __restrict__ temp_v, const double* __restrict__ pres_v, double* __restrict__ result, double* __restrict__ dresult_dtemp, double* __restrict__ dresult_dpres) const;
+  void DDensityDTemperatureKernel(int n, const double* __restrict__ temp_v, const double* __restrict__ pres_v, double* __restrict__ result) const;
+  void DDensityDPressureKernel(int n, const double* __restrict__ temp_v, const double* __restrict__ pres_v, double* __restrict__ result) const;
+  
+ protected:
+  void InitializeFromPlist_(Teuchos::ParameterList& plist);
+
+ protected:
+
+  double cv_;
+  double T0_;
+
+};
+
+
+// main method
+inline double
+EosIdealGasModel::Density(double temp, double pres) const
+{
+  return cv_*(-T0_ + temp);
+}
+
+inline double
+EosIdealGasModel::DDensityDTemperature(double temp, double pres) const
+{
+  return cv_;
+}
+
+inline double
+EosIdealGasModel::DDensityDPressure(double temp, double pres) const
+{
+  return 0;
+}
+
+inline void
+EosIdealGasModel::DensityKernel(int n, const double* __restrict__ temp_v, const double* __restrict__ pres_v, double* __restrict__ result) const
+{
+#pragma omp simd
+  for (int i=0; i<n; ++i) {
+    result[i] = Density(temp_v[i], pres_v[i]);
+  }
+}
+
+inline void
+EosIdealGasModel::DensityAndDerivativesKernel(int n, const double* __restrict__ temp_v, const double* __restrict__ pres_v, double* __restrict__ result, double* __restrict__ dresult_dtemp, double* __restrict__ dresult_dpres) const
+{
+#pragma omp simd
+  for (int i=0; i<n; ++i) {
+    const double temp = temp_v[i];
+    result[i] = cv_*(-T0_ + temp);
+    dresult_dtemp[i] = cv_;
+    dresult_dpres[i] = 0;
+  }
+}
+
+inline void
+EosIdealGasModel::DDensityDTemperatureKernel(int n, const double* __restrict__ temp_v, const double* __restrict__ pres_v, double* __restrict__ result) const
+{
+#pragma omp simd
+  for (int i=0; i<n; ++i) {
+    result[i] = DDensityDTemperature(temp_v[i], pres_v[i]);
+  }
+}
+
+inline void
+EosIdealGasModel::DDensityDPressureKernel(int n, const double* __restrict__ temp_v, const double* __restrict__ pres_v, double* __restrict__ result) const
+{
+#pragma omp simd
+  for (int i=0; i<n; ++i) {
+    result[i] = DDensityDPressure(temp_v[i], pres_v[i]);
+  }
+}
+
+} //namespace
+} //namespace
+} //namespace
+
+#endif
\ No newline at end of file
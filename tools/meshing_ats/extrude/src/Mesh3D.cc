@@ -20,27 +20,44 @@ Mesh3D::Mesh3D(const Mesh2D * const m_, int n_layers) :
   Point d(3);
   int n_nodes = m->nnodes*(n_layers+1);
   coords.reserve(n_nodes);
-  
+
+  int n_top_nodes = 0;
+  for (auto& c : m->cell2node) n_top_nodes += c.size();
+  int n_side_faces = 0;
+  for (auto& c : m->cell2face) n_side_faces += c.size();
+
   int n_cells = n_layers * m->ncells;
-  cell2face.reserve(n_cells);
+  cell2face_offsets.reserve(n_cells+1);
+  cell2face.reserve(n_layers * (2*m->ncells + n_side_faces));
 
   int n_faces = n_layers * m->nfaces
       + (n_layers+1)*m->ncells;
-  face2node.reserve(n_faces);
+  face2node_offsets.reserve(n_faces+1);
+  face2node.reserve((n_layers+1)*n_top_nodes + 4*n_layers*m->nfaces);
 
   // copy the top surface coords
   coords.insert(coords.end(), m->coords.begin(), m->coords.end());
 
   // create the top layer of faces
-  face2node.insert(face2node.end(), m->cell2node.begin(),
-                   m->cell2node.end());
-  up_faces.resize(face2node.size());
+  cell2face_offsets.push_back(0);
+  face2node_offsets.push_back(0);
+  for (auto& c : m->cell2node) {
+    face2node.insert(face2node.end(), c.begin(), c.end());
+    face2node_offsets.push_back(face2node.size());
+  }
+  up_faces.resize(m->ncells);
   std::iota(up_faces.begin(), up_faces.end(), 0);
   up_nodes.resize(coords.size());
   std::iota(up_nodes.begin(), up_nodes.end(), 0);
   dn_nodes = up_nodes;
   dn_faces = up_faces;
 
+  // the lowest cell containing each 2D face creates its side faces, as in
+  // a serial sweep over cells
+  face_first_cell.resize(m->nfaces, m->ncells);
+  for (int c=m->ncells-1; c>=0; --c)
+    for (auto sf : m->cell2face[c]) face_first_cell[sf] = c;
+
   // create the "bottom" sideset
   side_sets.emplace_back(std::piecewise_construct,
                          std::forward_as_tuple(m->ncells, -1),
@@ -59,87 +76,167 @@ Mesh3D::Mesh3D(const Mesh2D * const m_, int n_layers) :
 }
 
 
+//
+// Extrudes one layer.
+//
+// Entities are numbered exactly as a serial sweep over the 2D cells would:
+// each active cell adds its bottom face, then the side faces it is first to
+// touch, then itself.  Per-cell counts are scanned into offsets so that the
+// connectivity of the layer is filled in parallel, directly into the flat
+// arrays.
+//
 void
 Mesh3D::extrude(const std::vector<double>& dz,
                 const std::vector<int>& block_ids_) {
   ASSERT(dz.size() == m->coords.size());
   ASSERT(block_ids_.size() == m->cell2node.size());
 
-  auto this_layer_sides = std::vector<int>(m->face2node.size(), -1);
-  auto node_differs = [this](int n) {return this->dn_nodes[n] != this->up_nodes[n];};
-  auto node_same_horiz = [this](int n) {return coords[this->dn_nodes[n]][0] == coords[this->up_nodes[n]][0]
-                                        && coords[this->dn_nodes[n]][1] == coords[this->up_nodes[n]][1];};
-  
+  int nnodes = m->nnodes;
+  int ncells = m->ncells;
+
   // shift the up-node coordinates by dz
-  for (int n=0; n!=dz.size(); ++n) {
-    if (dz[n] > 0.) {
-      Point nc(coords[up_nodes[n]]);
-      nc[2] -= dz[n];
-      coords.emplace_back(std::move(nc));
-      dn_nodes[n] = coords.size()-1;
+  std::vector<char> differs(nnodes);
+  std::vector<int> new_node(nnodes+1, 0);
+  for (int n=0; n!=nnodes; ++n) {
+    differs[n] = dz[n] > 0.;
+    new_node[n+1] = new_node[n] + differs[n];
+  }
+  int coords_start = coords.size();
+  coords.resize(coords_start + new_node[nnodes], Point(3));
+
+#pragma omp parallel for
+  for (int n=0; n<nnodes; ++n) {
+    if (differs[n]) {
+      int my_n = coords_start + new_node[n];
+      coords[my_n] = coords[up_nodes[n]];
+      coords[my_n][2] -= dz[n];
+      dn_nodes[n] = my_n;
     }
   }
 
-  // add cells, faces
-  for (int c=0; c!=m->ncells; ++c) {
-    if (std::any_of(m->cell2node[c].begin(), m->cell2node[c].end(),
-                    node_differs)) {
-      cells_in_col[c]++;
-      
-      // add the bottom face
-      std::vector<int> dn_face;
-      for (auto n : m->cell2node[c]) dn_face.emplace_back(dn_nodes[n]);
-      int my_dn_f = face2node.size();
-      face2node.emplace_back(std::move(dn_face));
-      dn_faces[c] = my_dn_f;
-
-      // push back a cell containing the up, dn faces
-      auto cell_faces = std::vector<int>{up_faces[c], dn_faces[c]};
-      int my_c = cell2face.size();
-
-      // if this is the top cell, put it into the surface side set
-      if (side_sets[1].first[c] < 0) side_sets[1].first[c] = my_c;
-      // put this cell into the bottom side set -- will be overwritten if any lower
-      side_sets[0].first[c] = my_c;
-
-      // add faces for the sides as needed
-      for (auto sf : m->cell2face[c]) {
-        int my_f = this_layer_sides[sf];
-
-        ASSERT(node_same_horiz(m->face2node[sf][0]));
-        ASSERT(node_same_horiz(m->face2node[sf][1]));
-        
-        if (std::any_of(m->face2node[sf].begin(), m->face2node[sf].end(),
-                        node_differs)) {
-          if (my_f < 0) {
-            // may need to create the face
-            my_f = face2node.size();
-            auto side_nodes = std::vector<int>{ up_nodes[m->face2node[sf][1]], 
-                                                up_nodes[m->face2node[sf][0]] };
-            if (node_differs(m->face2node[sf][0])) side_nodes.push_back(dn_nodes[m->face2node[sf][0]]);
-            if (node_differs(m->face2node[sf][1])) side_nodes.push_back(dn_nodes[m->face2node[sf][1]]);
-            face2node.emplace_back(std::move(side_nodes));
-            cell_faces.push_back(my_f);
-            this_layer_sides[sf] = my_f;
-
-            // check if this is a boundary side, and add it to the side_set if so
-            if (m->side_face_counts[sf] == 1) {
-              side_sets[2].first.push_back(my_c);
-              side_sets[2].second.push_back(cell_faces.size() - 1);
-            }
-            
-          } else {
-            // no need to create the face, but the cell still needs to know it
-            cell_faces.push_back(my_f);
-          }
+  // count, per 2D cell, what it adds
+  std::vector<int> cell_new(ncells+1, 0);
+  std::vector<int> face_new(ncells+1, 0);
+  std::vector<int> face2node_new(ncells+1, 0);
+  std::vector<int> cell2face_new(ncells+1, 0);
+  std::vector<int> boundary_new(ncells+1, 0);
+  int horiz_error = 0;
+
+#pragma omp parallel for reduction(+:horiz_error)
+  for (int c=0; c<ncells; ++c) {
+    const std::vector<int>& nodes = m->cell2node[c];
+    if (std::none_of(nodes.begin(), nodes.end(),
+                     [&differs](int n) { return differs[n]; })) continue;
 
+    cell_new[c+1] = 1;
+    face_new[c+1] = 1;
+    face2node_new[c+1] = nodes.size();
+    cell2face_new[c+1] = 2;
+    for (auto sf : m->cell2face[c]) {
+      int n0 = m->face2node[sf][0];
+      int n1 = m->face2node[sf][1];
+      if (coords[dn_nodes[n0]][0] != coords[up_nodes[n0]][0]
+          || coords[dn_nodes[n0]][1] != coords[up_nodes[n0]][1]
+          || coords[dn_nodes[n1]][0] != coords[up_nodes[n1]][0]
+          || coords[dn_nodes[n1]][1] != coords[up_nodes[n1]][1])
+        horiz_error++;
+
+      if (differs[n0] || differs[n1]) {
+        cell2face_new[c+1]++;
+        if (face_first_cell[sf] == c) {
+          face_new[c+1]++;
+          face2node_new[c+1] += 2 + differs[n0] + differs[n1];
+          if (m->side_face_counts[sf] == 1) boundary_new[c+1]++;
         }
       }
+    }
+  }
+  ASSERT(horiz_error == 0);
+
+  for (int c=0; c!=ncells; ++c) {
+    cell_new[c+1] += cell_new[c];
+    face_new[c+1] += face_new[c];
+    face2node_new[c+1] += face2node_new[c];
+    cell2face_new[c+1] += cell2face_new[c];
+    boundary_new[c+1] += boundary_new[c];
+  }
 
-      // finally add the cell, including a block id
-      cell2face.emplace_back(std::move(cell_faces));
-      block_ids.push_back(block_ids_[c]);
+  int cells_start = num_cells();
+  int faces_start = num_faces();
+  int face2node_start = face2node.size();
+  int cell2face_start = cell2face.size();
+  int boundary_start = side_sets[2].first.size();
+
+  cell2face_offsets.resize(cells_start + cell_new[ncells] + 1);
+  cell2face.resize(cell2face_start + cell2face_new[ncells]);
+  face2node_offsets.resize(faces_start + face_new[ncells] + 1);
+  face2node.resize(face2node_start + face2node_new[ncells]);
+  side_sets[2].first.resize(boundary_start + boundary_new[ncells]);
+  side_sets[2].second.resize(boundary_start + boundary_new[ncells]);
+  block_ids.resize(cells_start + cell_new[ncells]);
+
+  // create the faces
+  std::vector<int> side_faces(m->nfaces, -1);
+#pragma omp parallel for
+  for (int c=0; c<ncells; ++c) {
+    if (cell_new[c+1] == cell_new[c]) continue;
+
+    // add the bottom face
+    int my_f = faces_start + face_new[c];
+    int my_fn = face2node_start + face2node_new[c];
+    for (auto n : m->cell2node[c]) face2node[my_fn++] = dn_nodes[n];
+    face2node_offsets[++my_f] = my_fn;
+
+    // add faces for the sides as needed
+    for (auto sf : m->cell2face[c]) {
+      if (face_first_cell[sf] != c) continue;
+      int n0 = m->face2node[sf][0];
+      int n1 = m->face2node[sf][1];
+      if (!(differs[n0] || differs[n1])) continue;
+
+      side_faces[sf] = my_f;
+      face2node[my_fn++] = up_nodes[n1];
+      face2node[my_fn++] = up_nodes[n0];
+      if (differs[n0]) face2node[my_fn++] = dn_nodes[n0];
+      if (differs[n1]) face2node[my_fn++] = dn_nodes[n1];
+      face2node_offsets[++my_f] = my_fn;
+    }
+  }
+
+  // create the cells, containing the up, dn, and side faces
+#pragma omp parallel for
+  for (int c=0; c<ncells; ++c) {
+    if (cell_new[c+1] == cell_new[c]) continue;
+
+    int my_c = cells_start + cell_new[c];
+    int my_cf = cell2face_start + cell2face_new[c];
+    int my_b = boundary_start + boundary_new[c];
+    int my_dn_f = faces_start + face_new[c];
+
+    cell2face[my_cf++] = up_faces[c];
+    cell2face[my_cf++] = my_dn_f;
+    for (auto sf : m->cell2face[c]) {
+      int my_f = side_faces[sf];
+      if (my_f < 0) continue;
+      cell2face[my_cf++] = my_f;
+
+      // check if this is a boundary side, and add it to the side_set if so
+      if (m->side_face_counts[sf] == 1) {
+        side_sets[2].first[my_b] = my_c;
+        side_sets[2].second[my_b] = my_cf - 1 - (cell2face_start + cell2face_new[c]);
+        my_b++;
+      }
     }
+    cell2face_offsets[my_c+1] = my_cf;
+    block_ids[my_c] = block_ids_[c];
+
+    dn_faces[c] = my_dn_f;
+    cells_in_col[c]++;
+
+    // if this is the top cell, put it into the surface side set
+    if (side_sets[1].first[c] < 0) side_sets[1].first[c] = my_c;
+    // put this cell into the bottom side set -- will be overwritten if any lower
+    side_sets[0].first[c] = my_c;
   }
 
   // increment the layer metadata
@@ -147,8 +244,8 @@ Mesh3D::extrude(const std::vector<double>& dz,
   up_nodes = dn_nodes;
   up_faces = dn_faces;
 
-  ASSERT(block_ids.size() == cell2face.size());
-  std::cout << "POST-Extruding: currently " << cell2face.size() << " cells and " << face2node.size() << " faces." << std::endl;
+  ASSERT(block_ids.size() == num_cells());
+  std::cout << "POST-Extruding: currently " << num_cells() << " cells and " << num_faces() << " faces." << std::endl;
 
 }
 
@@ -156,7 +253,8 @@ void
 Mesh3D::finish() {
   // flip the bottom faces for proper outward orientation
   for (auto f : dn_faces)
-    std::reverse(face2node[f].begin(), face2node[f].end());
+    std::reverse(face2node.begin() + face2node_offsets[f],
+                 face2node.begin() + face2node_offsets[f+1]);
 
   // move the 2d cell sets to face sets on the surface
   std::set<int> set_ids;
@@ -180,17 +278,16 @@ Mesh3D::finish() {
   }
 
   // check side sets
-  std::vector<int> side_face_counts(face2node.size(), 0);
-  for (auto& c : cell2face)
-    for (auto& f : c)
-      side_face_counts[f]++;
+  std::vector<int> side_face_counts(num_faces(), 0);
+  for (auto f : cell2face)
+    side_face_counts[f]++;
   
   for (int lcv_s=0; lcv_s!=side_sets.size(); ++lcv_s) {
     auto& fs = side_sets[lcv_s]; 
     for (int i=0; i!=side_sets[lcv_s].first.size(); ++i) {
       int c = fs.first[i];
       int fi = fs.second[i];
-      int f = cell2face[c][fi];
+      int f = cell2face[cell2face_offsets[c] + fi];
       if (side_face_counts[f] != 1) {
         std::cout << "Face Set " << side_sets_id[lcv_s] << ": face = " << f << " (" << c << "," << fi << ") has been counted " << side_face_counts[f] << " times (should be 1)!" << std::endl;
       }
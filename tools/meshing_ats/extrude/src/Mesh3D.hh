@@ -40,10 +40,20 @@ struct Mesh3D {
 
   const Mesh2D * const m;
 
+  int num_cells() const { return cell2face_offsets.size() - 1; }
+  int num_faces() const { return face2node_offsets.size() - 1; }
+
   // basic geometric/topology info
+  //
+  // Connectivity is stored flat, in CSR form: the faces of cell c are
+  // cell2face[cell2face_offsets[c]] up to cell2face[cell2face_offsets[c+1]],
+  // and likewise for the nodes of a face.  A vector per entity costs more in
+  // overhead than its contents for these small lists.
   std::vector<Point> coords;
-  std::vector<std::vector<int> > cell2face;
-  std::vector<std::vector<int> > face2node;
+  std::vector<int> cell2face_offsets;
+  std::vector<int> cell2face;
+  std::vector<int> face2node_offsets;
+  std::vector<int> face2node;
 
   // labels
   std::vector<int> block_ids;
@@ -57,6 +67,7 @@ struct Mesh3D {
   std::vector<int> up_nodes;
   std::vector<int> dn_nodes;
   std::vector<int> cells_in_col;
+  std::vector<int> face_first_cell; // lowest 2D cell containing each 2D face
 
   // other meta-data
   int current_layer;
@@ -22,35 +22,32 @@ writeMesh3D_exodus(const Mesh3D& m, const std::string& filename) {
     return;
   }
   
-  // make the blocks by set
+  // make the blocks by set -- only the cell maps and sizes are kept, the
+  // connectivity of a block is assembled as it is written
   std::set<int> set_ids(m.block_ids.begin(), m.block_ids.end());
-  std::vector<std::vector<int> > blocks;
   std::vector<int> blocks_ncells;
+  std::vector<int> blocks_nfaces;
   std::vector<int> blocks_id;
-  std::vector<std::vector<int> > block_face_counts;
 
   int new_id = 0;
-  std::vector<int> cell_map(m.cell2face.size(), -1);
+  std::vector<int> cell_map(m.num_cells(), -1);
   for (auto sid : set_ids) {
-    std::vector<int> block;
-    std::vector<int> face_counts;
     // count things
     int ncells = 0;
+    int nfaces = 0;
 
-    for (int i=0; i!=m.cell2face.size(); ++i) {
+    for (int i=0; i!=m.num_cells(); ++i) {
       if (m.block_ids[i] == sid) {
         ncells++;
-        block.insert(block.end(), m.cell2face[i].begin(), m.cell2face[i].end());
-        face_counts.push_back(m.cell2face[i].size());
+        nfaces += m.cell2face_offsets[i+1] - m.cell2face_offsets[i];
         cell_map[i] = new_id;
         new_id++;
       }
     }
 
-    blocks.emplace_back(block);
     blocks_ncells.push_back(ncells);
+    blocks_nfaces.push_back(nfaces);
     blocks_id.push_back(sid);
-    block_face_counts.emplace_back(face_counts);
   }
 
 
@@ -61,9 +58,9 @@ writeMesh3D_exodus(const Mesh3D& m, const std::string& filename) {
   params.num_nodes = m.coords.size();
   params.num_edge = 0;
   params.num_edge_blk = 0;
-  params.num_face = m.face2node.size();
+  params.num_face = m.num_faces();
   params.num_face_blk = 1;
-  params.num_elem = m.cell2face.size();
+  params.num_elem = m.num_cells();
   params.num_elem_blk = set_ids.size();
   params.num_node_maps = 0;
   params.num_edge_maps = 0;
@@ -106,37 +103,48 @@ writeMesh3D_exodus(const Mesh3D& m, const std::string& filename) {
 
   
   // put in the face block
-  std::vector<int> facenodes;
-  std::vector<int> facenodes_counts;
-  for (auto& nodes : m.face2node) {
-    facenodes_counts.push_back(nodes.size());
-    facenodes.insert(facenodes.end(), nodes.begin(), nodes.end());
-  }
+  std::vector<int> facenodes_counts(m.num_faces());
+  for (int f=0; f!=m.num_faces(); ++f)
+    facenodes_counts[f] = m.face2node_offsets[f+1] - m.face2node_offsets[f];
   ierr |= ex_put_block(fid, EX_FACE_BLOCK, 1, "NSIDED",
-                       m.face2node.size(), facenodes.size(), 0,0,0);
+                       m.num_faces(), m.face2node.size(), 0,0,0);
   ASSERT(!ierr);
 
   ierr |= ex_put_entity_count_per_polyhedra(fid, EX_FACE_BLOCK, 1,
           &facenodes_counts[0]);
   ASSERT(!ierr);
 
-  for (auto& e : facenodes) e++;
-  ierr |= ex_put_conn(fid, EX_FACE_BLOCK, 1, &facenodes[0], NULL, NULL);
-  ASSERT(!ierr);
+  {
+    std::vector<int> facenodes(m.face2node);
+    for (auto& e : facenodes) e++;
+    ierr |= ex_put_conn(fid, EX_FACE_BLOCK, 1, &facenodes[0], NULL, NULL);
+    ASSERT(!ierr);
+  }
   
 
-  // put in the element blocks
-  for (int lcvb=0; lcvb!=blocks.size(); ++lcvb) {
+  // put in the element blocks, one at a time
+  for (int lcvb=0; lcvb!=blocks_id.size(); ++lcvb) {
+    std::vector<int> block;
+    std::vector<int> face_counts;
+    block.reserve(blocks_nfaces[lcvb]);
+    face_counts.reserve(blocks_ncells[lcvb]);
+    for (int i=0; i!=m.num_cells(); ++i) {
+      if (m.block_ids[i] == blocks_id[lcvb]) {
+        for (int j=m.cell2face_offsets[i]; j!=m.cell2face_offsets[i+1]; ++j)
+          block.push_back(m.cell2face[j] + 1);
+        face_counts.push_back(m.cell2face_offsets[i+1] - m.cell2face_offsets[i]);
+      }
+    }
+
     ierr |= ex_put_block(fid, EX_ELEM_BLOCK, blocks_id[lcvb], "NFACED",
-                         blocks_ncells[lcvb], 0, 0, blocks[lcvb].size(),0);
+                         blocks_ncells[lcvb], 0, 0, blocks_nfaces[lcvb],0);
     ASSERT(!ierr);
 
     ierr |= ex_put_entity_count_per_polyhedra(fid, EX_ELEM_BLOCK, blocks_id[lcvb],
-            &block_face_counts[lcvb][0]);
+            &face_counts[0]);
     ASSERT(!ierr);
 
-    for (auto&e : blocks[lcvb]) e++;
-    ierr |= ex_put_conn(fid, EX_ELEM_BLOCK, blocks_id[lcvb], NULL, NULL, &blocks[lcvb][0]);
+    ierr |= ex_put_conn(fid, EX_ELEM_BLOCK, blocks_id[lcvb], NULL, NULL, &block[0]);
     ASSERT(!ierr);
   }
 
@@ -162,8 +170,8 @@ writeMesh3D_exodus(const Mesh3D& m, const std::string& filename) {
 
   // debugging/nice output
   std::cout << "Wrote 3D Mesh:" << std::endl
-            << "  ncells = " << m.cell2face.size() << std::endl
-            << "  nfaces = " << m.face2node.size() << std::endl
+            << "  ncells = " << m.num_cells() << std::endl
+            << "  nfaces = " << m.num_faces() << std::endl
             << "  nnodes = " << m.coords.size() << std::endl
             << std::endl
             << "  side sets = " << std::endl;
@@ -58,6 +58,39 @@ def column_data(varnames, keys='all', directory=".", filename="visdump_data.h5",
     # sort in z coordinate
     return vals[:,:,vals[0,0,:].argsort()]
 
+def columns_data(varnames, keys='all', directory=".", filename="visdump_columns.h5"):
+    """Reads aggregated column ensemble vis, as written by ColumnVisualization.
+
+    Returns (ids, z, vals): the global column ids, shape (n_columns,), the cell
+    elevations, shape (n_columns, n_cells), and the data, of shape
+    ( len(varnames), len(keys), n_columns, n_cells ).  For a parallel run,
+    give each rank's file, e.g. visdump_columns_0.h5.
+    """
+    if type(varnames) is str:
+        varnames = [varnames,]
+
+    with h5py.File(os.path.join(directory,filename),'r') as dat:
+        ids = dat['column ids'][:]
+        z = dat['z'][:]
+
+        keys_avail = sorted(dat[fullname(varnames[0])].keys(), key=int)
+        if keys == 'all':
+            keys = keys_avail
+        elif keys == '-1' or keys == -1:
+            keys = [keys_avail[-1]]
+        elif type(keys) is str:
+            keys = [keys]
+        elif type(keys) is int:
+            keys = [str(keys)]
+        elif type(keys) is slice:
+            keys = keys_avail[keys]
+
+        vals = np.zeros((len(varnames), len(keys)) + z.shape, 'd')
+        for i,key in enumerate(keys):
+            for j,varname in enumerate(varnames):
+                vals[j,i,:,:] = dat[fullname(varname)][key][:,:]
+    return ids, z, vals
+
 def getFigs(inset, is_temp, figsize=(12,3)):
     from matplotlib import pyplot as plt
     fig = plt.figure(figsize=figsize)